@@ -133,3 +133,20 @@ FetchContent_Declare(
 )
 
 FetchContent_MakeAvailable(spdlog)
+
+# ============================================================================
+# lz4
+# ============================================================================
+set(LZ4_BUILD_CLI OFF CACHE BOOL "" FORCE)
+set(LZ4_BUILD_LEGACY_LZ4C OFF CACHE BOOL "" FORCE)
+set(BUILD_STATIC_LIBS ON CACHE BOOL "" FORCE)
+
+FetchContent_Declare(
+        lz4
+        GIT_REPOSITORY https://github.com/lz4/lz4.git
+        GIT_TAG release
+        GIT_SHALLOW TRUE
+        SOURCE_SUBDIR build/cmake
+)
+
+FetchContent_MakeAvailable(lz4)
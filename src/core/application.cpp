@@ -8,7 +8,12 @@
 #include "core/application.h"
 #include "core/logger.h"
 #include "core/input.h"
+#include "core/file_system.h"
+#include "core/frame_allocator.h"
+#include "core/job_system.h"
+#include "core/profiler.h"
 #include "renderer/renderer.h"
+#include "renderer/model_cache.h"
 #include <GLFW/glfw3.h>
 
 namespace RealmFortress
@@ -20,54 +25,102 @@ namespace RealmFortress
         RF_CORE_ASSERT(!sInstance, "application already exists!");
         sInstance = this;
 
+        Profiler::SetThreadName("Main Thread");
+
         mWindow = CreateScope<Window>(WindowProps(specification.mName));
-        mWindow->SetEventCallback(RF_BIND_EVENT_FN(Application::OnEvent));
+        mWindow->SetEventCallback([this](Event& event) { mEventQueue.Push(event); });
+        mEventHandlers.Register<WindowCloseEvent, &Application::OnWindowClose>(this);
+        mEventHandlers.Register<WindowResizeEvent, &Application::OnWindowResize>(this);
 
+        JobSystem::Init();
+        FrameAllocator::Init();
+        FileSystem::Mount(ARCHIVE_DEFAULT_PATH);
         Renderer::Init();
 
         mImGuiLayer = new ImGuiLayer();
         PushOverlay(mImGuiLayer);
+
+        // --trace <frames> captures the first frames from startup, loading hitches included
+        const auto& args = specification.mCommandLineArgs;
+        for (int i = 1; i + 1 < args.mCount; i++)
+        {
+            if (std::string_view(args[i]) == "--trace")
+                Profiler::BeginCapture(static_cast<u32>(std::max(std::atoi(args[i + 1]), 1)));
+        }
     }
 
     Application::~Application()
     {
+        // queued jobs may still read the archive or touch GL
+        JobSystem::Shutdown();
         Renderer::Shutdown();
+        FileSystem::Unmount();
+        FrameAllocator::Shutdown();
     }
 
     void Application::Run()
     {
         while (mRunning)
         {
+            Profiler::OnFrame();
+            RF_PROFILE_SCOPE("Frame");
+
+            {
+                RF_PROFILE_SCOPE("EventQueue::Flush");
+                // the queue knows each event's type statically, so no virtual GetEventType() per event
+                mEventQueue.Flush([this](auto& event) { Dispatch(event, std::remove_reference_t<decltype(event)>::GetStaticType()); });
+            }
+
             float time = static_cast<float>(glfwGetTime());
             Timestep timestep = time - mLastFrameTime;
             mLastFrameTime = time;
 
+            // uploads models decoded on workers and evicts before anyone resolves a handle this frame
+            {
+                RF_PROFILE_SCOPE("ModelCache::OnUpdate");
+                ModelCache::OnUpdate();
+                JobSystem::RunMainThreadJobs();
+            }
+
             if (!mMinimized)
             {
                 for (Layer* layer : mLayerStack)
+                {
+                    RF_PROFILE_SCOPE("Layer::OnUpdate");
                     layer->OnUpdate(timestep);
+                }
 
+                RF_PROFILE_SCOPE("Layer::OnImGuiRender");
                 mImGuiLayer->Begin();
                 for (Layer* layer : mLayerStack)
                     layer->OnImGuiRender();
                 mImGuiLayer->End();
             }
+            else
+            {
+                for (Layer* layer : mLayerStack)
+                    layer->OnSuspended(timestep);
+            }
 
+            RF_PROFILE_SCOPE("Window::OnUpdate");
             mWindow->OnUpdate();
         }
     }
 
     void Application::OnEvent(Event& event)
     {
-        EventDispatcher dispatcher(event);
-        dispatcher.Dispatch<WindowCloseEvent>(RF_BIND_EVENT_FN(Application::OnWindowClose));
-        dispatcher.Dispatch<WindowResizeEvent>(RF_BIND_EVENT_FN(Application::OnWindowResize));
+        Dispatch(event, event.GetEventType());
+    }
+
+    void Application::Dispatch(Event& event, EventType type)
+    {
+        mEventHandlers.Dispatch(event, type);
 
         for (auto it = mLayerStack.rbegin(); it != mLayerStack.rend(); ++it)
         {
             if (event.mHandled)
                 break;
-            (*it)->OnEvent(event);
+            (*it)->GetEventHandlers().Dispatch(event, type);
         }
     }
 
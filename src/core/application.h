@@ -13,6 +13,7 @@
 #include "core/logger.h"
 #include "events/event.h"
 #include "events/application_event.h"
+#include "events/event_queue.h"
 #include "imgui/imgui_layer.h"
 
 namespace RealmFortress
@@ -61,6 +62,8 @@ namespace RealmFortress
         static Application& Get() { return *sInstance; }
 
     private:
+        void Dispatch(Event& event, EventType type);
+
         bool OnWindowClose(WindowCloseEvent& event);
         bool OnWindowResize(WindowResizeEvent& event);
 
@@ -69,10 +72,14 @@ namespace RealmFortress
         bool mRunning{ true };
         bool mMinimized{ false };
         LayerStack mLayerStack;
+        EventHandlerTable mEventHandlers;
         f32 mLastFrameTime{ 0.0f };
 
         ImGuiLayer* mImGuiLayer;
 
+        // filled by the window callbacks during polling, dispatched at the top of the next frame
+        EventQueue mEventQueue;
+
     private:
         static Application* sInstance;
     };
@@ -0,0 +1,54 @@
+/**
+ * @file archive_format.h
+ * @brief On-disk layout of the packed asset archive shared by the runtime and the packer.
+ * @date 12/20/2025
+ */
+
+#pragma once
+
+#include "core/base.h"
+
+namespace RealmFortress
+{
+    /**
+     * Archive layout:
+     *   ArchiveHeader
+     *   ArchiveEntry[EntryCount]   sorted by path (byte-wise), so lookups are a binary search
+     *   path string table          entry paths, not null-terminated
+     *   entry data                 each entry starts on an Alignment boundary
+     */
+    constexpr u32 ARCHIVE_MAGIC = 0x4B504652; // "RFPK"
+    constexpr u32 ARCHIVE_VERSION = 1;
+    constexpr u32 ARCHIVE_DEFAULT_ALIGNMENT = 16;
+    constexpr const char* ARCHIVE_DEFAULT_PATH = "assets.rfpak";
+
+    enum ArchiveEntryFlags : u32
+    {
+        ArchiveEntryFlags_None = 0,
+        ArchiveEntryFlags_LZ4  = BIT(0)
+    };
+
+    struct ArchiveHeader
+    {
+        u32 Magic = ARCHIVE_MAGIC;
+        u32 Version = ARCHIVE_VERSION;
+        u32 EntryCount = 0;
+        u32 Alignment = ARCHIVE_DEFAULT_ALIGNMENT;
+        u64 StringTableOffset = 0;
+        u64 StringTableSize = 0;
+    };
+
+    struct ArchiveEntry
+    {
+        u32 PathOffset = 0;     // relative to StringTableOffset
+        u32 PathLength = 0;
+        u64 Offset = 0;         // from the start of the archive
+        u64 StoredSize = 0;     // bytes in the archive
+        u64 Size = 0;           // bytes once decompressed
+        u32 Flags = ArchiveEntryFlags_None;
+        u32 Reserved = 0;
+    };
+
+    static_assert(sizeof(ArchiveHeader) == 32);
+    static_assert(sizeof(ArchiveEntry) == 40);
+} // namespace RealmFortress
@@ -22,5 +22,7 @@ int main(int argc, char** argv)
 
     delete app;
 
+    RealmFortress::Logger::Shutdown();
+
     return 0;
 }
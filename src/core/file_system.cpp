@@ -0,0 +1,318 @@
+/**
+ * @file file_system.cpp
+ * @brief
+ * @date 12/20/2025
+ */
+
+#include "core/pch.h"
+#include "core/file_system.h"
+#include "core/logger.h"
+#include <lz4.h>
+#include <fstream>
+#include <limits>
+
+#ifdef RF_PLATFORM_WINDOWS
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace RealmFortress
+{
+    FileSystem::MappedArchive FileSystem::sArchive;
+
+    FileData::FileData(const u8* data, usize size)
+        : mData(data), mSize(size)
+    {
+    }
+
+    FileData::FileData(std::vector<u8>&& storage)
+        : mStorage(std::move(storage))
+    {
+        // an empty vector may hand back null, which would read as a failed load; empty files
+        // point at a static byte instead so they stay valid
+        static constexpr u8 EmptyData = 0;
+        mData = mStorage.empty() ? &EmptyData : mStorage.data();
+        mSize = mStorage.size();
+    }
+
+    FileData::FileData(FileData&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    FileData& FileData::operator=(FileData&& other) noexcept
+    {
+        if (this != &other)
+        {
+            // moving a vector keeps its buffer, so mData stays valid for owned storage
+            mStorage = std::move(other.mStorage);
+            mData = other.mData;
+            mSize = other.mSize;
+            other.mData = nullptr;
+            other.mSize = 0;
+        }
+        return *this;
+    }
+
+    bool FileSystem::Mount(const std::string& archive_path)
+    {
+        Unmount();
+
+#ifdef RF_PLATFORM_WINDOWS
+        HANDLE file = CreateFileA(archive_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            RF_CORE_INFO("No asset archive at {}, reading loose files", archive_path);
+            return false;
+        }
+
+        LARGE_INTEGER file_size;
+        GetFileSizeEx(file, &file_size);
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        const void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!data)
+        {
+            RF_CORE_ERROR("Failed to map asset archive: {}", archive_path);
+            if (mapping) CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        sArchive.FileHandle = file;
+        sArchive.MappingHandle = mapping;
+        sArchive.Size = static_cast<usize>(file_size.QuadPart);
+#else
+        i32 fd = open(archive_path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            RF_CORE_INFO("No asset archive at {}, reading loose files", archive_path);
+            return false;
+        }
+
+        struct stat file_stat;
+        fstat(fd, &file_stat);
+
+        void* data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            RF_CORE_ERROR("Failed to map asset archive: {}", archive_path);
+            close(fd);
+            return false;
+        }
+
+        sArchive.FileDescriptor = fd;
+        sArchive.Size = static_cast<usize>(file_stat.st_size);
+#endif
+
+        sArchive.Data = static_cast<const u8*>(data);
+
+        // a truncated or corrupt archive would otherwise be read past the mapping on first lookup
+        if (!ValidateArchive(archive_path))
+        {
+            RF_CORE_WARN("Ignoring asset archive {}, reading loose files", archive_path);
+            Unmount();
+            return false;
+        }
+
+        const auto* header = reinterpret_cast<const ArchiveHeader*>(sArchive.Data);
+        sArchive.Header = header;
+        sArchive.Entries = reinterpret_cast<const ArchiveEntry*>(sArchive.Data + sizeof(ArchiveHeader));
+        sArchive.Strings = reinterpret_cast<const char*>(sArchive.Data + header->StringTableOffset);
+
+        RF_CORE_INFO("Mounted asset archive {} ({} entries, {:.1f} MB)", archive_path, header->EntryCount, sArchive.Size / (1024.0 * 1024.0));
+        return true;
+    }
+
+    void FileSystem::Unmount()
+    {
+        if (!sArchive.Data)
+            return;
+
+#ifdef RF_PLATFORM_WINDOWS
+        UnmapViewOfFile(sArchive.Data);
+        CloseHandle(sArchive.MappingHandle);
+        CloseHandle(sArchive.FileHandle);
+#else
+        munmap(const_cast<u8*>(sArchive.Data), sArchive.Size);
+        close(sArchive.FileDescriptor);
+#endif
+
+        sArchive = MappedArchive();
+    }
+
+    bool FileSystem::IsMounted()
+    {
+        return sArchive.Header != nullptr;
+    }
+
+    bool FileSystem::Exists(const std::string& path)
+    {
+        std::string normalized = NormalizePath(path);
+        if (FindEntry(normalized))
+            return true;
+
+        return std::filesystem::exists(normalized);
+    }
+
+    FileData FileSystem::Read(const std::string& path)
+    {
+        std::string normalized = NormalizePath(path);
+        if (const ArchiveEntry* entry = FindEntry(normalized))
+            return ReadEntry(*entry, normalized);
+
+        return ReadLoose(normalized);
+    }
+
+    std::string FileSystem::ReadText(const std::string& path)
+    {
+        FileData data = Read(path);
+        return data ? std::string(data.AsString()) : std::string();
+    }
+
+    std::string FileSystem::NormalizePath(std::string_view path)
+    {
+        std::vector<std::string_view> parts;
+        std::string unified(path);
+        std::replace(unified.begin(), unified.end(), '\\', '/');
+
+        std::string_view view = unified;
+        usize start = 0;
+        while (start <= view.size())
+        {
+            usize end = view.find('/', start);
+            if (end == std::string_view::npos)
+                end = view.size();
+
+            std::string_view part = view.substr(start, end - start);
+            if (part == "..")
+            {
+                if (!parts.empty() && parts.back() != "..")
+                    parts.pop_back();
+                else
+                    parts.push_back(part);
+            }
+            else if (!part.empty() && part != ".")
+            {
+                parts.push_back(part);
+            }
+
+            start = end + 1;
+        }
+
+        std::string result;
+        result.reserve(unified.size());
+        if (!unified.empty() && unified.front() == '/')
+            result += '/';
+        for (usize i = 0; i < parts.size(); i++)
+        {
+            if (i > 0) result += '/';
+            result += parts[i];
+        }
+        return result;
+    }
+
+    bool FileSystem::ValidateArchive(const std::string& archive_path)
+    {
+        const usize size = sArchive.Size;
+        // offset and length both come from the file, so compare without adding them
+        auto in_range = [size](u64 offset, u64 length) {
+            return offset <= size && length <= size - offset;
+        };
+
+        const auto* header = reinterpret_cast<const ArchiveHeader*>(sArchive.Data);
+        if (size < sizeof(ArchiveHeader) || header->Magic != ARCHIVE_MAGIC || header->Version != ARCHIVE_VERSION)
+        {
+            RF_CORE_ERROR("Invalid asset archive: {}", archive_path);
+            return false;
+        }
+
+        if (!in_range(sizeof(ArchiveHeader), static_cast<u64>(header->EntryCount) * sizeof(ArchiveEntry)))
+        {
+            RF_CORE_ERROR("Corrupt asset archive {}: entry table of {} entries runs past the end of the file", archive_path, header->EntryCount);
+            return false;
+        }
+
+        if (!in_range(header->StringTableOffset, header->StringTableSize))
+        {
+            RF_CORE_ERROR("Corrupt asset archive {}: string table runs past the end of the file", archive_path);
+            return false;
+        }
+
+        const auto* entries = reinterpret_cast<const ArchiveEntry*>(sArchive.Data + sizeof(ArchiveHeader));
+        for (u32 i = 0; i < header->EntryCount; i++)
+        {
+            const ArchiveEntry& entry = entries[i];
+
+            bool path_valid = static_cast<u64>(entry.PathOffset) + entry.PathLength <= header->StringTableSize;
+            bool data_valid = in_range(entry.Offset, entry.StoredSize);
+            bool size_valid = (entry.Flags & ArchiveEntryFlags_LZ4)
+                ? entry.StoredSize <= static_cast<u64>(std::numeric_limits<i32>::max()) && entry.Size <= static_cast<u64>(std::numeric_limits<i32>::max())
+                : entry.Size == entry.StoredSize;
+
+            if (!path_valid || !data_valid || !size_valid)
+            {
+                RF_CORE_ERROR("Corrupt asset archive {}: entry {} is out of range", archive_path, i);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    const ArchiveEntry* FileSystem::FindEntry(std::string_view path)
+    {
+        if (!sArchive.Header)
+            return nullptr;
+
+        const ArchiveEntry* begin = sArchive.Entries;
+        const ArchiveEntry* end = sArchive.Entries + sArchive.Header->EntryCount;
+        auto entry_path = [](const ArchiveEntry& entry) {
+            return std::string_view(sArchive.Strings + entry.PathOffset, entry.PathLength);
+        };
+
+        const ArchiveEntry* it = std::lower_bound(begin, end, path, [&](const ArchiveEntry& entry, std::string_view value) {
+            return entry_path(entry) < value;
+        });
+
+        return it != end && entry_path(*it) == path ? it : nullptr;
+    }
+
+    FileData FileSystem::ReadEntry(const ArchiveEntry& entry, std::string_view path)
+    {
+        const u8* stored = sArchive.Data + entry.Offset;
+        if (!(entry.Flags & ArchiveEntryFlags_LZ4))
+            return FileData(stored, entry.Size);
+
+        std::vector<u8> buffer(entry.Size);
+        i32 result = LZ4_decompress_safe(reinterpret_cast<const char*>(stored), reinterpret_cast<char*>(buffer.data()),
+            static_cast<i32>(entry.StoredSize), static_cast<i32>(entry.Size));
+        if (result != static_cast<i32>(entry.Size))
+        {
+            RF_CORE_ERROR("Failed to decompress archive entry: {}", path);
+            return {};
+        }
+
+        return FileData(std::move(buffer));
+    }
+
+    FileData FileSystem::ReadLoose(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+            return {};
+
+        std::streamoff size = file.tellg();
+        if (size < 0)
+            return {};
+
+        std::vector<u8> buffer(static_cast<usize>(size));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        return FileData(std::move(buffer));
+    }
+} // namespace RealmFortress
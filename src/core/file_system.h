@@ -0,0 +1,96 @@
+/**
+ * @file file_system.h
+ * @brief
+ * @date 12/20/2025
+ */
+
+#pragma once
+
+#include "core/base.h"
+#include "core/archive_format.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace RealmFortress
+{
+    /**
+     * @class FileData
+     * @brief Contents of a file read through the FileSystem.
+     *
+     * Uncompressed archive entries point straight into the mapped archive and cost no copy;
+     * compressed entries and loose files own their bytes. Move-only so the view stays valid.
+     */
+    class FileData
+    {
+    public:
+        FileData() = default;
+        FileData(const u8* data, usize size);
+        FileData(std::vector<u8>&& storage);
+
+        FileData(const FileData&) = delete;
+        FileData& operator=(const FileData&) = delete;
+        FileData(FileData&& other) noexcept;
+        FileData& operator=(FileData&& other) noexcept;
+
+        const u8* Data() const { return mData; }
+        usize Size() const { return mSize; }
+        // true for empty files too, false only when the read failed
+        bool IsValid() const { return mData != nullptr; }
+        explicit operator bool() const { return IsValid(); }
+
+        std::string_view AsString() const { return { reinterpret_cast<const char*>(mData), mSize }; }
+
+    private:
+        const u8* mData = nullptr;
+        usize mSize = 0;
+        std::vector<u8> mStorage;
+    };
+
+    /**
+     * @class FileSystem
+     * @brief Read-only virtual file system over the packed asset archive.
+     *
+     * The archive is memory-mapped on Mount(). Lookups fall back to loose files on disk when
+     * no archive is mounted or the path is not packed, so development builds keep working
+     * straight from assets/. Reads are safe from any thread once mounted.
+     */
+    class FileSystem
+    {
+    public:
+        static bool Mount(const std::string& archive_path);
+        static void Unmount();
+        static bool IsMounted();
+
+        static bool Exists(const std::string& path);
+        static FileData Read(const std::string& path);
+        static std::string ReadText(const std::string& path);
+
+        static std::string NormalizePath(std::string_view path);
+
+    private:
+        static bool ValidateArchive(const std::string& archive_path);
+        static const ArchiveEntry* FindEntry(std::string_view path);
+        static FileData ReadEntry(const ArchiveEntry& entry, std::string_view path);
+        static FileData ReadLoose(const std::string& path);
+
+    private:
+        struct MappedArchive
+        {
+            const u8* Data = nullptr;
+            usize Size = 0;
+            const ArchiveHeader* Header = nullptr;
+            const ArchiveEntry* Entries = nullptr;
+            const char* Strings = nullptr;
+
+#ifdef RF_PLATFORM_WINDOWS
+            void* FileHandle = nullptr;
+            void* MappingHandle = nullptr;
+#else
+            i32 FileDescriptor = -1;
+#endif
+        };
+
+        static MappedArchive sArchive;
+    };
+} // namespace RealmFortress
@@ -0,0 +1,105 @@
+/**
+ * @file frame_allocator.cpp
+ * @brief
+ * @date 12/22/2025
+ */
+
+#include "core/pch.h"
+#include "core/frame_allocator.h"
+#include "core/logger.h"
+
+namespace RealmFortress
+{
+    void FrameAllocator::Init(usize capacity)
+    {
+        RF_CORE_ASSERT(!sBuffer, "FrameAllocator already initialized");
+
+        sBuffer = static_cast<std::byte*>(::operator new(capacity, std::align_val_t(BlockAlignment)));
+        sCapacity = capacity;
+        sOffset = 0;
+        sPeak = 0;
+
+        RF_CORE_INFO("FrameAllocator reserved {} KB", capacity / 1024);
+    }
+
+    void FrameAllocator::Shutdown()
+    {
+        Reset();
+
+        if (sBuffer)
+        {
+            ::operator delete(sBuffer, std::align_val_t(BlockAlignment));
+            sBuffer = nullptr;
+            sCapacity = 0;
+        }
+    }
+
+    void FrameAllocator::Reset()
+    {
+        usize used = sOffset.exchange(0, std::memory_order_relaxed);
+        sPeak = std::max(sPeak, used);
+
+        std::lock_guard lock(sOverflowMutex);
+        for (const OverflowBlock& block : sOverflowBlocks)
+        {
+            ::operator delete(block.Memory, std::align_val_t(block.Alignment));
+        }
+        sOverflowBlocks.clear();
+    }
+
+    void* FrameAllocator::Allocate(usize size, usize alignment)
+    {
+        // distinct pointers even for empty allocations
+        size = std::max<usize>(size, 1);
+
+        if (alignment > BlockAlignment)
+            return AllocateOverflow(size, alignment);
+
+        usize offset = sOffset.load(std::memory_order_relaxed);
+        while (true)
+        {
+            usize aligned = (offset + alignment - 1) & ~(alignment - 1);
+            if (aligned + size > sCapacity)
+                return AllocateOverflow(size, alignment);
+
+            if (sOffset.compare_exchange_weak(offset, aligned + size, std::memory_order_relaxed))
+                return sBuffer + aligned;
+        }
+    }
+
+    std::pmr::memory_resource* FrameAllocator::GetResource()
+    {
+        // tools and tests that never start a frame loop get the plain heap
+        return sBuffer ? static_cast<std::pmr::memory_resource*>(&sResource) : std::pmr::new_delete_resource();
+    }
+
+    usize FrameAllocator::GetCapacity()
+    {
+        return sCapacity;
+    }
+
+    usize FrameAllocator::GetUsed()
+    {
+        return std::min(sOffset.load(std::memory_order_relaxed), sCapacity);
+    }
+
+    usize FrameAllocator::GetPeak()
+    {
+        return std::max(sPeak, GetUsed());
+    }
+
+    u64 FrameAllocator::GetOverflowCount()
+    {
+        return sOverflowCount.load(std::memory_order_relaxed);
+    }
+
+    void* FrameAllocator::AllocateOverflow(usize size, usize alignment)
+    {
+        void* memory = ::operator new(size, std::align_val_t(alignment));
+        sOverflowCount.fetch_add(1, std::memory_order_relaxed);
+
+        std::lock_guard lock(sOverflowMutex);
+        sOverflowBlocks.push_back({ memory, alignment });
+        return memory;
+    }
+} // namespace RealmFortress
@@ -0,0 +1,98 @@
+/**
+ * @file frame_allocator.h
+ * @brief
+ * @date 12/22/2025
+ */
+
+#pragma once
+
+#include "core/base.h"
+#include <atomic>
+#include <map>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace RealmFortress
+{
+    /**
+     * @class FrameAllocator
+     * @brief A linear arena for containers that only live for the current frame.
+     *
+     * Allocation bumps an atomic offset into one block reserved up front, so it is safe from
+     * job threads; deallocation does nothing and Reset(), called from Renderer::BeginFrame,
+     * reclaims everything at once. Use it through GetResource() and the Frame* aliases below,
+     * which are plain std::pmr containers. When a frame outgrows the block the rest comes from
+     * the heap and is freed on the next Reset(); GetOverflowCount() shows when to raise the
+     * capacity.
+     *
+     * Nothing allocated here may be kept past the frame it was allocated in.
+     */
+    class FrameAllocator
+    {
+    public:
+        static constexpr usize DefaultCapacity = 16ull * 1024 * 1024;
+
+        static void Init(usize capacity = DefaultCapacity);
+        static void Shutdown();
+
+        // main thread, once per frame, with no frame containers still alive
+        static void Reset();
+
+        static void* Allocate(usize size, usize alignment = alignof(std::max_align_t));
+        static std::pmr::memory_resource* GetResource();
+
+        static usize GetCapacity();
+        static usize GetUsed();
+        static usize GetPeak();
+        static u64 GetOverflowCount();
+
+    private:
+        class Resource final : public std::pmr::memory_resource
+        {
+        protected:
+            void* do_allocate(usize bytes, usize alignment) override { return Allocate(bytes, alignment); }
+            void do_deallocate(void*, usize, usize) override {}
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+        };
+
+        struct OverflowBlock
+        {
+            void* Memory;
+            usize Alignment;
+        };
+
+        static void* AllocateOverflow(usize size, usize alignment);
+
+    private:
+        // the block's own alignment, anything stricter goes to the heap
+        static constexpr usize BlockAlignment = 64;
+
+        inline static std::byte* sBuffer{ nullptr };
+        inline static usize sCapacity{ 0 };
+        inline static std::atomic<usize> sOffset{ 0 };
+        inline static usize sPeak{ 0 };
+        inline static Resource sResource;
+
+        inline static std::mutex sOverflowMutex;
+        inline static std::vector<OverflowBlock> sOverflowBlocks;
+        inline static std::atomic<u64> sOverflowCount{ 0 };
+    };
+
+    template<typename T>
+    using FrameVector = std::pmr::vector<T>;
+
+    template<typename K, typename V, typename Compare = std::less<K>>
+    using FrameMap = std::pmr::map<K, V, Compare>;
+
+    using FrameString = std::pmr::string;
+
+    template<typename T>
+    FrameVector<T> MakeFrameVector(usize reserve = 0)
+    {
+        FrameVector<T> result(FrameAllocator::GetResource());
+        result.reserve(reserve);
+        return result;
+    }
+} // namespace RealmFortress
@@ -0,0 +1,297 @@
+/**
+ * @file job_system.cpp
+ * @brief
+ * @date 12/22/2025
+ */
+
+#include "core/pch.h"
+#include "core/job_system.h"
+#include "core/logger.h"
+#include "core/profiler.h"
+
+namespace RealmFortress
+{
+    // the deque this thread pushes to; 0 for the main thread and any thread outside the pool
+    static thread_local u32 tQueueIndex = 0;
+
+    void JobSystem::Init(u32 worker_count)
+    {
+        RF_CORE_ASSERT(sWorkers.empty(), "JobSystem already initialized");
+
+        sMainThread = std::this_thread::get_id();
+
+        // at least one worker, so background jobs make progress while the main thread renders
+        if (worker_count == 0)
+        {
+            u32 hardware_threads = std::thread::hardware_concurrency();
+            worker_count = hardware_threads > 1 ? hardware_threads - 1 : 1;
+        }
+
+        sQueues.clear();
+        for (u32 i = 0; i <= worker_count; i++)
+        {
+            sQueues.push_back(CreateScope<WorkQueue>());
+        }
+
+        sRunning = true;
+        sWorkers.reserve(worker_count);
+        for (u32 i = 0; i < worker_count; i++)
+        {
+            sWorkers.emplace_back(WorkerLoop, i + 1);
+        }
+
+        RF_CORE_INFO("JobSystem started with {} workers", worker_count);
+    }
+
+    void JobSystem::Shutdown()
+    {
+        {
+            std::lock_guard lock(sMutex);
+            sRunning = false;
+        }
+        sWakeCondition.notify_all();
+
+        // workers leave once the deques are empty
+        for (auto& worker : sWorkers)
+        {
+            if (worker.joinable())
+                worker.join();
+        }
+        sWorkers.clear();
+
+        RunMainThreadJobs();
+        sQueues.clear();
+
+        if (!sDeferred.empty())
+        {
+            RF_CORE_WARN("JobSystem shut down with {} jobs still waiting on dependencies", sDeferred.size());
+            sDeferred.clear();
+        }
+    }
+
+    void JobSystem::Run(Job job, JobCounter* counter, JobAffinity affinity)
+    {
+        if (counter)
+            counter->mPending.fetch_add(1, std::memory_order_relaxed);
+
+        Submit({ std::move(job), counter }, affinity);
+    }
+
+    void JobSystem::RunAfter(const JobCounter& dependency, Job job, JobCounter* counter, JobAffinity affinity)
+    {
+        if (counter)
+            counter->mPending.fetch_add(1, std::memory_order_relaxed);
+
+        {
+            // checked under the lock the finishing job takes to release deferred jobs, so the
+            // dependency can't complete in between and leave this one parked
+            std::lock_guard lock(sMutex);
+            if (!dependency.IsDone())
+            {
+                sDeferred.push_back({ &dependency, { std::move(job), counter }, affinity });
+                return;
+            }
+        }
+
+        Submit({ std::move(job), counter }, affinity);
+    }
+
+    void JobSystem::Wait(const JobCounter& counter)
+    {
+        bool main_thread = IsMainThread();
+
+        while (!counter.IsDone())
+        {
+            Task task;
+            if (TryTake(main_thread, task))
+            {
+                Execute(task);
+                continue;
+            }
+
+            std::unique_lock lock(sMutex);
+            sWakeCondition.wait(lock, [&] { return counter.IsDone() || HasWork(main_thread); });
+        }
+    }
+
+    void JobSystem::RunMainThreadJobs()
+    {
+        RF_CORE_ASSERT(IsMainThread(), "Main thread jobs must run on the main thread");
+
+        // only what was queued so far; jobs these submit wait for the next frame
+        std::deque<Task> tasks;
+        {
+            std::lock_guard lock(sMainThreadMutex);
+            tasks.swap(sMainThreadTasks);
+            sMainThreadCount.fetch_sub(tasks.size());
+        }
+
+        for (Task& task : tasks)
+        {
+            Execute(task);
+        }
+    }
+
+    void JobSystem::ParallelFor(usize count, usize grain, const RangeJob& job)
+    {
+        usize chunk_count = GetChunkCount(count, grain);
+        if (chunk_count == 0)
+            return;
+
+        if (chunk_count == 1 || sWorkers.empty())
+        {
+            for (usize chunk = 0; chunk < chunk_count; chunk++)
+            {
+                job(chunk, chunk * grain, std::min(count, (chunk + 1) * grain));
+            }
+            return;
+        }
+
+        JobCounter counter;
+        for (usize chunk = 0; chunk < chunk_count; chunk++)
+        {
+            usize begin = chunk * grain;
+            usize end = std::min(count, begin + grain);
+            Run([&job, chunk, begin, end] { job(chunk, begin, end); }, &counter);
+        }
+
+        Wait(counter);
+    }
+
+    void JobSystem::WorkerLoop(u32 queue_index)
+    {
+        tQueueIndex = queue_index;
+        Profiler::SetThreadName("Job Worker");
+
+        while (true)
+        {
+            Task task;
+            if (TryTake(false, task))
+            {
+                Execute(task);
+                continue;
+            }
+
+            std::unique_lock lock(sMutex);
+            sWakeCondition.wait(lock, [] { return !sRunning || sQueuedCount.load() > 0; });
+            if (!sRunning && sQueuedCount.load() == 0)
+                return;
+        }
+    }
+
+    void JobSystem::Submit(Task task, JobAffinity affinity)
+    {
+        if (sWorkers.empty())
+        {
+            Execute(task);
+            return;
+        }
+
+        if (affinity == JobAffinity::MainThread)
+        {
+            {
+                std::lock_guard lock(sMainThreadMutex);
+                sMainThreadTasks.push_back(std::move(task));
+                sMainThreadCount.fetch_add(1);
+            }
+
+            // the main thread may be any one of the waiters
+            { std::lock_guard lock(sMutex); }
+            sWakeCondition.notify_all();
+            return;
+        }
+
+        {
+            WorkQueue& queue = *sQueues[tQueueIndex];
+            std::lock_guard lock(queue.Mutex);
+            queue.Tasks.push_back(std::move(task));
+            sQueuedCount.fetch_add(1);
+        }
+
+        // every sleeper wakes for queued work, so one is enough
+        { std::lock_guard lock(sMutex); }
+        sWakeCondition.notify_one();
+    }
+
+    bool JobSystem::TryTake(bool main_thread, Task& out_task)
+    {
+        if (main_thread && sMainThreadCount.load() > 0)
+        {
+            std::lock_guard lock(sMainThreadMutex);
+            if (!sMainThreadTasks.empty())
+            {
+                out_task = std::move(sMainThreadTasks.front());
+                sMainThreadTasks.pop_front();
+                sMainThreadCount.fetch_sub(1);
+                return true;
+            }
+        }
+
+        if (sQueuedCount.load() == 0)
+            return false;
+
+        // newest from our own deque while it's warm in cache, then the oldest from everyone else's
+        usize queue_count = sQueues.size();
+        for (usize i = 0; i < queue_count; i++)
+        {
+            WorkQueue& queue = *sQueues[(tQueueIndex + i) % queue_count];
+            std::lock_guard lock(queue.Mutex);
+            if (queue.Tasks.empty())
+                continue;
+
+            if (i == 0)
+            {
+                out_task = std::move(queue.Tasks.back());
+                queue.Tasks.pop_back();
+            }
+            else
+            {
+                out_task = std::move(queue.Tasks.front());
+                queue.Tasks.pop_front();
+            }
+            sQueuedCount.fetch_sub(1);
+            return true;
+        }
+        return false;
+    }
+
+    void JobSystem::Execute(Task& task)
+    {
+        {
+            RF_PROFILE_SCOPE("Job");
+            task.Function();
+        }
+
+        if (!task.Counter || task.Counter->mPending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+
+        // the counter may be gone as soon as a waiter sees it done, so it isn't touched past this point
+        std::vector<DeferredTask> ready;
+        {
+            std::lock_guard lock(sMutex);
+            for (auto it = sDeferred.begin(); it != sDeferred.end();)
+            {
+                if (it->Dependency->IsDone())
+                {
+                    ready.push_back(std::move(*it));
+                    it = sDeferred.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+        sWakeCondition.notify_all();
+
+        for (DeferredTask& deferred : ready)
+        {
+            Submit(std::move(deferred.Work), deferred.Affinity);
+        }
+    }
+
+    bool JobSystem::HasWork(bool main_thread)
+    {
+        return sQueuedCount.load() > 0 || (main_thread && sMainThreadCount.load() > 0);
+    }
+} // namespace RealmFortress
@@ -0,0 +1,137 @@
+/**
+ * @file job_system.h
+ * @brief
+ * @date 12/22/2025
+ */
+
+#pragma once
+
+#include "core/base.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RealmFortress
+{
+    enum class JobAffinity : u8
+    {
+        Any,
+        MainThread // GL work; runs in RunMainThreadJobs() or while the main thread waits
+    };
+
+    /**
+     * @class JobCounter
+     * @brief Counts the jobs submitted with it that haven't finished yet.
+     *
+     * Wait() on it to block until they're done, or pass it to RunAfter() to hold other jobs
+     * back until then. A counter must outlive every job submitted with it or waiting on it.
+     */
+    class JobCounter
+    {
+    public:
+        JobCounter() = default;
+
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        bool IsDone() const { return mPending.load(std::memory_order_acquire) == 0; }
+        u32 GetPending() const { return mPending.load(std::memory_order_relaxed); }
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<u32> mPending{ 0 };
+    };
+
+    /**
+     * @class JobSystem
+     * @brief One pool of worker threads shared by the whole game.
+     *
+     * Every worker owns a deque; jobs submitted from a thread go to the back of its own deque,
+     * the owner takes from the back and idle workers steal from the front of the others. The
+     * main thread owns deque 0. Jobs with MainThread affinity wait in a separate queue that
+     * only the main thread drains, once per frame and whenever it waits on a counter.
+     *
+     * Wait() never just blocks: the waiting thread runs queued jobs until its counter is done,
+     * so jobs may submit and wait on further jobs. ParallelFor cuts [0, count) into chunks of
+     * a fixed grain; chunk i always covers the same indices no matter how many workers there
+     * are or which one runs it, so callers that keep one result slot per chunk and merge the
+     * slots in chunk order get the same answer as a serial loop.
+     *
+     * Without workers (before Init, after Shutdown) jobs of any affinity run inline.
+     */
+    class JobSystem
+    {
+    public:
+        using Job = std::function<void()>;
+        using RangeJob = std::function<void(usize chunk, usize begin, usize end)>;
+
+        // worker_count 0 uses one worker per hardware thread besides the main one, at least one
+        static void Init(u32 worker_count = 0);
+        // finishes every queued job, then stops the workers
+        static void Shutdown();
+
+        static u32 GetWorkerCount() { return static_cast<u32>(sWorkers.size()); }
+        static usize GetChunkCount(usize count, usize grain) { return grain > 0 ? (count + grain - 1) / grain : 0; }
+        static bool IsMainThread() { return std::this_thread::get_id() == sMainThread; }
+
+        static void Run(Job job, JobCounter* counter = nullptr, JobAffinity affinity = JobAffinity::Any);
+        // queued once dependency is done; counter counts the job from now on
+        static void RunAfter(const JobCounter& dependency, Job job, JobCounter* counter = nullptr, JobAffinity affinity = JobAffinity::Any);
+
+        static void Wait(const JobCounter& counter);
+
+        // main thread, once per frame
+        static void RunMainThreadJobs();
+
+        // blocks until every chunk has run
+        static void ParallelFor(usize count, usize grain, const RangeJob& job);
+
+    private:
+        struct Task
+        {
+            Job Function;
+            JobCounter* Counter;
+        };
+
+        struct WorkQueue
+        {
+            std::mutex Mutex;
+            std::deque<Task> Tasks;
+        };
+
+        struct DeferredTask
+        {
+            const JobCounter* Dependency;
+            Task Work;
+            JobAffinity Affinity;
+        };
+
+        static void WorkerLoop(u32 queue_index);
+        static void Submit(Task task, JobAffinity affinity);
+        static bool TryTake(bool main_thread, Task& out_task);
+        static void Execute(Task& task);
+        static bool HasWork(bool main_thread);
+
+    private:
+        inline static std::vector<std::thread> sWorkers;
+        inline static std::vector<Scope<WorkQueue>> sQueues;
+        inline static std::thread::id sMainThread;
+
+        inline static std::mutex sMainThreadMutex;
+        inline static std::deque<Task> sMainThreadTasks;
+
+        // guards sRunning and sDeferred; sWakeCondition wakes idle workers and waiting threads alike
+        inline static std::mutex sMutex;
+        inline static std::condition_variable sWakeCondition;
+        inline static bool sRunning{ false };
+        inline static std::vector<DeferredTask> sDeferred;
+
+        inline static std::atomic<usize> sQueuedCount{ 0 };
+        inline static std::atomic<usize> sMainThreadCount{ 0 };
+    };
+} // namespace RealmFortress
@@ -0,0 +1,51 @@
+/**
+ * @file json.cpp
+ * @brief
+ * @date 12/23/2025
+ */
+
+#include "core/pch.h"
+#include "core/json.h"
+
+namespace RealmFortress
+{
+    void AppendJsonEscaped(std::string& out, std::string_view text)
+    {
+        constexpr char Hex[] = "0123456789abcdef";
+
+        for (char c : text)
+        {
+            switch (c)
+            {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                // every other control character has to be written as a \u escape
+                if (static_cast<u8>(c) < 0x20)
+                {
+                    out += "\\u00";
+                    out += Hex[static_cast<u8>(c) >> 4];
+                    out += Hex[static_cast<u8>(c) & 0xF];
+                }
+                else
+                {
+                    out += c;
+                }
+                break;
+            }
+        }
+    }
+
+    std::string EscapeJson(std::string_view text)
+    {
+        std::string escaped;
+        escaped.reserve(text.size());
+        AppendJsonEscaped(escaped, text);
+        return escaped;
+    }
+} // namespace RealmFortress
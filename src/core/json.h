@@ -0,0 +1,18 @@
+/**
+ * @file json.h
+ * @brief Escaping for the JSON the profiler, benchmarks and headless runner write by hand.
+ * @date 12/23/2025
+ */
+
+#pragma once
+
+#include "core/base.h"
+#include <string>
+#include <string_view>
+
+namespace RealmFortress
+{
+    // escapes text for the inside of a JSON string literal, quotes not included
+    void AppendJsonEscaped(std::string& out, std::string_view text);
+    std::string EscapeJson(std::string_view text);
+} // namespace RealmFortress
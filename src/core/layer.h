@@ -20,12 +20,16 @@ namespace RealmFortress
         virtual void OnAttach() {}
         virtual void OnDetach() {}
         virtual void OnUpdate(Timestep ts) {}
+        // called instead of OnUpdate while the window is minimized and nothing is rendered
+        virtual void OnSuspended(Timestep ts) {}
         virtual void OnImGuiRender() {}
-        virtual void OnEvent(Event& event) {}
 
         const std::string& GetName() const { return mDebugName; }
+        // what this layer handles, per event type; layers register into it instead of overriding a catch-all
+        const EventHandlerTable& GetEventHandlers() const { return mEventHandlers; }
 
     protected:
         std::string mDebugName;
+        EventHandlerTable mEventHandlers;
     };
 } // namespace RealmFortress
@@ -6,6 +6,7 @@
 
 #include "core/pch.h"
 #include "logger.h"
+#include <spdlog/async.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/basic_file_sink.h>
 
@@ -14,6 +15,22 @@ namespace RealmFortress
     Ref<spdlog::logger> Logger::sCoreLogger;
     Ref<spdlog::logger> Logger::sClientLogger;
 
+    static Ref<spdlog::logger> CreateLogger(const std::string& name, const std::vector<spdlog::sink_ptr>& sinks)
+    {
+#ifdef RF_SYNC_LOGGING
+        auto logger = std::make_shared<spdlog::logger>(name, sinks.begin(), sinks.end());
+        logger->flush_on(spdlog::level::trace);
+#else
+        // both loggers share the one writer thread, so lines from either stay in order
+        auto logger = std::make_shared<spdlog::async_logger>(name, sinks.begin(), sinks.end(), spdlog::thread_pool(),
+                                                             spdlog::async_overflow_policy::overrun_oldest);
+        logger->flush_on(spdlog::level::err);
+#endif
+        logger->set_level(spdlog::level::trace);
+        spdlog::register_logger(logger);
+        return logger;
+    }
+
     void Logger::Init()
     {
         std::vector<spdlog::sink_ptr> logSinks;
@@ -23,14 +40,28 @@ namespace RealmFortress
         logSinks[0]->set_pattern("%^[%T] %n: %v%$");
         logSinks[1]->set_pattern("[%T] [%l] %n: %v");
 
-        sCoreLogger = std::make_shared<spdlog::logger>("RealmFortress", begin(logSinks), end(logSinks));
-        spdlog::register_logger(sCoreLogger);
-        sCoreLogger->set_level(spdlog::level::trace);
-        sCoreLogger->flush_on(spdlog::level::trace);
+#ifndef RF_SYNC_LOGGING
+        spdlog::init_thread_pool(QueueSize, 1);
+        spdlog::flush_every(FlushInterval);
+#endif
+
+        sCoreLogger = CreateLogger("RealmFortress", logSinks);
+        sClientLogger = CreateLogger("APP", logSinks);
+    }
 
-        sClientLogger = std::make_shared<spdlog::logger>("APP", begin(logSinks), end(logSinks));
-        spdlog::register_logger(sClientLogger);
-        sClientLogger->set_level(spdlog::level::trace);
-        sClientLogger->flush_on(spdlog::level::trace);
+    void Logger::Shutdown()
+    {
+        // flushes and joins the writer thread; the loggers stay valid so a stray late call is only lost
+        spdlog::shutdown();
+    }
+
+    u64 Logger::GetDroppedMessageCount()
+    {
+#ifdef RF_SYNC_LOGGING
+        return 0;
+#else
+        auto thread_pool = spdlog::thread_pool();
+        return thread_pool ? thread_pool->overrun_counter() : 0;
+#endif
     }
 } // namespace RealmFortress
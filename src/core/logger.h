@@ -7,21 +7,101 @@
 #pragma once
 
 #include "core/base.h"
+#include <atomic>
+#include <chrono>
 #include <spdlog/spdlog.h>
 
 namespace RealmFortress
 {
+    /**
+     * @class Logger
+     * @brief Owns the engine and client loggers.
+     *
+     * By default both loggers are asynchronous: a call formats the message and pushes it onto a
+     * bounded queue, and a background thread writes it to the console and the log file. When the
+     * queue is full the oldest message is dropped rather than blocking the caller, and
+     * GetDroppedMessageCount() says how many went that way. The file is flushed every
+     * FlushInterval and right away on errors. Built with RF_SYNC_LOGGING, every line is written
+     * and flushed on the calling thread instead, which is slower but loses nothing on a crash.
+     */
     class Logger
     {
     public:
+        static constexpr usize QueueSize = 8192;
+        static constexpr std::chrono::seconds FlushInterval{ 1 };
+
         static void Init();
+        // writes out whatever is still queued; anything logged afterwards is lost
+        static void Shutdown();
 
         static Ref<spdlog::logger>& GetCoreLogger() { return sCoreLogger; }
         static Ref<spdlog::logger>& GetClientLogger() { return sClientLogger; }
 
+        // messages the async queue overwrote before they were written
+        static u64 GetDroppedMessageCount();
+        // messages collapsed by the RF_*_RATE_LIMITED macros
+        static u64 GetSuppressedMessageCount() { return sSuppressedCount.load(std::memory_order_relaxed); }
+
+        template<typename... Args>
+        static void LogCollapsed(const Ref<spdlog::logger>& logger, spdlog::level::level_enum level, u32 suppressed,
+                                 spdlog::format_string_t<Args...> format, Args&&... args)
+        {
+            if (suppressed == 0)
+            {
+                logger->log(level, format, std::forward<Args>(args)...);
+                return;
+            }
+
+            std::string message = spdlog::fmt_lib::vformat(format, spdlog::fmt_lib::make_format_args(args...));
+            logger->log(level, "{} ({} similar suppressed)", message, suppressed);
+        }
+
     private:
+        friend class LogRateLimiter;
+
         static Ref<spdlog::logger> sCoreLogger;
         static Ref<spdlog::logger> sClientLogger;
+
+        inline static std::atomic<u64> sSuppressedCount{ 0 };
+    };
+
+    /**
+     * @class LogRateLimiter
+     * @brief Lets one message per interval through from a call site and counts the rest.
+     *
+     * The RF_*_RATE_LIMITED macros keep one of these per call site, so a warning raised every
+     * frame shows up once a second with the number of repeats it stands for.
+     */
+    class LogRateLimiter
+    {
+    public:
+        static constexpr std::chrono::milliseconds DefaultInterval{ 1000 };
+
+        explicit LogRateLimiter(std::chrono::milliseconds interval = DefaultInterval)
+            : mInterval(std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count())
+        {
+        }
+
+        // true when this call should be logged; out_suppressed is how many were dropped since the last one
+        bool ShouldLog(u32& out_suppressed)
+        {
+            i64 now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            i64 next = mNextAllowed.load(std::memory_order_relaxed);
+            if (now < next || !mNextAllowed.compare_exchange_strong(next, now + mInterval, std::memory_order_relaxed))
+            {
+                mSuppressed.fetch_add(1, std::memory_order_relaxed);
+                Logger::sSuppressedCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            out_suppressed = mSuppressed.exchange(0, std::memory_order_relaxed);
+            return true;
+        }
+
+    private:
+        i64 mInterval;
+        std::atomic<i64> mNextAllowed{ 0 };
+        std::atomic<u32> mSuppressed{ 0 };
     };
 } // namespace RealmFortress
 
@@ -36,3 +116,21 @@ namespace RealmFortress
 #define RF_WARN(...)          ::RealmFortress::Logger::GetClientLogger()->warn(__VA_ARGS__)
 #define RF_ERROR(...)         ::RealmFortress::Logger::GetClientLogger()->error(__VA_ARGS__)
 #define RF_CRITICAL(...)      ::RealmFortress::Logger::GetClientLogger()->critical(__VA_ARGS__)
+
+// at most one message per second from the call site; the next one through carries the repeat count
+#define RF_LOG_RATE_LIMITED(logger, level, ...) \
+    do \
+    { \
+        static ::RealmFortress::LogRateLimiter rf_log_rate_limiter; \
+        ::RealmFortress::u32 rf_log_suppressed = 0; \
+        if (rf_log_rate_limiter.ShouldLog(rf_log_suppressed)) \
+            ::RealmFortress::Logger::LogCollapsed(logger, level, rf_log_suppressed, __VA_ARGS__); \
+    } while (false)
+
+#define RF_CORE_INFO_RATE_LIMITED(...)  RF_LOG_RATE_LIMITED(::RealmFortress::Logger::GetCoreLogger(), ::spdlog::level::info, __VA_ARGS__)
+#define RF_CORE_WARN_RATE_LIMITED(...)  RF_LOG_RATE_LIMITED(::RealmFortress::Logger::GetCoreLogger(), ::spdlog::level::warn, __VA_ARGS__)
+#define RF_CORE_ERROR_RATE_LIMITED(...) RF_LOG_RATE_LIMITED(::RealmFortress::Logger::GetCoreLogger(), ::spdlog::level::err, __VA_ARGS__)
+
+#define RF_INFO_RATE_LIMITED(...)       RF_LOG_RATE_LIMITED(::RealmFortress::Logger::GetClientLogger(), ::spdlog::level::info, __VA_ARGS__)
+#define RF_WARN_RATE_LIMITED(...)       RF_LOG_RATE_LIMITED(::RealmFortress::Logger::GetClientLogger(), ::spdlog::level::warn, __VA_ARGS__)
+#define RF_ERROR_RATE_LIMITED(...)      RF_LOG_RATE_LIMITED(::RealmFortress::Logger::GetClientLogger(), ::spdlog::level::err, __VA_ARGS__)
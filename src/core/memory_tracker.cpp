@@ -0,0 +1,186 @@
+/**
+ * @file memory_tracker.cpp
+ * @brief
+ * @date 12/22/2025
+ */
+
+#include "core/pch.h"
+#include "core/memory_tracker.h"
+#include "core/logger.h"
+#include <cstdlib>
+#include <new>
+
+namespace RealmFortress
+{
+    void MemoryTracker::BeginFrame()
+    {
+        u64 count = GetAllocationCount();
+        sFrameAllocationCount = count - sFrameStartCount;
+        sFrameStartCount = count;
+
+        for (usize i = 0; i < MemoryTagCount; i++)
+        {
+            TagCounters& counters = sTags[i];
+            if (counters.Budget == 0)
+                continue;
+
+            i64 used = counters.CpuBytes.load(std::memory_order_relaxed) + counters.GpuBytes.load(std::memory_order_relaxed);
+            bool over_budget = used > static_cast<i64>(counters.Budget);
+            if (over_budget && !counters.OverBudget)
+            {
+                RF_CORE_WARN("{} memory is over budget: {:.1f} MB of {:.1f} MB", MemoryTagToString(static_cast<MemoryTag>(i)),
+                             static_cast<f64>(used) / (1024.0 * 1024.0), static_cast<f64>(counters.Budget) / (1024.0 * 1024.0));
+            }
+            counters.OverBudget = over_budget;
+        }
+    }
+
+    MemoryTagUsage MemoryTracker::GetUsage(MemoryTag tag)
+    {
+        const TagCounters& counters = sTags[static_cast<usize>(tag)];
+        return {
+            counters.CpuBytes.load(std::memory_order_relaxed),
+            counters.GpuBytes.load(std::memory_order_relaxed),
+            counters.Allocations.load(std::memory_order_relaxed)
+        };
+    }
+
+    MemorySnapshot MemoryTracker::TakeSnapshot()
+    {
+        MemorySnapshot snapshot;
+        for (usize i = 0; i < MemoryTagCount; i++)
+        {
+            snapshot.Tags[i] = GetUsage(static_cast<MemoryTag>(i));
+        }
+        snapshot.AllocationCount = GetAllocationCount();
+        return snapshot;
+    }
+
+    MemorySnapshot MemoryTracker::Diff(const MemorySnapshot& before, const MemorySnapshot& after)
+    {
+        MemorySnapshot diff;
+        for (usize i = 0; i < MemoryTagCount; i++)
+        {
+            diff.Tags[i].CpuBytes = after.Tags[i].CpuBytes - before.Tags[i].CpuBytes;
+            diff.Tags[i].GpuBytes = after.Tags[i].GpuBytes - before.Tags[i].GpuBytes;
+            diff.Tags[i].Allocations = after.Tags[i].Allocations - before.Tags[i].Allocations;
+        }
+        diff.AllocationCount = after.AllocationCount - before.AllocationCount;
+        return diff;
+    }
+
+    void MemoryTracker::LogDiff(const MemorySnapshot& before, const MemorySnapshot& after)
+    {
+        MemorySnapshot diff = Diff(before, after);
+        RF_CORE_INFO("Memory since snapshot ({} allocations made):", diff.AllocationCount);
+
+        bool changed = false;
+        for (usize i = 0; i < MemoryTagCount; i++)
+        {
+            const MemoryTagUsage& usage = diff.Tags[i];
+            if (usage.CpuBytes == 0 && usage.GpuBytes == 0 && usage.Allocations == 0)
+                continue;
+
+            RF_CORE_INFO("  {:<12} cpu {:+.1f} KB, gpu {:+.1f} KB, {:+} live blocks", MemoryTagToString(static_cast<MemoryTag>(i)),
+                         static_cast<f64>(usage.CpuBytes) / 1024.0, static_cast<f64>(usage.GpuBytes) / 1024.0, usage.Allocations);
+            changed = true;
+        }
+
+        if (!changed)
+        {
+            RF_CORE_INFO("  no change");
+        }
+    }
+} // namespace RealmFortress
+
+#ifdef RF_TRACK_ALLOCATIONS
+
+// sits right in front of every block handed out, so delete knows what to take off which tag
+struct AllocationHeader
+{
+    std::size_t Size;
+    std::uint32_t Offset; // from the start of the underlying block to the pointer handed out
+    RealmFortress::MemoryTag Tag;
+};
+
+// keeps blocks from plain new at the default new alignment
+static constexpr std::size_t HeaderSize = 16;
+static_assert(sizeof(AllocationHeader) <= HeaderSize);
+
+static void* TrackBlock(void* block, std::size_t offset, std::size_t size)
+{
+    RealmFortress::MemoryTag tag = RealmFortress::MemoryTracker::GetCurrentTag();
+    RealmFortress::MemoryTracker::OnAllocate(tag, size);
+
+    char* memory = static_cast<char*>(block) + offset;
+    auto* header = reinterpret_cast<AllocationHeader*>(memory - HeaderSize);
+    header->Size = size;
+    header->Offset = static_cast<std::uint32_t>(offset);
+    header->Tag = tag;
+    return memory;
+}
+
+static void* UntrackBlock(void* memory)
+{
+    auto* header = reinterpret_cast<AllocationHeader*>(static_cast<char*>(memory) - HeaderSize);
+    RealmFortress::MemoryTracker::OnFree(header->Tag, header->Size);
+    return static_cast<char*>(memory) - header->Offset;
+}
+
+// the array and nothrow forms forward to these in every standard library we build with
+static void* TrackedAllocate(std::size_t size)
+{
+    if (void* block = std::malloc(HeaderSize + size))
+        return TrackBlock(block, HeaderSize, size);
+    throw std::bad_alloc();
+}
+
+static void* TrackedAllocateAligned(std::size_t size, std::align_val_t alignment)
+{
+    // the header goes in the padding that keeps the returned pointer aligned
+    std::size_t align = static_cast<std::size_t>(alignment);
+    std::size_t offset = std::max(align, HeaderSize);
+#ifdef RF_PLATFORM_WINDOWS
+    void* block = _aligned_malloc(offset + size, align);
+#else
+    // aligned_alloc wants the size to be a multiple of the alignment
+    void* block = std::aligned_alloc(align, (offset + size + align - 1) & ~(align - 1));
+#endif
+    if (block)
+        return TrackBlock(block, offset, size);
+    throw std::bad_alloc();
+}
+
+static void TrackedFree(void* memory)
+{
+    if (memory)
+        std::free(UntrackBlock(memory));
+}
+
+static void TrackedFreeAligned(void* memory)
+{
+    if (!memory)
+        return;
+
+#ifdef RF_PLATFORM_WINDOWS
+    _aligned_free(UntrackBlock(memory));
+#else
+    std::free(UntrackBlock(memory));
+#endif
+}
+
+void* operator new(std::size_t size) { return TrackedAllocate(size); }
+void* operator new[](std::size_t size) { return TrackedAllocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return TrackedAllocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return TrackedAllocateAligned(size, alignment); }
+
+void operator delete(void* memory) noexcept { TrackedFree(memory); }
+void operator delete[](void* memory) noexcept { TrackedFree(memory); }
+void operator delete(void* memory, std::size_t) noexcept { TrackedFree(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { TrackedFree(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { TrackedFreeAligned(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { TrackedFreeAligned(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { TrackedFreeAligned(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { TrackedFreeAligned(memory); }
+
+#endif
@@ -0,0 +1,172 @@
+/**
+ * @file memory_tracker.h
+ * @brief
+ * @date 12/22/2025
+ */
+
+#pragma once
+
+#include "core/base.h"
+#include <array>
+#include <atomic>
+
+namespace RealmFortress
+{
+    enum class MemoryTag : u8
+    {
+        General,
+        Map,
+        Models,
+        Textures,
+        Framebuffers,
+        Buildings,
+        ImGui,
+
+        Count
+    };
+
+    constexpr usize MemoryTagCount = static_cast<usize>(MemoryTag::Count);
+
+    inline const char* MemoryTagToString(MemoryTag tag)
+    {
+        switch (tag)
+        {
+        case MemoryTag::General:      return "General";
+        case MemoryTag::Map:          return "Map";
+        case MemoryTag::Models:       return "Models";
+        case MemoryTag::Textures:     return "Textures";
+        case MemoryTag::Framebuffers: return "Framebuffers";
+        case MemoryTag::Buildings:    return "Buildings";
+        case MemoryTag::ImGui:        return "ImGui";
+        default:                      return "Unknown";
+        }
+    }
+
+    // live amounts; in a diff, the change between two snapshots
+    struct MemoryTagUsage
+    {
+        i64 CpuBytes = 0;
+        i64 GpuBytes = 0;
+        i64 Allocations = 0;
+    };
+
+    struct MemorySnapshot
+    {
+        std::array<MemoryTagUsage, MemoryTagCount> Tags{};
+        u64 AllocationCount = 0;
+
+        const MemoryTagUsage& operator[](MemoryTag tag) const { return Tags[static_cast<usize>(tag)]; }
+    };
+
+    /**
+     * @class MemoryTracker
+     * @brief Counts heap allocations and splits CPU and GPU memory by subsystem tag.
+     *
+     * Built with RF_TRACK_ALLOCATIONS, the global operator new is replaced by one that stores
+     * the size and the calling thread's current tag in a small header in front of each block,
+     * so the matching delete can take it off the same tag. Tags are set with RF_MEMORY_TAG for
+     * the rest of a scope; anything allocated outside one counts as General. Without the
+     * define, CPU figures stay zero.
+     *
+     * GPU memory is always accounted: textures, buffers and framebuffers report their estimated
+     * sizes when created and destroyed. Renderer::BeginFrame closes the frame and warns once
+     * whenever a tag crosses its budget.
+     */
+    class MemoryTracker
+    {
+    public:
+        static constexpr bool IsEnabled()
+        {
+#ifdef RF_TRACK_ALLOCATIONS
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        static MemoryTag GetCurrentTag() { return tCurrentTag; }
+        static void SetCurrentTag(MemoryTag tag) { tCurrentTag = tag; }
+
+        // called by the allocation hooks
+        static void OnAllocate(MemoryTag tag, usize size)
+        {
+            TagCounters& counters = sTags[static_cast<usize>(tag)];
+            counters.CpuBytes.fetch_add(static_cast<i64>(size), std::memory_order_relaxed);
+            counters.Allocations.fetch_add(1, std::memory_order_relaxed);
+            sAllocationCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static void OnFree(MemoryTag tag, usize size)
+        {
+            TagCounters& counters = sTags[static_cast<usize>(tag)];
+            counters.CpuBytes.fetch_sub(static_cast<i64>(size), std::memory_order_relaxed);
+            counters.Allocations.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        static void OnGpuAllocate(MemoryTag tag, usize size) { sTags[static_cast<usize>(tag)].GpuBytes.fetch_add(static_cast<i64>(size), std::memory_order_relaxed); }
+        static void OnGpuFree(MemoryTag tag, usize size) { sTags[static_cast<usize>(tag)].GpuBytes.fetch_sub(static_cast<i64>(size), std::memory_order_relaxed); }
+
+        // main thread, once per frame
+        static void BeginFrame();
+
+        static u64 GetAllocationCount() { return sAllocationCount.load(std::memory_order_relaxed); }
+        static u64 GetFrameAllocationCount() { return sFrameAllocationCount; }
+
+        static MemoryTagUsage GetUsage(MemoryTag tag);
+
+        // CPU and GPU bytes together; 0 means no budget
+        static void SetBudget(MemoryTag tag, usize bytes) { sTags[static_cast<usize>(tag)].Budget = bytes; }
+        static usize GetBudget(MemoryTag tag) { return sTags[static_cast<usize>(tag)].Budget; }
+
+        // take one before and one after a suspect stretch of play; what didn't go back down leaked
+        static MemorySnapshot TakeSnapshot();
+        static MemorySnapshot Diff(const MemorySnapshot& before, const MemorySnapshot& after);
+        static void LogDiff(const MemorySnapshot& before, const MemorySnapshot& after);
+
+    private:
+        // a cache line each, so threads allocating under different tags don't contend; no member
+        // initializers, since sTags below is used in this class, and static storage zeroes it anyway
+        struct alignas(64) TagCounters
+        {
+            std::atomic<i64> CpuBytes;
+            std::atomic<i64> GpuBytes;
+            std::atomic<i64> Allocations;
+
+            // main thread only
+            usize Budget;
+            bool OverBudget;
+        };
+
+        inline static std::array<TagCounters, MemoryTagCount> sTags;
+        inline static std::atomic<u64> sAllocationCount{ 0 };
+        inline static u64 sFrameStartCount{ 0 };
+        inline static u64 sFrameAllocationCount{ 0 };
+
+        inline static thread_local MemoryTag tCurrentTag{ MemoryTag::General };
+    };
+
+    class MemoryTagScope
+    {
+    public:
+        explicit MemoryTagScope(MemoryTag tag)
+            : mPrevious(MemoryTracker::GetCurrentTag())
+        {
+            MemoryTracker::SetCurrentTag(tag);
+        }
+
+        ~MemoryTagScope()
+        {
+            MemoryTracker::SetCurrentTag(mPrevious);
+        }
+
+        MemoryTagScope(const MemoryTagScope&) = delete;
+        MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+    private:
+        MemoryTag mPrevious;
+    };
+} // namespace RealmFortress
+
+#define RF_MEMORY_TAG_CONCAT_INNER(a, b) a##b
+#define RF_MEMORY_TAG_CONCAT(a, b) RF_MEMORY_TAG_CONCAT_INNER(a, b)
+#define RF_MEMORY_TAG(tag) ::RealmFortress::MemoryTagScope RF_MEMORY_TAG_CONCAT(rf_memory_tag_, __LINE__)(tag)
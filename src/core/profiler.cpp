@@ -0,0 +1,183 @@
+/**
+ * @file profiler.cpp
+ * @brief
+ * @date 12/22/2025
+ */
+
+#include "core/pch.h"
+#include "core/profiler.h"
+#include "core/job_system.h"
+#include "core/json.h"
+#include "core/logger.h"
+
+namespace RealmFortress
+{
+    void Profiler::BeginCapture(u32 frame_count, const std::string& path)
+    {
+#ifndef RF_ENABLE_PROFILING
+        RF_CORE_WARN("Profiler capture requested, but this build has no profile scopes (RF_ENABLE_PROFILING is off)");
+#endif
+        if (IsCapturing() || sRequestedFrames > 0)
+        {
+            RF_CORE_WARN("Profiler capture already in progress");
+            return;
+        }
+
+        sRequestedFrames = std::max(frame_count, 1u);
+        sRequestedPath = path;
+    }
+
+    void Profiler::OnFrame()
+    {
+        if (IsCapturing() && --sRemainingFrames == 0)
+        {
+            EndCapture();
+        }
+
+        if (sRequestedFrames > 0 && !IsCapturing())
+        {
+            sRemainingFrames = sRequestedFrames;
+            sRequestedFrames = 0;
+
+            sCapturePath = sRequestedPath.empty()
+                ? std::format("realm-fortress-trace-{}.json", std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count())
+                : sRequestedPath;
+
+            // buffers notice the new generation and start over on their next event
+            sGeneration.fetch_add(1, std::memory_order_release);
+            sCapturing.store(true, std::memory_order_relaxed);
+
+            RF_CORE_INFO("Profiler capturing {} frames", sRemainingFrames);
+        }
+    }
+
+    void Profiler::SetThreadName(const char* name)
+    {
+        tThreadName = name;
+        if (tThreadBuffer)
+            tThreadBuffer->Name = name;
+    }
+
+    void Profiler::Record(const char* name, u64 start, u64 end)
+    {
+        ThreadBuffer& buffer = GetThreadBuffer();
+
+        u32 generation = sGeneration.load(std::memory_order_acquire);
+        if (buffer.Generation.load(std::memory_order_relaxed) != generation)
+        {
+            buffer.Count.store(0, std::memory_order_relaxed);
+            buffer.Dropped.store(0, std::memory_order_relaxed);
+            buffer.Generation.store(generation, std::memory_order_relaxed);
+        }
+
+        u32 index = buffer.Count.load(std::memory_order_relaxed);
+        if (index >= EventsPerThread)
+        {
+            buffer.Dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        buffer.Events[index] = { name, start, end };
+        buffer.Count.store(index + 1, std::memory_order_release);
+    }
+
+    Profiler::ThreadBuffer& Profiler::GetThreadBuffer()
+    {
+        if (!tThreadBuffer)
+        {
+            // once per thread; the buffer outlives the thread so its events can still be written
+            std::lock_guard lock(sBuffersMutex);
+            sBuffers.push_back(CreateScope<ThreadBuffer>());
+            sBuffers.back()->ThreadId = static_cast<u32>(sBuffers.size());
+            sBuffers.back()->Name = tThreadName;
+            tThreadBuffer = sBuffers.back().get();
+        }
+        return *tThreadBuffer;
+    }
+
+    void Profiler::EndCapture()
+    {
+        sCapturing.store(false, std::memory_order_relaxed);
+        u32 generation = sGeneration.load(std::memory_order_relaxed);
+
+        std::vector<TraceEvent> events;
+        std::vector<std::pair<u32, std::string>> threads;
+        u64 dropped = 0;
+        {
+            std::lock_guard lock(sBuffersMutex);
+            for (const auto& buffer : sBuffers)
+            {
+                if (buffer->Generation.load(std::memory_order_relaxed) != generation)
+                    continue;
+
+                // events still being written by threads that saw the capture running are left out
+                u32 count = buffer->Count.load(std::memory_order_acquire);
+                for (u32 i = 0; i < count; i++)
+                {
+                    const Event& event = buffer->Events[i];
+                    events.push_back({ event.Name, event.Start, event.End, buffer->ThreadId });
+                }
+
+                dropped += buffer->Dropped.load(std::memory_order_relaxed);
+                threads.emplace_back(buffer->ThreadId, buffer->Name ? buffer->Name : std::format("Thread {}", buffer->ThreadId));
+            }
+        }
+
+        if (dropped > 0)
+        {
+            RF_CORE_WARN("Profiler dropped {} events, a thread's buffer filled up", dropped);
+        }
+
+        JobSystem::Run([path = sCapturePath, events = std::move(events), threads = std::move(threads)]
+        {
+            WriteTrace(path, events, threads);
+        });
+    }
+
+    void Profiler::WriteTrace(const std::string& path, const std::vector<TraceEvent>& events, const std::vector<std::pair<u32, std::string>>& threads)
+    {
+        std::ofstream file(path, std::ios::binary);
+        if (!file)
+        {
+            RF_CORE_ERROR("Profiler could not write trace: {}", path);
+            return;
+        }
+
+        u64 origin = std::numeric_limits<u64>::max();
+        for (const TraceEvent& event : events)
+        {
+            origin = std::min(origin, event.Start);
+        }
+
+        std::string json;
+        json.reserve(events.size() * 96 + 256);
+        json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        bool first = true;
+        for (const auto& [thread_id, name] : threads)
+        {
+            json += first ? "\n" : ",\n";
+            first = false;
+            json += std::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"", thread_id);
+            AppendJsonEscaped(json, name);
+            json += "\"}}";
+        }
+
+        for (const TraceEvent& event : events)
+        {
+            json += first ? "\n" : ",\n";
+            first = false;
+            json += "{\"name\":\"";
+            AppendJsonEscaped(json, event.Name);
+            json += std::format("\",\"cat\":\"scope\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                                event.ThreadId,
+                                static_cast<f64>(event.Start - origin) / 1000.0,
+                                static_cast<f64>(event.End - event.Start) / 1000.0);
+        }
+
+        json += "\n]}\n";
+        file.write(json.data(), static_cast<std::streamsize>(json.size()));
+
+        RF_CORE_INFO("Profiler wrote {} events to {}", events.size(), path);
+    }
+} // namespace RealmFortress
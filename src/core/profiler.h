@@ -0,0 +1,140 @@
+/**
+ * @file profiler.h
+ * @brief
+ * @date 12/22/2025
+ */
+
+#pragma once
+
+#include "core/base.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace RealmFortress
+{
+    /**
+     * @class Profiler
+     * @brief Captures scoped timings over a number of frames into a Chrome trace file.
+     *
+     * Every thread records into its own fixed buffer, so a scope costs two clock reads and an
+     * unshared store while capturing and a single relaxed load otherwise. A capture starts on
+     * the next frame boundary after BeginCapture() and stops after the requested number of
+     * frames; the events are then written on a job as trace-event JSON, which chrome://tracing
+     * and Perfetto open directly.
+     *
+     * Scope names are stored as pointers and must outlive the capture; use string literals.
+     * Built without RF_ENABLE_PROFILING, the RF_PROFILE_* macros expand to nothing.
+     */
+    class Profiler
+    {
+    public:
+        static constexpr u32 DefaultCaptureFrames = 300;
+
+        // captures the next frame_count frames; an empty path picks a timestamped file name
+        static void BeginCapture(u32 frame_count = DefaultCaptureFrames, const std::string& path = {});
+        static bool IsCapturing() { return sCapturing.load(std::memory_order_relaxed); }
+
+        // main thread, at the top of every frame
+        static void OnFrame();
+
+        // names this thread's track in the trace
+        static void SetThreadName(const char* name);
+
+        static u64 Now()
+        {
+            return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        static void Record(const char* name, u64 start, u64 end);
+
+    private:
+        static constexpr usize EventsPerThread = 1 << 16;
+
+        struct Event
+        {
+            const char* Name;
+            u64 Start;
+            u64 End;
+        };
+
+        struct ThreadBuffer
+        {
+            std::array<Event, EventsPerThread> Events;
+            // written by the owning thread only, read by the main thread once the capture ends
+            std::atomic<u32> Count{ 0 };
+            std::atomic<u32> Generation{ 0 };
+            std::atomic<u64> Dropped{ 0 };
+            u32 ThreadId{ 0 };
+            const char* Name{ nullptr };
+        };
+
+        struct TraceEvent
+        {
+            const char* Name;
+            u64 Start;
+            u64 End;
+            u32 ThreadId;
+        };
+
+        static ThreadBuffer& GetThreadBuffer();
+        static void EndCapture();
+        static void WriteTrace(const std::string& path, const std::vector<TraceEvent>& events, const std::vector<std::pair<u32, std::string>>& threads);
+
+    private:
+        inline static std::atomic<bool> sCapturing{ false };
+        inline static std::atomic<u32> sGeneration{ 0 };
+
+        // main thread only
+        inline static u32 sRequestedFrames{ 0 };
+        inline static u32 sRemainingFrames{ 0 };
+        inline static std::string sRequestedPath;
+        inline static std::string sCapturePath;
+
+        inline static std::mutex sBuffersMutex;
+        inline static std::vector<Scope<ThreadBuffer>> sBuffers;
+
+        // created on the thread's first event, so threads that are never profiled cost nothing
+        inline static thread_local ThreadBuffer* tThreadBuffer{ nullptr };
+        inline static thread_local const char* tThreadName{ nullptr };
+    };
+
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(const char* name)
+            : mName(name), mStart(Profiler::IsCapturing() ? Profiler::Now() : 0)
+        {
+        }
+
+        ~ProfileScope()
+        {
+            if (mStart != 0)
+                Profiler::Record(mName, mStart, Profiler::Now());
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        const char* mName;
+        u64 mStart;
+    };
+} // namespace RealmFortress
+
+#ifdef RF_ENABLE_PROFILING
+#   define RF_PROFILE_CONCAT_INNER(a, b) a##b
+#   define RF_PROFILE_CONCAT(a, b) RF_PROFILE_CONCAT_INNER(a, b)
+#   define RF_PROFILE_SCOPE(name) ::RealmFortress::ProfileScope RF_PROFILE_CONCAT(rf_profile_scope_, __LINE__)(name)
+#   if defined(_MSC_VER)
+#       define RF_PROFILE_FUNCTION() RF_PROFILE_SCOPE(__FUNCTION__)
+#   else
+#       define RF_PROFILE_FUNCTION() RF_PROFILE_SCOPE(__func__)
+#   endif
+#else
+#   define RF_PROFILE_SCOPE(name)
+#   define RF_PROFILE_FUNCTION()
+#endif
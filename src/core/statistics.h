@@ -0,0 +1,29 @@
+/**
+ * @file statistics.h
+ * @brief Percentiles shared by the perf overlay, the benchmarks and the headless runner.
+ * @date 12/23/2025
+ */
+
+#pragma once
+
+#include "core/base.h"
+#include <algorithm>
+#include <cmath>
+#include <ranges>
+
+namespace RealmFortress
+{
+    // nearest-rank percentile of values already sorted ascending, p in [0, 1]: the smallest
+    // value with at least p of the samples at or below it; empty gives 0.
+    // Every timing report uses this one rule so their numbers can be compared directly
+    template<std::ranges::random_access_range Range>
+    std::ranges::range_value_t<Range> SortedPercentile(const Range& sorted, f64 p)
+    {
+        usize count = std::ranges::size(sorted);
+        if (count == 0)
+            return {};
+
+        usize rank = static_cast<usize>(std::ceil(std::clamp(p, 0.0, 1.0) * static_cast<f64>(count)));
+        return std::ranges::begin(sorted)[std::clamp<usize>(rank, 1, count) - 1];
+    }
+} // namespace RealmFortress
@@ -49,8 +49,10 @@ namespace RealmFortress
             sGLFWInitialized = true;
         }
 
+        // DSA is the newest thing the renderer uses; asking for 4.5 rather than 4.6 lets Mesa's
+        // llvmpipe run the game on headless machines for --benchmark
         glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
         glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
         glfwWindowHint(GLFW_SAMPLES, 4);
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "core/base.h"
+#include <array>
 #include <string>
 #include <sstream>
 
@@ -21,6 +22,8 @@ namespace RealmFortress
         MouseButtonPressed, MouseButtonReleased, MouseMoved, MouseScrolled
     };
 
+    constexpr usize EventTypeCount = static_cast<usize>(EventType::MouseScrolled) + 1;
+
     enum EventCategory
     {
         None = 0,
@@ -31,7 +34,7 @@ namespace RealmFortress
         EventCategoryMouseButton    = BIT(4)
     };
 
-#   define EVENT_CLASS_TYPE(type) static  EventType   GetStaticType()               { return EventType::type; } \
+#   define EVENT_CLASS_TYPE(type) static constexpr EventType GetStaticType()         { return EventType::type; } \
                                   virtual EventType   GetEventType() const override { return GetStaticType(); } \
                                   virtual const char* GetName()      const override { return #type; }
 
@@ -66,14 +69,15 @@ namespace RealmFortress
     {
     public:
         explicit EventDispatcher(Event& event)
-            : mEvent(event)
+            : mEvent(event), mType(event.GetEventType())
         {
         }
 
+        // the type is read once up front, so each Dispatch is a compare against a constant
         template<typename T, typename F>
         bool Dispatch(const F& func)
         {
-            if (mEvent.GetEventType() == T::GetStaticType())
+            if (mType == T::GetStaticType())
             {
                 mEvent.mHandled |= func(static_cast<T&>(mEvent));
                 return true;
@@ -83,5 +87,53 @@ namespace RealmFortress
 
     private:
         Event& mEvent;
+        EventType mType;
+    };
+
+    /**
+     * @class EventHandlerTable
+     * @brief One handler slot per EventType, so dispatch is an index instead of a chain of type checks.
+     *
+     * Handlers are a bound instance and a plain function pointer generated per registration,
+     * so registering and dispatching never allocate. A type with nothing registered costs one
+     * null check.
+     */
+    class EventHandlerTable
+    {
+    public:
+        // Method takes T& (or any base of it) and returns whether the event was handled
+        template<typename T, auto Method, typename Owner>
+        void Register(Owner* owner)
+        {
+            mHandlers[static_cast<usize>(T::GetStaticType())] = { owner, [](void* instance, Event& event)
+            {
+                return (static_cast<Owner*>(instance)->*Method)(static_cast<T&>(event));
+            } };
+        }
+
+        template<typename T>
+        void Unregister() { mHandlers[static_cast<usize>(T::GetStaticType())] = {}; }
+
+        bool Has(EventType type) const { return mHandlers[static_cast<usize>(type)].Invoke != nullptr; }
+
+        // type must be event's own, callers that know it statically skip GetEventType()
+        bool Dispatch(Event& event, EventType type) const
+        {
+            const Handler& handler = mHandlers[static_cast<usize>(type)];
+            if (!handler.Invoke)
+                return false;
+
+            event.mHandled |= handler.Invoke(handler.Instance, event);
+            return true;
+        }
+
+    private:
+        struct Handler
+        {
+            void* Instance{ nullptr };
+            bool (*Invoke)(void* instance, Event& event){ nullptr };
+        };
+
+        std::array<Handler, EventTypeCount> mHandlers{};
     };
 } // namespace RealmFortress
@@ -0,0 +1,65 @@
+/**
+ * @file event_queue.cpp
+ * @brief
+ * @date 12/22/2025
+ */
+
+#include "core/pch.h"
+#include "events/event_queue.h"
+#include "core/logger.h"
+
+namespace RealmFortress
+{
+    void EventQueue::Push(Event& event)
+    {
+        switch (event.GetEventType())
+        {
+        case EventType::WindowResize:        PushTyped(static_cast<WindowResizeEvent&>(event)); break;
+        case EventType::WindowClose:         PushTyped(static_cast<WindowCloseEvent&>(event)); break;
+        case EventType::KeyPressed:          PushTyped(static_cast<KeyPressedEvent&>(event)); break;
+        case EventType::KeyReleased:         PushTyped(static_cast<KeyReleasedEvent&>(event)); break;
+        case EventType::KeyTyped:            PushTyped(static_cast<KeyTypedEvent&>(event)); break;
+        case EventType::MouseButtonPressed:  PushTyped(static_cast<MouseButtonPressedEvent&>(event)); break;
+        case EventType::MouseButtonReleased: PushTyped(static_cast<MouseButtonReleasedEvent&>(event)); break;
+        case EventType::MouseMoved:          PushTyped(static_cast<MouseMovedEvent&>(event)); break;
+        case EventType::MouseScrolled:       PushTyped(static_cast<MouseScrolledEvent&>(event)); break;
+        default:
+            RF_CORE_WARN_RATE_LIMITED("EventQueue can't carry {} events", event.GetName());
+            break;
+        }
+    }
+
+    template<typename T>
+    void EventQueue::PushTyped(const T& event)
+    {
+        if constexpr (std::is_same_v<T, MouseMovedEvent> || std::is_same_v<T, MouseScrolledEvent>)
+        {
+            if (mCount > 0)
+            {
+                QueuedEvent& tail = mEvents[(mHead + mCount - 1) % Capacity];
+                if (T* previous = std::get_if<T>(&tail))
+                {
+                    if constexpr (std::is_same_v<T, MouseMovedEvent>)
+                        *previous = event;
+                    else
+                        *previous = MouseScrolledEvent(previous->GetXOffset() + event.GetXOffset(), previous->GetYOffset() + event.GetYOffset());
+
+                    mCoalescedCount++;
+                    return;
+                }
+            }
+        }
+
+        if (mCount == Capacity)
+        {
+            // only happens if nobody flushes, and then the newest input is the least surprising to lose
+            mDroppedCount++;
+            RF_CORE_WARN_RATE_LIMITED("EventQueue is full, dropping {}", event.GetName());
+            return;
+        }
+
+        T& queued = mEvents[(mHead + mCount) % Capacity].template emplace<T>(event);
+        queued.mHandled = false;
+        mCount++;
+    }
+} // namespace RealmFortress
@@ -0,0 +1,80 @@
+/**
+ * @file event_queue.h
+ * @brief
+ * @date 12/22/2025
+ */
+
+#pragma once
+
+#include "core/base.h"
+#include "events/application_event.h"
+#include "events/key_event.h"
+#include "events/mouse_event.h"
+#include <array>
+#include <variant>
+
+namespace RealmFortress
+{
+    /**
+     * @class EventQueue
+     * @brief Buffers window events between frames and hands them out in arrival order.
+     *
+     * Events are stored by value in a fixed ring of variants, so queuing never allocates, and
+     * Flush() hands each one to the handler through std::visit with its static type, which the
+     * Application then uses to index each layer's EventHandlerTable.
+     * A mouse move or scroll that directly follows another of the same kind is merged into it
+     * (latest position, summed offsets); anything in between, such as a button or key event,
+     * ends the run, so input that depends on order is seen exactly as it happened.
+     */
+    class EventQueue
+    {
+    public:
+        // the first alternative default-constructs the empty slots
+        using QueuedEvent = std::variant<
+            WindowCloseEvent,
+            WindowResizeEvent,
+            KeyPressedEvent,
+            KeyReleasedEvent,
+            KeyTypedEvent,
+            MouseButtonPressedEvent,
+            MouseButtonReleasedEvent,
+            MouseMovedEvent,
+            MouseScrolledEvent>;
+
+        static constexpr usize Capacity = 256;
+
+        // window callbacks; events of types the queue doesn't carry are ignored
+        void Push(Event& event);
+
+        // calls handler(T&) with every queued event in order, including any pushed meanwhile
+        template<typename F>
+        void Flush(F&& handler)
+        {
+            while (mCount > 0)
+            {
+                // copied out, a handler may queue more (a fullscreen toggle resizes the window)
+                QueuedEvent event = mEvents[mHead];
+                mHead = (mHead + 1) % Capacity;
+                mCount--;
+
+                std::visit(handler, event);
+            }
+        }
+
+        usize GetQueuedCount() const { return mCount; }
+        u64 GetCoalescedCount() const { return mCoalescedCount; }
+        u64 GetDroppedCount() const { return mDroppedCount; }
+
+    private:
+        template<typename T>
+        void PushTyped(const T& event);
+
+    private:
+        std::array<QueuedEvent, Capacity> mEvents;
+        usize mHead{ 0 };
+        usize mCount{ 0 };
+
+        u64 mCoalescedCount{ 0 };
+        u64 mDroppedCount{ 0 };
+    };
+} // namespace RealmFortress
@@ -16,7 +16,16 @@ namespace RealmFortress
         spec.mName = "Realm Fortress";
         spec.mCommandLineArgs = args;
         Application* app = new Application(spec);
-        app->PushLayer(new GameLayer());
+
+        // --benchmark <script> flies the camera along a scripted path, writes timings and quits
+        std::filesystem::path benchmark_script;
+        for (int i = 1; i + 1 < args.mCount; i++)
+        {
+            if (std::string_view(args[i]) == "--benchmark")
+                benchmark_script = args[i + 1];
+        }
+
+        app->PushLayer(new GameLayer(benchmark_script));
         return app;
     }
 } // namespace RealmFortress
@@ -0,0 +1,162 @@
+/**
+ * @file asset_preloader.cpp
+ * @brief
+ * @date 12/21/2025
+ */
+
+#include "core/pch.h"
+#include "asset_preloader.h"
+#include "core/logger.h"
+#include "renderer/model_cache.h"
+#include "game/building/building.h"
+#include "game/resource/resource.h"
+#include "game/system/tile.h"
+
+namespace RealmFortress
+{
+    AssetPreloader::~AssetPreloader()
+    {
+        // jobs that haven't started yet skip their decode, in-flight ones finish first
+        mCancelled = true;
+        JobSystem::Wait(mDecodeJobs);
+    }
+
+    void AssetPreloader::Start()
+    {
+        if (mStarted)
+            return;
+
+        CollectRequests();
+        mStarted = true;
+
+        RF_CORE_INFO("Preloading {} models on {} workers", mRequests.size(), JobSystem::GetWorkerCount());
+
+        for (usize index = 0; index < mRequests.size(); index++)
+        {
+            JobSystem::Run([this, index] { Decode(index); }, &mDecodeJobs);
+        }
+    }
+
+    bool AssetPreloader::Update(f32 budget_ms)
+    {
+        if (!mStarted)
+            return false;
+
+        if (IsDone())
+            return true;
+
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::pair<usize, ModelData>> batch;
+        {
+            std::lock_guard lock(mDecodedMutex);
+            batch.swap(mDecoded);
+        }
+
+        // GL uploads have to stay on this thread; stop once the frame budget is spent and put the rest back
+        usize uploaded = 0;
+        for (; uploaded < batch.size(); uploaded++)
+        {
+            auto& [index, data] = batch[uploaded];
+            const Request& request = mRequests[index];
+
+            if (data.Valid)
+            {
+                ModelCache::Add(request.Path, request.Format, CreateScope<Model>(data, request.Format));
+            }
+            else
+            {
+                RF_CORE_ERROR("Failed to preload model: {}", request.Path);
+            }
+
+            mLastLoaded = request.Path;
+            mUploaded++;
+
+            std::chrono::duration<f32, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() >= budget_ms)
+            {
+                uploaded++;
+                break;
+            }
+        }
+
+        if (uploaded < batch.size())
+        {
+            std::lock_guard lock(mDecodedMutex);
+            mDecoded.insert(mDecoded.end(),
+                std::make_move_iterator(batch.begin() + uploaded),
+                std::make_move_iterator(batch.end()));
+        }
+
+        if (IsDone())
+        {
+            RF_CORE_INFO("Preloaded {} models ({} cached)", mRequests.size(), ModelCache::GetCachedCount());
+            return true;
+        }
+
+        return false;
+    }
+
+    f32 AssetPreloader::GetProgress() const
+    {
+        if (mRequests.empty())
+            return mStarted ? 1.0f : 0.0f;
+
+        // decoding is the bulk of the work, uploading the remainder
+        f32 decoded = static_cast<f32>(mDecodedCount.load()) / static_cast<f32>(mRequests.size());
+        f32 uploaded = static_cast<f32>(mUploaded) / static_cast<f32>(mRequests.size());
+        return decoded * 0.7f + uploaded * 0.3f;
+    }
+
+    void AssetPreloader::CollectRequests()
+    {
+        // terrain tiles and decorations stay on the standard layout until the shaders apply
+        // uPositionScale/uPositionOffset, which the packed layout needs
+        for (u8 type = static_cast<u8>(TileType::None) + 1; type < static_cast<u8>(TileType::Count); type++)
+        {
+            AddRequest(TileTypeToModelPath(static_cast<TileType>(type)), VertexFormat::Standard);
+        }
+
+        for (u8 type = static_cast<u8>(DecorationType::None) + 1; type < static_cast<u8>(DecorationType::Count); type++)
+        {
+            if (const char* path = DecorationTypeToModelPath(static_cast<DecorationType>(type)))
+            {
+                AddRequest(path, VertexFormat::Standard);
+            }
+        }
+
+        for (i32 type = 0; type < static_cast<i32>(BuildingType::Count); type++)
+        {
+            AddRequest(GetBuildingDefinition(static_cast<BuildingType>(type)).ModelPath, VertexFormat::Standard);
+        }
+
+        for (i32 type = 0; type < static_cast<i32>(ResourceType::Count); type++)
+        {
+            AddRequest(ResourceTypeToThumbnailModelPath(static_cast<ResourceType>(type)), VertexFormat::Standard);
+        }
+    }
+
+    void AssetPreloader::AddRequest(const std::string& path, VertexFormat format)
+    {
+        if (path.empty() || ModelCache::Exists(path))
+            return;
+
+        auto it = std::ranges::find_if(mRequests, [&](const Request& request) { return request.Path == path; });
+        if (it == mRequests.end())
+        {
+            mRequests.push_back({ path, format });
+        }
+    }
+
+    void AssetPreloader::Decode(usize index)
+    {
+        if (mCancelled)
+            return;
+
+        ModelData data = Model::Decode(mRequests[index].Path);
+        mDecodedCount++;
+
+        std::lock_guard lock(mDecodedMutex);
+        mDecoded.emplace_back(index, std::move(data));
+    }
+} // namespace RealmFortress
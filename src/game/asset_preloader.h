@@ -0,0 +1,72 @@
+/**
+ * @file asset_preloader.h
+ * @brief
+ * @date 12/21/2025
+ */
+
+#pragma once
+
+#include "core/base.h"
+#include "core/job_system.h"
+#include "renderer/model.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace RealmFortress
+{
+    /**
+     * @class AssetPreloader
+     * @brief Loads every model the game can reference before play starts.
+     *
+     * Paths are collected from the tile, decoration, building and resource tables. One job per
+     * model decodes it (file read, Assimp, stb) on the JobSystem while the main thread uploads
+     * finished models to the GPU a few at a time in Update(), so the loading screen keeps
+     * drawing. Results go into ModelCache, so later Load() calls are cache hits.
+     */
+    class AssetPreloader
+    {
+    public:
+        AssetPreloader() = default;
+        ~AssetPreloader();
+
+        AssetPreloader(const AssetPreloader&) = delete;
+        AssetPreloader& operator=(const AssetPreloader&) = delete;
+
+        void Start();
+
+        // main thread; uploads decoded models within the time budget, returns true once everything is in the cache
+        bool Update(f32 budget_ms = 8.0f);
+
+        bool IsDone() const { return mStarted && mUploaded == mRequests.size(); }
+        f32 GetProgress() const;
+        usize GetLoadedCount() const { return mUploaded; }
+        usize GetTotalCount() const { return mRequests.size(); }
+        const std::string& GetLastLoaded() const { return mLastLoaded; }
+
+    private:
+        struct Request
+        {
+            std::string Path;
+            VertexFormat Format;
+        };
+
+        void CollectRequests();
+        void AddRequest(const std::string& path, VertexFormat format);
+        void Decode(usize index);
+
+    private:
+        std::vector<Request> mRequests;
+        JobCounter mDecodeJobs;
+        std::atomic<bool> mCancelled{ false };
+        std::atomic<usize> mDecodedCount{ 0 };
+
+        std::mutex mDecodedMutex;
+        std::vector<std::pair<usize, ModelData>> mDecoded;
+
+        usize mUploaded{ 0 };
+        std::string mLastLoaded;
+        bool mStarted{ false };
+    };
+} // namespace RealmFortress
@@ -6,6 +6,7 @@
 
 #include "core/pch.h"
 #include "building.h"
+#include "game/building/production_system.h"
 
 namespace RealmFortress
 {
@@ -14,6 +15,50 @@ namespace RealmFortress
     {
     }
 
+    Building::~Building()
+    {
+        ModelCache::Release(mModel);
+        ProductionSystem::Get().Unregister(mProduction);
+        Scheduler::Get().Cancel(mConstructionTimer);
+    }
+
+    void Building::BeginConstruction(f32 duration, std::function<void()> on_complete)
+    {
+        mConstructionTime = duration;
+        mConstructionTimer = Scheduler::Get().Schedule(duration, [this, on_complete = std::move(on_complete)](TimerHandle, f64)
+        {
+            mConstructionTimer = {};
+            on_complete();
+        });
+    }
+
+    f32 Building::GetConstructionProgress() const
+    {
+        if (!IsUnderConstruction())
+            return 1.0f;
+        if (mConstructionTime <= 0.0f)
+            return 0.0f;
+
+        f64 remaining = Scheduler::Get().GetDueTime(mConstructionTimer) - Scheduler::Get().GetTime();
+        return std::clamp(1.0f - static_cast<f32>(remaining / mConstructionTime), 0.0f, 1.0f);
+    }
+
+    void Building::SetActive(bool active)
+    {
+        mActive = active;
+        if (mProduction.IsValid())
+        {
+            ProductionSystem::Get().SetActive(mProduction, active);
+        }
+    }
+
+    void Building::SetModel(ModelHandle model)
+    {
+        ModelCache::Acquire(model);
+        ModelCache::Release(mModel);
+        mModel = model;
+    }
+
     glm::mat4 Building::GetTransform() const
     {
         glm::mat4 transform = glm::mat4(1.0f);
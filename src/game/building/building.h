@@ -11,7 +11,9 @@
 #include "game/resource/resource.h"
 #include "game/system/coordinate.h"
 #include "../map/map.h"
-#include "renderer/model.h"
+#include "renderer/model_cache.h"
+#include "game/system/scheduler.h"
+#include <limits>
 
 namespace RealmFortress
 {
@@ -35,14 +37,38 @@ namespace RealmFortress
         Count
     };
 
+    enum PlacementRuleFlag : u8
+    {
+        PlacementRuleNone          = 0,
+        PlacementRuleNoDecoration  = BIT(0),
+        PlacementRuleLand          = BIT(1),
+        PlacementRuleRiverside     = BIT(2),
+        PlacementRuleUnique        = BIT(3),
+        PlacementRuleNeedsTownhall = BIT(4),
+    };
+
+    enum class PlacementResult : u8
+    {
+        Valid,
+        NoTile,
+        Occupied,
+        Blocked,
+        Water,
+        NotRiverside,
+        AlreadyBuilt,
+        NeedsTownhall,
+        CannotAfford,
+    };
+
     struct BuildingDefinition
     {
         const char*      Name;
         const char*      Description;
         BuildingCategory Category;
-        ResourceCost     ConstructionCost;
+        ResourceVector   ConstructionCost;
         f32              ConstructionTime;
         const char*      ModelPath;
+        u8               PlacementRules;
     };
 
     inline const BuildingDefinition& GetBuildingDefinition(BuildingType type)
@@ -54,7 +80,8 @@ namespace RealmFortress
                 BuildingCategory::Utility,
                 { { ResourceType::Lumber, 50 }, { ResourceType::Stone, 50 } },
                 10.0f,
-                "assets/objects/buildings/blue/building_townhall_blue.gltf"
+                "assets/objects/buildings/blue/building_townhall_blue.gltf",
+                PlacementRuleNoDecoration | PlacementRuleLand | PlacementRuleUnique
             },
             {
                 "Lumber Mill",
@@ -62,7 +89,8 @@ namespace RealmFortress
                 BuildingCategory::Production,
                 { { ResourceType::Lumber, 10 }, { ResourceType::Stone, 5 } },
                 5.0f,
-                "assets/objects/buildings/blue/building_lumbermill_blue.gltf"
+                "assets/objects/buildings/blue/building_lumbermill_blue.gltf",
+                PlacementRuleNoDecoration | PlacementRuleLand | PlacementRuleNeedsTownhall
             },
             {
                 "Mine",
@@ -70,7 +98,8 @@ namespace RealmFortress
                 BuildingCategory::Production,
                 { { ResourceType::Lumber, 15 }, { ResourceType::Stone, 3 } },
                 8.0f,
-                "assets/objects/buildings/blue/building_mine_blue.gltf"
+                "assets/objects/buildings/blue/building_mine_blue.gltf",
+                PlacementRuleNoDecoration | PlacementRuleLand | PlacementRuleNeedsTownhall
             },
             {
                 "Farm",
@@ -78,12 +107,30 @@ namespace RealmFortress
                 BuildingCategory::Production,
                 { { ResourceType::Lumber, 8 }, { ResourceType::Stone, 2 } },
                 4.0f,
-                "assets/objects/buildings/neutral/building_grain.gltf"
+                "assets/objects/buildings/neutral/building_grain.gltf",
+                PlacementRuleNoDecoration | PlacementRuleLand | PlacementRuleRiverside | PlacementRuleNeedsTownhall
             },
         };
         return definitions[static_cast<size_t>(type)];
     }
 
+    inline const char* PlacementResultToString(PlacementResult result)
+    {
+        switch (result)
+        {
+        case PlacementResult::Valid:         return "Valid";
+        case PlacementResult::NoTile:        return "No tile here";
+        case PlacementResult::Occupied:      return "Tile is occupied";
+        case PlacementResult::Blocked:       return "Tile is blocked";
+        case PlacementResult::Water:         return "Cannot build on water";
+        case PlacementResult::NotRiverside:  return "Must be next to water";
+        case PlacementResult::AlreadyBuilt:  return "Only one can be built";
+        case PlacementResult::NeedsTownhall: return "Build a Town Hall first";
+        case PlacementResult::CannotAfford:  return "Not enough resources";
+        default:                             return "Unknown";
+        }
+    }
+
     inline const char* BuildingCategoryToString(BuildingCategory category)
     {
         switch (category)
@@ -96,36 +143,70 @@ namespace RealmFortress
         }
     }
 
+    // slot of a producer in ProductionSystem, invalid for buildings that don't produce on a timer
+    struct ProductionHandle
+    {
+        static constexpr u32 InvalidId = std::numeric_limits<u32>::max();
+
+        BuildingType Type{ BuildingType::Count };
+        u32 Id{ InvalidId };
+
+        bool IsValid() const { return Id != InvalidId; }
+    };
+
     class Building
     {
     public:
         Building(BuildingType type, const Coordinate& coord);
-        virtual ~Building() = default;
+        virtual ~Building();
 
-        virtual void OnUpdate(Timestep ts) = 0;
+        Building(const Building&) = delete;
+        Building& operator=(const Building&) = delete;
+
+        // producers are simulated by ProductionSystem and leave this empty
+        virtual void OnUpdate(Timestep ts) {}
         virtual void OnInspected() = 0;
         virtual void OnPlaced(const Map& map) = 0;
         virtual void OnDestroyed(const Map& map) = 0;
         virtual void OnMapChanged(const Map& map) = 0;
 
-        virtual bool CanPlace(const Coordinate& coord, const Map& map) const = 0;
 
         const Coordinate& GetCoordinate() const { return mCoord; }
         BuildingType GetType() const { return mType; }
         const BuildingDefinition& GetDefinition() const { return GetBuildingDefinition(mType); }
         BuildingCategory GetCategory() const { return GetDefinition().Category; }
 
-        void SetModel(const Ref<Model>& model) { mModel = model; }
-        Ref<Model> GetModel() const { return mModel; }
+        // holds a cache reference for as long as the building exists
+        void SetModel(ModelHandle model);
+        ModelHandle GetModelHandle() const { return mModel; }
+        Model* GetModel() const { return ModelCache::Get(mModel); }
         glm::mat4 GetTransform() const;
 
         bool IsActive() const { return mActive; }
-        void SetActive(bool active) { mActive = active; }
+        void SetActive(bool active);
+
+        bool IsProducer() const { return mProduction.IsValid(); }
+
+        // OnPlaced runs once construction finishes; until then the building has no effect
+        void BeginConstruction(f32 duration, std::function<void()> on_complete);
+        bool IsUnderConstruction() const { return mConstructionTimer.IsValid(); }
+        f32 GetConstructionProgress() const;
+        ProductionHandle GetProductionHandle() const { return mProduction; }
 
     protected:
         BuildingType mType;
         Coordinate mCoord;
-        Ref<Model> mModel;
+        ModelHandle mModel{ NullModelHandle };
+        ProductionHandle mProduction;
+        TimerHandle mConstructionTimer;
+        f32 mConstructionTime{ 0.0f };
         bool mActive{ true };
+
+    private:
+        friend class BuildingManager;
+
+        // intrusive per-type list maintained by BuildingManager
+        Building* mPrevOfType{ nullptr };
+        Building* mNextOfType{ nullptr };
     };
 } // namespace RealmFortress
@@ -0,0 +1,174 @@
+/**
+ * @file building_dependency_graph.cpp
+ * @brief
+ * @date 12/22/2025
+ */
+
+#include "core/pch.h"
+#include "building_dependency_graph.h"
+#include "game/building/building.h"
+#include "game/map/map.h"
+
+namespace RealmFortress
+{
+    static void EraseSwap(std::vector<Building*>& list, Building* building)
+    {
+        auto found = std::ranges::find(list, building);
+        if (found != list.end())
+        {
+            *found = list.back();
+            list.pop_back();
+        }
+    }
+
+    void BuildingDependencyGraph::Track(Building* building, std::span<const Coordinate> tiles, u8 dependencies)
+    {
+        Unlink(building);
+
+        Node& node = mNodes[building];
+        node.Tiles.assign(tiles.begin(), tiles.end());
+        node.Dependencies = dependencies;
+
+        for (const Coordinate& tile : node.Tiles)
+        {
+            mTileDependents[tile].push_back(building);
+        }
+
+        for (usize bit = 0; bit < BUILDING_DEPENDENCY_COUNT; bit++)
+        {
+            if (dependencies & BIT(bit))
+            {
+                mDependents[bit].push_back(building);
+            }
+        }
+    }
+
+    void BuildingDependencyGraph::Untrack(Building* building)
+    {
+        auto it = mNodes.find(building);
+        if (it == mNodes.end())
+            return;
+
+        if (it->second.Dirty)
+        {
+            EraseSwap(mDirty, building);
+        }
+
+        Unlink(building);
+        mNodes.erase(building);
+    }
+
+    void BuildingDependencyGraph::Clear()
+    {
+        mNodes.clear();
+        mTileDependents.clear();
+        for (auto& dependents : mDependents)
+        {
+            dependents.clear();
+        }
+        mDirty.clear();
+    }
+
+    void BuildingDependencyGraph::InvalidateTile(const Coordinate& coord)
+    {
+        auto it = mTileDependents.find(coord);
+        if (it == mTileDependents.end())
+            return;
+
+        for (Building* building : it->second)
+        {
+            MarkDirty(building);
+        }
+    }
+
+    void BuildingDependencyGraph::InvalidateChunk(ChunkCoordinate chunk)
+    {
+        if (mTileDependents.empty())
+            return;
+
+        for (i32 q = 0; q < CHUNK_SIZE; q++)
+        {
+            for (i32 r = 0; r < CHUNK_SIZE; r++)
+            {
+                InvalidateTile(Coordinate(chunk.Q * CHUNK_SIZE + q, chunk.R * CHUNK_SIZE + r));
+            }
+        }
+    }
+
+    void BuildingDependencyGraph::Invalidate(u8 dependencies)
+    {
+        for (usize bit = 0; bit < BUILDING_DEPENDENCY_COUNT; bit++)
+        {
+            if (!(dependencies & BIT(bit)))
+                continue;
+
+            for (Building* building : mDependents[bit])
+            {
+                MarkDirty(building);
+            }
+        }
+    }
+
+    void BuildingDependencyGraph::Flush(const Map& map)
+    {
+        if (mDirty.empty())
+            return;
+
+        // a recompute may invalidate further buildings, those land in mDirty for the next flush
+        std::swap(mDirty, mFlushing);
+
+        for (Building* building : mFlushing)
+        {
+            mNodes[building].Dirty = false;
+        }
+
+        for (Building* building : mFlushing)
+        {
+            building->OnMapChanged(map);
+            mRecomputeCount++;
+        }
+
+        mFlushing.clear();
+    }
+
+    void BuildingDependencyGraph::MarkDirty(Building* building)
+    {
+        Node& node = mNodes[building];
+        if (!node.Dirty)
+        {
+            node.Dirty = true;
+            mDirty.push_back(building);
+        }
+    }
+
+    void BuildingDependencyGraph::Unlink(Building* building)
+    {
+        auto it = mNodes.find(building);
+        if (it == mNodes.end())
+            return;
+
+        for (const Coordinate& tile : it->second.Tiles)
+        {
+            auto dependents = mTileDependents.find(tile);
+            if (dependents == mTileDependents.end())
+                continue;
+
+            EraseSwap(dependents->second, building);
+            if (dependents->second.empty())
+            {
+                mTileDependents.erase(dependents);
+            }
+        }
+
+        for (usize bit = 0; bit < BUILDING_DEPENDENCY_COUNT; bit++)
+        {
+            if (it->second.Dependencies & BIT(bit))
+            {
+                EraseSwap(mDependents[bit], building);
+            }
+        }
+
+        it->second.Tiles.clear();
+        it->second.Dependencies = BuildingDependencyNone;
+    }
+} // namespace RealmFortress
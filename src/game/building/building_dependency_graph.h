@@ -0,0 +1,78 @@
+/**
+ * @file building_dependency_graph.h
+ * @brief
+ * @date 12/22/2025
+ */
+
+#pragma once
+
+#include "core/base.h"
+#include "game/system/coordinate.h"
+#include "game/map/chunk.h"
+#include <array>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace RealmFortress
+{
+    class Building;
+    class Map;
+
+    // global states a building's efficiency can depend on, besides individual tiles
+    enum BuildingDependencyFlag : u8
+    {
+        BuildingDependencyNone       = 0,
+        BuildingDependencyTownhall   = BIT(0), // a townhall was built or removed
+        BuildingDependencyStarvation = BIT(1), // the townhall started or stopped starving
+    };
+
+    constexpr usize BUILDING_DEPENDENCY_COUNT = 2;
+
+    /**
+     * @class BuildingDependencyGraph
+     * @brief Records which tiles and global states each building's derived values depend on.
+     *
+     * Invalidating a tile or a global state marks only the buildings that depend on it as
+     * dirty; Flush then calls OnMapChanged on each of them once, however many of their
+     * inputs changed in between.
+     */
+    class BuildingDependencyGraph
+    {
+    public:
+        // replaces whatever the building was tracked with before
+        void Track(Building* building, std::span<const Coordinate> tiles, u8 dependencies);
+        void Untrack(Building* building);
+        void Clear();
+
+        void InvalidateTile(const Coordinate& coord);
+        void InvalidateChunk(ChunkCoordinate chunk);
+        void Invalidate(u8 dependencies);
+
+        void Flush(const Map& map);
+
+        usize GetTrackedCount() const { return mNodes.size(); }
+        usize GetDirtyCount() const { return mDirty.size(); }
+        u64 GetRecomputeCount() const { return mRecomputeCount; }
+
+    private:
+        void MarkDirty(Building* building);
+        void Unlink(Building* building);
+
+    private:
+        struct Node
+        {
+            std::vector<Coordinate> Tiles;
+            u8 Dependencies{ BuildingDependencyNone };
+            bool Dirty{ false };
+        };
+
+        std::unordered_map<Building*, Node> mNodes;
+        std::unordered_map<Coordinate, std::vector<Building*>> mTileDependents;
+        std::array<std::vector<Building*>, BUILDING_DEPENDENCY_COUNT> mDependents;
+
+        std::vector<Building*> mDirty;
+        std::vector<Building*> mFlushing;
+        u64 mRecomputeCount{ 0 };
+    };
+} // namespace RealmFortress
@@ -6,69 +6,116 @@
 
 #include "core/pch.h"
 #include "building_manager.h"
+#include "core/memory_tracker.h"
+#include "core/profiler.h"
 #include "renderer/model_cache.h"
 #include "game/building/townhall.h"
 #include "game/building/mine.h"
 #include "game/building/lumbermill.h"
 #include "game/building/farm.h"
+#include "game/building/production_system.h"
 #include "game/resource/warehouse.h"
+#include "game/system/resource_telemetry.h"
 
 namespace RealmFortress
 {
     void BuildingManager::OnUpdate(Timestep ts)
     {
-        for (auto& building : mBuildings)
+        RF_PROFILE_SCOPE("BuildingManager::OnUpdate");
+
+        for (Building* building : mUpdatedBuildings)
         {
-            if (building && building->IsActive())
+            if (building->IsActive())
             {
                 building->OnUpdate(ts);
             }
         }
     }
 
-    bool BuildingManager::CanPlaceBuilding(BuildingType type, const Coordinate& coord, const Map& map) const
+    PlacementResult BuildingManager::CheckPlacement(BuildingType type, const Coordinate& coord, const Map& map) const
     {
-        if (!map.HasTile(coord)) return false;
-        if (GetBuildingAt(coord) != nullptr) return false;
+        PlacementResult result = CheckGlobalPlacement(type);
+        if (result != PlacementResult::Valid)
+            return result;
 
-        i32 townhall_count = GetBuildingCount(BuildingType::Townhall);
+        return CheckTilePlacement(GetBuildingDefinition(type).PlacementRules, coord, map);
+    }
+
+    void BuildingManager::CheckPlacement(BuildingType type, std::span<const Coordinate> coords, const Map& map, std::span<PlacementResult> out_results) const
+    {
+        RF_CORE_ASSERT(out_results.size() >= coords.size(), "Result span is too small");
 
-        if (type == BuildingType::Townhall)
+        // the rules that don't depend on the tile are the same for the whole batch
+        PlacementResult global = CheckGlobalPlacement(type);
+        if (global != PlacementResult::Valid)
         {
-            if (townhall_count > 0)
-            {
-                RF_CORE_WARN("Cannot build more than one Town Hall!");
-                return false;
-            }
+            std::fill_n(out_results.begin(), coords.size(), global);
+            return;
         }
-        else
+
+        u8 rules = GetBuildingDefinition(type).PlacementRules;
+        for (usize i = 0; i < coords.size(); i++)
         {
-            if (townhall_count == 0)
-            {
-                RF_CORE_WARN("Must build Town Hall first!");
-                return false;
-            }
+            out_results[i] = CheckTilePlacement(rules, coords[i], map);
         }
+    }
+
+    bool BuildingManager::CanPlaceBuilding(BuildingType type, const Coordinate& coord, const Map& map) const
+    {
+        return CheckPlacement(type, coord, map) == PlacementResult::Valid;
+    }
 
+    PlacementResult BuildingManager::CheckGlobalPlacement(BuildingType type) const
+    {
         const auto& definition = GetBuildingDefinition(type);
+        i32 townhall_count = GetBuildingCount(BuildingType::Townhall);
+
+        if ((definition.PlacementRules & PlacementRuleUnique) && GetBuildingCount(type) + GetConstructionCount(type) > 0)
+            return PlacementResult::AlreadyBuilt;
+        if ((definition.PlacementRules & PlacementRuleNeedsTownhall) && townhall_count == 0)
+            return PlacementResult::NeedsTownhall;
         if (!Warehouse::Get().Has(definition.ConstructionCost))
-        {
-            return false;
-        }
+            return PlacementResult::CannotAfford;
 
-        auto temp_building = const_cast<BuildingManager*>(this)->CreateBuilding(type, coord);
-        if (!temp_building)
+        return PlacementResult::Valid;
+    }
+
+    PlacementResult BuildingManager::CheckTilePlacement(u8 rules, const Coordinate& coord, const Map& map) const
+    {
+        const Tile* tile = map.GetTile(coord);
+        if (!tile)
+            return PlacementResult::NoTile;
+        if (mCoordinateMap.contains(coord))
+            return PlacementResult::Occupied;
+        if ((rules & PlacementRuleNoDecoration) && tile->GetDecoration() != DecorationType::None)
+            return PlacementResult::Blocked;
+        if ((rules & PlacementRuleLand) && tile->IsWater())
+            return PlacementResult::Water;
+
+        if (rules & PlacementRuleRiverside)
         {
-            return false;
+            bool riverside = false;
+            for (u8 dir = 0; dir < static_cast<u8>(Direction::Count) && !riverside; dir++)
+            {
+                const Tile* neighbor = map.GetTile(coord.GetNeighbor(static_cast<Direction>(dir)));
+                riverside = neighbor && neighbor->IsWater();
+            }
+
+            if (!riverside)
+                return PlacementResult::NotRiverside;
         }
 
-        return temp_building->CanPlace(coord, map);
+        return PlacementResult::Valid;
     }
 
     bool BuildingManager::PlaceBuilding(BuildingType type, const Coordinate& coord, const Map& map)
     {
-        if (!CanPlaceBuilding(type, coord, map))
+        RF_MEMORY_TAG(MemoryTag::Buildings);
+
+        PlacementResult placement = CheckPlacement(type, coord, map);
+        if (placement != PlacementResult::Valid)
         {
+            RF_CORE_WARN_RATE_LIMITED("Cannot place {}: {}", GetBuildingDefinition(type).Name, PlacementResultToString(placement));
             return false;
         }
 
@@ -86,6 +133,9 @@ namespace RealmFortress
             return false;
         }
 
+        // charged to the building being placed
+        ResourceTelemetry::Get().Record(type, ResourceFlow::Consumed, definition.ConstructionCost);
+
         auto model = ModelCache::Load(definition.ModelPath);
         if (model)
         {
@@ -96,7 +146,15 @@ namespace RealmFortress
             RF_CORE_WARN("Failed to load model for {}: {}", definition.Name, definition.ModelPath);
         }
 
-        building->OnPlaced(map);
+        Building* placed = building.get();
+        const Map* placed_map = &map;
+        placed->BeginConstruction(definition.ConstructionTime, [this, placed, placed_map]()
+        {
+            FinishConstruction(placed, *placed_map);
+        });
+
+        mConstructionCounts[static_cast<usize>(type)]++;
+        mSpatialIndex.Insert(placed);
 
         mCoordinateMap[coord] = mBuildings.size();
         mBuildings.push_back(std::move(building));
@@ -119,9 +177,22 @@ namespace RealmFortress
             return false;
         }
 
-        if (mBuildings[index])
+        if (Building* building = mBuildings[index].get())
         {
-            mBuildings[index]->OnDestroyed(map);
+            // a building still under construction never ran OnPlaced and isn't linked yet, so there is nothing to undo
+            if (building->IsUnderConstruction())
+            {
+                mConstructionCounts[static_cast<usize>(building->GetType())]--;
+            }
+            else
+            {
+                building->OnDestroyed(map);
+                std::erase(mUpdatedBuildings, building);
+                UnlinkType(building);
+            }
+
+            mSpatialIndex.Remove(building);
+            mDependencies.Untrack(building);
         }
 
         if (index != mBuildings.size() - 1)
@@ -156,61 +227,109 @@ namespace RealmFortress
         return mBuildings[index].get();
     }
 
-    std::vector<Building*> BuildingManager::GetBuildingsByType(BuildingType type) const
+    FrameVector<Building*> BuildingManager::GetBuildingsByType(BuildingType type) const
     {
-        std::vector<Building*> result;
-        result.reserve(mBuildings.size() / 4);
+        const TypeList& list = mTypeLists[static_cast<usize>(type)];
 
-        for (const auto& building : mBuildings)
+        auto result = MakeFrameVector<Building*>(static_cast<usize>(list.Count));
+
+        for (Building* building = list.Head; building; building = building->mNextOfType)
         {
-            if (building && building->GetType() == type)
-            {
-                result.push_back(building.get());
-            }
+            result.push_back(building);
         }
 
         return result;
     }
 
-    i32 BuildingManager::GetBuildingCount(BuildingType type) const
+    void BuildingManager::GetBuildingsByType(BuildingType type, std::vector<Building*>& out) const
     {
-        i32 count = 0;
-        for (const auto& building : mBuildings)
+        const TypeList& list = mTypeLists[static_cast<usize>(type)];
+
+        out.reserve(out.size() + static_cast<usize>(list.Count));
+        for (Building* building = list.Head; building; building = building->mNextOfType)
         {
-            if (building && building->GetType() == type)
-            {
-                count++;
-            }
+            out.push_back(building);
         }
-        return count;
     }
 
     std::vector<Building*> BuildingManager::GetBuildingsInRadius(const Coordinate& center, i32 radius) const
     {
         std::vector<Building*> result;
+        GetBuildingsInRadius(center, radius, result);
+        return result;
+    }
 
-        for (const auto& building : mBuildings)
-        {
-            if (!building) continue;
-
-            const Coordinate& building_coord = building->GetCoordinate();
-            i32 dist = center.DistanceTo(building_coord);
-
-            if (dist <= radius)
-            {
-                result.push_back(building.get());
-            }
-        }
+    void BuildingManager::GetBuildingsInRadius(const Coordinate& center, i32 radius, std::vector<Building*>& out) const
+    {
+        mSpatialIndex.QueryRadius(center, radius, out);
+    }
 
-        return result;
+    void BuildingManager::TrackDependencies(Building* building, std::span<const Coordinate> tiles, u8 dependencies)
+    {
+        mDependencies.Track(building, tiles, dependencies);
     }
 
     void BuildingManager::Clear()
     {
+        mTypeLists = {};
+        mConstructionCounts = {};
+        mSpatialIndex.Clear();
+        mDependencies.Clear();
+        mUpdatedBuildings.clear();
         mBuildings.clear();
+        ProductionSystem::Get().Clear();
         mCoordinateMap.clear();
     }
 
+    void BuildingManager::FinishConstruction(Building* building, const Map& map)
+    {
+        // only linked by type once finished, so nothing counts or finds a building that isn't working yet
+        mConstructionCounts[static_cast<usize>(building->GetType())]--;
+        LinkType(building);
+
+        building->OnPlaced(map);
+
+        if (!building->IsProducer())
+        {
+            mUpdatedBuildings.push_back(building);
+        }
+    }
+
+    void BuildingManager::LinkType(Building* building)
+    {
+        TypeList& list = mTypeLists[static_cast<usize>(building->GetType())];
+
+        building->mPrevOfType = list.Tail;
+        building->mNextOfType = nullptr;
+
+        if (list.Tail)
+            list.Tail->mNextOfType = building;
+        else
+            list.Head = building;
+
+        list.Tail = building;
+        list.Count++;
+    }
+
+    void BuildingManager::UnlinkType(Building* building)
+    {
+        TypeList& list = mTypeLists[static_cast<usize>(building->GetType())];
+
+        if (building->mPrevOfType)
+            building->mPrevOfType->mNextOfType = building->mNextOfType;
+        else
+            list.Head = building->mNextOfType;
+
+        if (building->mNextOfType)
+            building->mNextOfType->mPrevOfType = building->mPrevOfType;
+        else
+            list.Tail = building->mPrevOfType;
+
+        building->mPrevOfType = nullptr;
+        building->mNextOfType = nullptr;
+        list.Count--;
+    }
+
     Scope<Building> BuildingManager::CreateBuilding(BuildingType type, const Coordinate& coord)
     {
         switch (type)
@@ -6,7 +6,12 @@
 
 #pragma once
 
+#include "core/frame_allocator.h"
 #include "game/building/building.h"
+#include "game/building/building_spatial_index.h"
+#include "game/building/building_dependency_graph.h"
+#include <array>
+#include <span>
 
 namespace RealmFortress
 {
@@ -24,6 +29,9 @@ namespace RealmFortress
 
         void OnUpdate(Timestep ts);
 
+        // table-driven and allocation-free, safe to call every frame
+        PlacementResult CheckPlacement(BuildingType type, const Coordinate& coord, const Map& map) const;
+        void CheckPlacement(BuildingType type, std::span<const Coordinate> coords, const Map& map, std::span<PlacementResult> out_results) const;
         bool CanPlaceBuilding(BuildingType type, const Coordinate& coord, const Map& map) const;
         bool PlaceBuilding(BuildingType type, const Coordinate& coord, const Map& map);
         bool RemoveBuilding(const Coordinate& coord, const Map& map);
@@ -31,10 +39,25 @@ namespace RealmFortress
         Building* GetBuildingAt(const Coordinate& coord) const;
         const std::vector<Scope<Building>>& GetAllBuildings() const { return mBuildings; }
 
-        std::vector<Building*> GetBuildingsByType(BuildingType type) const;
-        i32 GetBuildingCount(BuildingType type) const;
+        // finished buildings only, those under construction are counted by GetConstructionCount
+        // the vector is frame-allocated, valid until the next Renderer::BeginFrame; to keep the
+        // list longer, append it to a caller-owned vector with the overload
+        FrameVector<Building*> GetBuildingsByType(BuildingType type) const;
+        void GetBuildingsByType(BuildingType type, std::vector<Building*>& out) const;
+        Building* GetFirstBuildingOfType(BuildingType type) const { return mTypeLists[static_cast<usize>(type)].Head; }
+        i32 GetBuildingCount(BuildingType type) const { return mTypeLists[static_cast<usize>(type)].Count; }
+        i32 GetConstructionCount(BuildingType type) const { return mConstructionCounts[static_cast<usize>(type)]; }
 
         std::vector<Building*> GetBuildingsInRadius(const Coordinate& center, i32 radius) const;
+        void GetBuildingsInRadius(const Coordinate& center, i32 radius, std::vector<Building*>& out) const;
+
+        // buildings recompute their efficiency only when something they track changes
+        void TrackDependencies(Building* building, std::span<const Coordinate> tiles, u8 dependencies);
+        void InvalidateTile(const Coordinate& coord) { mDependencies.InvalidateTile(coord); }
+        void InvalidateChunk(ChunkCoordinate chunk) { mDependencies.InvalidateChunk(chunk); }
+        void InvalidateDependency(u8 dependencies) { mDependencies.Invalidate(dependencies); }
+        void UpdateDependencies(const Map& map) { mDependencies.Flush(map); }
+        const BuildingDependencyGraph& GetDependencyGraph() const { return mDependencies; }
 
         void Clear();
 
@@ -42,10 +65,32 @@ namespace RealmFortress
         BuildingManager() = default;
 
         Scope<Building> CreateBuilding(BuildingType type, const Coordinate& coord);
+        void FinishConstruction(Building* building, const Map& map);
+
+        PlacementResult CheckGlobalPlacement(BuildingType type) const;
+        PlacementResult CheckTilePlacement(u8 rules, const Coordinate& coord, const Map& map) const;
+
+        void LinkType(Building* building);
+        void UnlinkType(Building* building);
 
     private:
         std::vector<Scope<Building>> mBuildings;
 
+        // buildings with their own OnUpdate, producers tick in ProductionSystem instead
+        std::vector<Building*> mUpdatedBuildings;
+
         std::unordered_map<Coordinate, usize> mCoordinateMap;
+
+        struct TypeList
+        {
+            Building* Head{ nullptr };
+            Building* Tail{ nullptr };
+            i32 Count{ 0 };
+        };
+
+        std::array<TypeList, static_cast<usize>(BuildingType::Count)> mTypeLists;
+        std::array<i32, static_cast<usize>(BuildingType::Count)> mConstructionCounts{};
+        BuildingSpatialIndex mSpatialIndex;
+        BuildingDependencyGraph mDependencies;
     };
 } // namespace RealmFortress
@@ -0,0 +1,78 @@
+/**
+ * @file building_spatial_index.cpp
+ * @brief
+ * @date 12/22/2025
+ */
+
+#include "core/pch.h"
+#include "building_spatial_index.h"
+#include "game/building/building.h"
+
+namespace RealmFortress
+{
+    void BuildingSpatialIndex::Insert(Building* building)
+    {
+        mBuckets[ToBucket(building->GetCoordinate())].push_back(building);
+    }
+
+    void BuildingSpatialIndex::Remove(Building* building)
+    {
+        auto it = mBuckets.find(ToBucket(building->GetCoordinate()));
+        if (it == mBuckets.end())
+            return;
+
+        auto& bucket = it->second;
+        auto found = std::ranges::find(bucket, building);
+        if (found != bucket.end())
+        {
+            *found = bucket.back();
+            bucket.pop_back();
+        }
+
+        if (bucket.empty())
+        {
+            mBuckets.erase(it);
+        }
+    }
+
+    void BuildingSpatialIndex::Clear()
+    {
+        mBuckets.clear();
+    }
+
+    void BuildingSpatialIndex::QueryRadius(const Coordinate& center, i32 radius, std::vector<Building*>& out) const
+    {
+        // every hex within the radius lies inside this axial box
+        ChunkCoordinate min_bucket = ToBucket(Coordinate(center.Q - radius, center.R - radius));
+        ChunkCoordinate max_bucket = ToBucket(Coordinate(center.Q + radius, center.R + radius));
+
+        for (i32 bq = min_bucket.Q; bq <= max_bucket.Q; bq++)
+        {
+            for (i32 br = min_bucket.R; br <= max_bucket.R; br++)
+            {
+                auto it = mBuckets.find({ bq, br });
+                if (it == mBuckets.end())
+                    continue;
+
+                for (Building* building : it->second)
+                {
+                    if (center.DistanceTo(building->GetCoordinate()) <= radius)
+                    {
+                        out.push_back(building);
+                    }
+                }
+            }
+        }
+    }
+
+    i32 BuildingSpatialIndex::FloorDiv(i32 value, i32 divisor)
+    {
+        i32 quotient = value / divisor;
+        return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+    }
+
+    ChunkCoordinate BuildingSpatialIndex::ToBucket(const Coordinate& coord)
+    {
+        return { FloorDiv(coord.Q, CHUNK_SIZE), FloorDiv(coord.R, CHUNK_SIZE) };
+    }
+} // namespace RealmFortress
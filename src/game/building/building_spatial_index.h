@@ -0,0 +1,43 @@
+/**
+ * @file building_spatial_index.h
+ * @brief
+ * @date 12/22/2025
+ */
+
+#pragma once
+
+#include "core/base.h"
+#include "game/system/coordinate.h"
+#include "game/map/chunk.h"
+#include <unordered_map>
+#include <vector>
+
+namespace RealmFortress
+{
+    class Building;
+
+    /**
+     * @class BuildingSpatialIndex
+     * @brief Buckets buildings by the map chunk their tile falls in.
+     *
+     * A radius query walks only the buckets overlapping the query's bounding box in axial
+     * coordinates and then filters by hex distance, instead of measuring every building.
+     */
+    class BuildingSpatialIndex
+    {
+    public:
+        void Insert(Building* building);
+        void Remove(Building* building);
+        void Clear();
+
+        // appends to out, results are in no particular order
+        void QueryRadius(const Coordinate& center, i32 radius, std::vector<Building*>& out) const;
+
+    private:
+        static i32 FloorDiv(i32 value, i32 divisor);
+        static ChunkCoordinate ToBucket(const Coordinate& coord);
+
+    private:
+        std::unordered_map<ChunkCoordinate, std::vector<Building*>, ChunkCoordHash> mBuckets;
+    };
+} // namespace RealmFortress
@@ -17,18 +17,13 @@ namespace RealmFortress
     public:
         Farm(const Coordinate& coordinate);
 
-        void OnUpdate(Timestep ts) override;
         void OnInspected() override;
         void OnPlaced(const Map& map) override;
         void OnDestroyed(const Map& map) override;
         void OnMapChanged(const Map& map) override;
 
-        bool CanPlace(const Coordinate& coord, const Map& map) const override;
-
     private:
-        f32 mTime;
-        f32 mCycleTime;
-
-        // TODO: implement own buffer
+        static constexpr f32 CycleTime = 12.0f;
+        static constexpr i32 WheatPerCycle = 10;
     };
 } // namespace RealmFortress
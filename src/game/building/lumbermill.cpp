@@ -9,55 +9,51 @@
 #include "game/resource/warehouse.h"
 #include "game/building/building_manager.h"
 #include "game/building/townhall.h"
+#include "game/building/production_system.h"
 #include <imgui.h>
 
 namespace RealmFortress
 {
     Lumbermill::Lumbermill(const Coordinate& coordinate)
         : Building(BuildingType::LumberMill, coordinate)
-        , mTime(0.0f), mBaseCycleTime(10.0f), mEfficiency(1.0f), mProgress(0.0f)
     {
     }
 
-    void Lumbermill::OnUpdate(Timestep ts)
-    {
-        mTime += ts;
-
-        if (mEfficiency == 0) return;
-
-        f32 actual_cycle_time = mBaseCycleTime / mEfficiency;
-
-        mProgress = std::clamp(mTime / actual_cycle_time, 0.0f, 1.0f);
-
-        if (mTime >= actual_cycle_time)
-        {
-            mTime -= actual_cycle_time;
-            Warehouse::Get().Add(ResourceType::Lumber, 1);
-        }
-    }
-
     void Lumbermill::OnInspected()
     {
+        f32 efficiency = ProductionSystem::Get().GetEfficiency(mProduction);
+        f32 progress = ProductionSystem::Get().GetProgress(mProduction);
+
         // Efficiency Stats
-        ImVec4 efficiency_color = (mEfficiency >= 1.0f) ? ImVec4(0, 1, 0, 1) : ImVec4(1, 0, 0, 1);
+        ImVec4 efficiency_color = (efficiency >= 1.0f) ? ImVec4(0, 1, 0, 1) : ImVec4(1, 0, 0, 1);
 
         ImGui::Text("Efficiency:");
         ImGui::SameLine();
-        ImGui::TextColored(efficiency_color, "%.0f%%", mEfficiency * 100.0f);
+        ImGui::TextColored(efficiency_color, "%.0f%%", efficiency * 100.0f);
 
         ImGui::Text("Progress");
         char overlay[32];
-        sprintf(overlay, "%.0f%%", mProgress * 100.0f);
-        ImGui::ProgressBar(mProgress, ImVec2(-1, 0), overlay);
+        sprintf(overlay, "%.0f%%", progress * 100.0f);
+        ImGui::ProgressBar(progress, ImVec2(-1, 0), overlay);
     }
 
     void Lumbermill::OnPlaced(const Map& map)
     {
+        mProduction = ProductionSystem::Get().Register(mType, ResourceType::Lumber, 1, BaseCycleTime);
+
+        std::array<Coordinate, static_cast<usize>(Direction::Count)> neighbors;
+        for (u8 dir = 0; dir < static_cast<u8>(Direction::Count); dir++)
+        {
+            neighbors[dir] = mCoord.GetNeighbor(static_cast<Direction>(dir));
+        }
+        BuildingManager::Get().TrackDependencies(this, neighbors, BuildingDependencyTownhall | BuildingDependencyStarvation);
+
         UpdateEfficiency(map);
     }
 
     void Lumbermill::OnDestroyed(const Map& map)
     {
+        ProductionSystem::Get().Unregister(mProduction);
     }
 
     void Lumbermill::OnMapChanged(const Map& map)
@@ -65,32 +61,22 @@ namespace RealmFortress
         UpdateEfficiency(map);
     }
 
-    bool Lumbermill::CanPlace(const Coordinate& coord, const Map& map) const
-    {
-        auto tile = map.GetTile(coord);
-        if (tile->GetDecoration() != DecorationType::None) return false;
-        if (tile->GetType() == TileType::Water) return false;
-
-        return true;
-    }
-
     void Lumbermill::UpdateEfficiency(const Map& map)
     {
         f32 resource_factor = 1.0f + CalculateResourceBonus(map);
 
         f32 townhall_factor = 1.0f;
 
-        auto townhalls = BuildingManager::Get().GetBuildingsByType(BuildingType::Townhall);
-        RF_CORE_ASSERT(townhalls.size() == 1, "Only one townhall!");
+        auto& building_manager = BuildingManager::Get();
+        RF_CORE_ASSERT(building_manager.GetBuildingCount(BuildingType::Townhall) == 1, "Only one townhall!");
 
-        if (townhalls.empty())
+        auto townhall = static_cast<Townhall*>(building_manager.GetFirstBuildingOfType(BuildingType::Townhall));
+        if (!townhall)
         {
             townhall_factor = 0.1f;
         }
         else
         {
-            auto townhall = static_cast<Townhall*>(townhalls.front());
-
             if (townhall->IsStarving())
             {
                 townhall_factor = 0.2f;
@@ -102,15 +88,18 @@ namespace RealmFortress
             }
         }
 
-        mEfficiency = resource_factor * townhall_factor;
+        ProductionSystem::Get().SetEfficiency(mProduction, resource_factor * townhall_factor);
     }
 
     f32 Lumbermill::CalculateResourceBonus(const Map& map)
     {
         i32 forest_count = 0;
-        auto neighbors = map.GetNeighbors(mCoord);
-        for (const auto& neighbor : neighbors)
+        for (u8 dir = 0; dir < static_cast<u8>(Direction::Count); dir++)
         {
+            const Tile* neighbor = map.GetTile(mCoord.GetNeighbor(static_cast<Direction>(dir)));
+            if (!neighbor)
+                continue;
+
             if (neighbor->GetDecoration() == DecorationType::TreeSmall  ||
                 neighbor->GetDecoration() == DecorationType::TreeMedium ||
                 neighbor->GetDecoration() == DecorationType::TreeLarge)
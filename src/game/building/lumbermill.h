@@ -17,25 +17,17 @@ namespace RealmFortress
     public:
         Lumbermill(const Coordinate& coordinate);
 
-        void OnUpdate(Timestep ts) override;
         void OnInspected() override;
         void OnPlaced(const Map& map) override;
         void OnDestroyed(const Map& map) override;
         void OnMapChanged(const Map& map) override;
 
-        bool CanPlace(const Coordinate& coord, const Map& map) const override;
-
     private:
         void UpdateEfficiency(const Map& map);
         f32 CalculateResourceBonus(const Map& map);
 
     private:
-        f32 mTime;
-        f32 mBaseCycleTime;
-        f32 mEfficiency;
-        f32 mProgress;
-
-        // TODO: implement own buffer
+        static constexpr f32 BaseCycleTime = 10.0f;
     };
 } // namespace RealmFortress
 
@@ -0,0 +1,467 @@
+/**
+ * @file production_system.cpp
+ * @brief
+ * @date 12/22/2025
+ */
+
+#include "core/pch.h"
+#include "production_system.h"
+#include "game/resource/warehouse.h"
+#include "game/system/resource_telemetry.h"
+#include "core/job_system.h"
+
+namespace RealmFortress
+{
+    ProductionHandle ProductionSystem::Register(BuildingType type, ResourceType output, i32 output_amount, f32 cycle_time)
+    {
+        Batch& batch = GetBatch(type);
+        RF_CORE_ASSERT(batch.Ids.empty() || batch.Output == output, "Producers of one type must share an output");
+        batch.Output = output;
+        batch.OutputAmount = output_amount;
+
+        u32 id;
+        if (!batch.FreeIds.empty())
+        {
+            id = batch.FreeIds.back();
+            batch.FreeIds.pop_back();
+        }
+        else
+        {
+            id = static_cast<u32>(batch.DenseIndices.size());
+            batch.DenseIndices.push_back(0);
+        }
+
+        batch.DenseIndices[id] = static_cast<u32>(batch.Ids.size());
+        batch.CycleTimes.push_back(cycle_time);
+        batch.Efficiencies.push_back(1.0f);
+        batch.Progress.push_back(0.0f);
+        batch.ProgressTimes.push_back(Scheduler::Get().GetTime());
+        batch.Active.push_back(1);
+        batch.Timers.push_back({});
+        batch.Sequences.push_back(0);
+        batch.Ids.push_back(id);
+
+        Restart(type, batch.Ids.size() - 1);
+
+        return { type, id };
+    }
+
+    void ProductionSystem::Unregister(ProductionHandle& handle)
+    {
+        if (!handle.IsValid())
+            return;
+
+        Batch& batch = GetBatch(handle.Type);
+        usize index;
+        if (!Resolve(batch, handle, index))
+            return;
+
+        Scheduler::Get().Cancel(batch.Timers[index]);
+
+        usize last = batch.Ids.size() - 1;
+        if (index != last)
+        {
+            batch.CycleTimes[index] = batch.CycleTimes[last];
+            batch.Efficiencies[index] = batch.Efficiencies[last];
+            batch.Progress[index] = batch.Progress[last];
+            batch.ProgressTimes[index] = batch.ProgressTimes[last];
+            batch.Active[index] = batch.Active[last];
+            batch.Timers[index] = batch.Timers[last];
+            batch.Sequences[index] = batch.Sequences[last];
+            batch.Ids[index] = batch.Ids[last];
+            batch.DenseIndices[batch.Ids[index]] = static_cast<u32>(index);
+        }
+
+        batch.CycleTimes.pop_back();
+        batch.Efficiencies.pop_back();
+        batch.Progress.pop_back();
+        batch.ProgressTimes.pop_back();
+        batch.Active.pop_back();
+        batch.Timers.pop_back();
+        batch.Sequences.pop_back();
+        batch.Ids.pop_back();
+
+        batch.DenseIndices[handle.Id] = ProductionHandle::InvalidId;
+        batch.FreeIds.push_back(handle.Id);
+        handle = {};
+    }
+
+    void ProductionSystem::SetEfficiency(ProductionHandle handle, f32 efficiency)
+    {
+        Batch& batch = GetBatch(handle.Type);
+        usize index;
+        if (!Resolve(batch, handle, index) || batch.Efficiencies[index] == efficiency)
+            return;
+
+        batch.Progress[index] = GetCurrentProgress(batch, index);
+        batch.ProgressTimes[index] = Scheduler::Get().GetTime();
+        batch.Efficiencies[index] = efficiency;
+        Restart(handle.Type, index);
+    }
+
+    void ProductionSystem::SetActive(ProductionHandle handle, bool active)
+    {
+        Batch& batch = GetBatch(handle.Type);
+        usize index;
+        if (!Resolve(batch, handle, index) || (batch.Active[index] != 0) == active)
+            return;
+
+        batch.Progress[index] = GetCurrentProgress(batch, index);
+        batch.ProgressTimes[index] = Scheduler::Get().GetTime();
+        batch.Active[index] = active ? 1 : 0;
+        Restart(handle.Type, index);
+    }
+
+    f32 ProductionSystem::GetEfficiency(ProductionHandle handle) const
+    {
+        const Batch& batch = GetBatch(handle.Type);
+        usize index;
+        return Resolve(batch, handle, index) ? batch.Efficiencies[index] : 0.0f;
+    }
+
+    f32 ProductionSystem::GetProgress(ProductionHandle handle) const
+    {
+        const Batch& batch = GetBatch(handle.Type);
+        usize index;
+        return Resolve(batch, handle, index) ? GetCurrentProgress(batch, index) : 0.0f;
+    }
+
+    f32 ProductionSystem::GetCycleTime(ProductionHandle handle) const
+    {
+        const Batch& batch = GetBatch(handle.Type);
+        usize index;
+        return Resolve(batch, handle, index) ? batch.CycleTimes[index] : 0.0f;
+    }
+
+    usize ProductionSystem::GetProducerCount() const
+    {
+        usize count = 0;
+        for (const auto& batch : mBatches)
+        {
+            count += batch.Ids.size();
+        }
+        return count;
+    }
+
+    usize ProductionSystem::GetProducerCount(BuildingType type) const
+    {
+        return GetBatch(type).Ids.size();
+    }
+
+    void ProductionSystem::Suspend()
+    {
+        if (mSuspended)
+            return;
+
+        mSuspended = true;
+        for (auto& batch : mBatches)
+        {
+            for (auto& timer : batch.Timers)
+            {
+                Scheduler::Get().Cancel(timer);
+            }
+        }
+    }
+
+    void ProductionSystem::Resume()
+    {
+        if (!mSuspended)
+            return;
+
+        mSuspended = false;
+
+        // reschedule in sequence order so equal due times keep firing in the same order
+        mCompletions.clear();
+        for (usize type = 0; type < mBatches.size(); type++)
+        {
+            const Batch& batch = mBatches[type];
+            for (usize index = 0; index < batch.Ids.size(); index++)
+            {
+                mCompletions.push_back({ 0.0, 0.0, 0.0, 0, batch.Sequences[index], static_cast<BuildingType>(type), static_cast<u32>(index) });
+            }
+        }
+
+        std::ranges::sort(mCompletions, {}, &Completion::Sequence);
+        for (const Completion& producer : mCompletions)
+        {
+            Restart(producer.Type, producer.Index);
+        }
+    }
+
+    u64 ProductionSystem::AdvanceTo(f64 time, u64 stamp)
+    {
+        RF_CORE_ASSERT(mSuspended, "AdvanceTo would double count cycles that have timers");
+
+        Warehouse& warehouse = Warehouse::Get();
+        Scheduler& scheduler = Scheduler::Get();
+        mCompletions.clear();
+
+        ResourceVector totals;
+        std::array<u64, static_cast<usize>(BuildingType::Count)> cycles{};
+        i64 space_needed = 0;
+        i32 min_space = std::numeric_limits<i32>::max();
+        u64 completed = 0;
+
+        for (usize type = 0; type < mBatches.size(); type++)
+        {
+            Batch& batch = mBatches[type];
+            usize chunk_count = JobSystem::GetChunkCount(batch.Ids.size(), ProducerGrain);
+            if (mChunkResults.size() < chunk_count)
+                mChunkResults.resize(chunk_count);
+
+            // producers only write their own slots, each chunk collects into its own result
+            JobSystem::ParallelFor(batch.Ids.size(), ProducerGrain, [&](usize chunk, usize begin, usize end)
+            {
+                AdvanceRange(static_cast<BuildingType>(type), begin, end, time, stamp, mChunkResults[chunk]);
+            });
+
+            // merged in chunk order, so the completions come out exactly as a serial loop lists them
+            for (usize chunk = 0; chunk < chunk_count; chunk++)
+            {
+                const ChunkResult& result = mChunkResults[chunk];
+                if (result.Completed == 0)
+                    continue;
+
+                totals += result.Totals;
+                space_needed += result.SpaceNeeded;
+                min_space = std::min(min_space, ResourceTypeToSpace(batch.Output) * batch.OutputAmount);
+                completed += result.Completed;
+                cycles[type] += result.Completed;
+                mCompletions.insert(mCompletions.end(), result.Completions.begin(), result.Completions.end());
+            }
+        }
+
+        if (completed == 0)
+            return 0;
+
+        i32 free_space = warehouse.GetCapacity() - warehouse.GetUsedSpace();
+        ResourceTelemetry& telemetry = ResourceTelemetry::Get();
+        if (space_needed <= free_space)
+        {
+            warehouse.Add(totals);
+
+            for (usize type = 0; type < mBatches.size(); type++)
+            {
+                const Batch& batch = mBatches[type];
+                if (cycles[type] > 0)
+                {
+                    telemetry.Record(static_cast<BuildingType>(type), ResourceFlow::Produced, batch.Output, static_cast<i32>(cycles[type]) * batch.OutputAmount);
+                }
+            }
+        }
+        else
+        {
+            // the warehouse fills up during this span, so which outputs still fit depends on the
+            // order they complete in; replay in order until not even the smallest output fits
+            std::ranges::make_heap(mCompletions, std::greater<>());
+            auto heap_end = mCompletions.end();
+
+            while (heap_end != mCompletions.begin() && free_space >= min_space)
+            {
+                std::pop_heap(mCompletions.begin(), heap_end, std::greater<>());
+                Completion& next = *(heap_end - 1);
+                Batch& batch = GetBatch(next.Type);
+
+                if (warehouse.Add(batch.Output, batch.OutputAmount))
+                {
+                    free_space = warehouse.GetCapacity() - warehouse.GetUsedSpace();
+                    telemetry.Record(next.Type, ResourceFlow::Produced, batch.Output, batch.OutputAmount);
+                }
+                else
+                {
+                    telemetry.Record(next.Type, ResourceFlow::Lost, batch.Output, batch.OutputAmount);
+                }
+
+                next.Sequence = scheduler.ReserveStamp();
+                if (--next.Remaining == 0)
+                {
+                    batch.Sequences[next.Index] = next.Sequence;
+                    --heap_end;
+                    continue;
+                }
+
+                next.NextTime += next.Duration;
+                std::push_heap(mCompletions.begin(), heap_end, std::greater<>());
+            }
+
+            // the cycles left once nothing fits any more are lost like any other full-warehouse cycle
+            for (auto it = mCompletions.begin(); it != heap_end; ++it)
+            {
+                const Batch& batch = GetBatch(it->Type);
+                telemetry.Record(it->Type, ResourceFlow::Lost, batch.Output, static_cast<i32>(it->Remaining) * batch.OutputAmount);
+            }
+
+            mCompletions.erase(heap_end, mCompletions.end());
+        }
+
+        // whatever wasn't replayed gets the sequence its last completion would have given it
+        std::ranges::sort(mCompletions, [](const Completion& a, const Completion& b)
+        {
+            return a.LastTime != b.LastTime ? a.LastTime < b.LastTime : a.Sequence < b.Sequence;
+        });
+
+        for (const Completion& producer : mCompletions)
+        {
+            GetBatch(producer.Type).Sequences[producer.Index] = scheduler.ReserveStamp();
+        }
+
+        return completed;
+    }
+
+    void ProductionSystem::AdvanceRange(BuildingType type, usize begin, usize end, f64 time, u64 stamp, ChunkResult& out_result)
+    {
+        Batch& batch = GetBatch(type);
+        i32 space = ResourceTypeToSpace(batch.Output) * batch.OutputAmount;
+
+        out_result.Totals = {};
+        out_result.SpaceNeeded = 0;
+        out_result.Completed = 0;
+        out_result.Completions.clear();
+
+        for (usize index = begin; index < end; index++)
+        {
+            if (!IsRunning(batch, index))
+                continue;
+
+            f64 duration = batch.CycleTimes[index] / batch.Efficiencies[index];
+            f64 due_time = batch.ProgressTimes[index] + (1.0 - batch.Progress[index]) * duration;
+
+            // the first completion keeps its stamp and may beat a timer due at the same time,
+            // later ones are rescheduled during this span and always come after it
+            u64 count;
+            if (due_time == time)
+            {
+                count = batch.Sequences[index] < stamp ? 1 : 0;
+            }
+            else if (due_time < time)
+            {
+                // completions at due_time + k * duration for every k that lands before time
+                count = static_cast<u64>((time - due_time) / duration) + 1;
+                while (count > 1 && due_time + static_cast<f64>(count - 1) * duration >= time)
+                    count--;
+                while (due_time + static_cast<f64>(count) * duration < time)
+                    count++;
+            }
+            else
+            {
+                count = 0;
+            }
+
+            if (count == 0)
+                continue;
+
+            // same snapshot OnCycleComplete leaves: the cycle in progress started at the last completion
+            f64 last_time = due_time + static_cast<f64>(count - 1) * duration;
+            batch.Progress[index] = 0.0f;
+            batch.ProgressTimes[index] = last_time;
+
+            out_result.Totals[batch.Output] += static_cast<i32>(count) * batch.OutputAmount;
+            out_result.SpaceNeeded += static_cast<i64>(count) * space;
+            out_result.Completed += count;
+            out_result.Completions.push_back({ due_time, last_time, duration, count, batch.Sequences[index], type, static_cast<u32>(index) });
+        }
+    }
+
+    ProductionSystem::State ProductionSystem::SaveState() const
+    {
+        return { mBatches, mSuspended };
+    }
+
+    void ProductionSystem::RestoreState(const State& state)
+    {
+        mBatches = state.Batches;
+        mSuspended = state.Suspended;
+    }
+
+    void ProductionSystem::Clear()
+    {
+        for (auto& batch : mBatches)
+        {
+            for (auto& timer : batch.Timers)
+            {
+                Scheduler::Get().Cancel(timer);
+            }
+            batch = Batch{};
+        }
+        mSuspended = false;
+    }
+
+    bool ProductionSystem::Resolve(const Batch& batch, ProductionHandle handle, usize& out_index)
+    {
+        if (!handle.IsValid() || handle.Id >= batch.DenseIndices.size())
+            return false;
+
+        u32 index = batch.DenseIndices[handle.Id];
+        if (index == ProductionHandle::InvalidId)
+            return false;
+
+        out_index = index;
+        return true;
+    }
+
+    bool ProductionSystem::IsRunning(const Batch& batch, usize index)
+    {
+        return batch.Active[index] && batch.Efficiencies[index] > 0.0f && batch.CycleTimes[index] > 0.0f;
+    }
+
+    f32 ProductionSystem::GetCurrentProgress(const Batch& batch, usize index)
+    {
+        if (!IsRunning(batch, index))
+            return batch.Progress[index];
+
+        f64 duration = batch.CycleTimes[index] / batch.Efficiencies[index];
+        f64 elapsed = Scheduler::Get().GetTime() - batch.ProgressTimes[index];
+        return std::min(1.0f, batch.Progress[index] + static_cast<f32>(elapsed / duration));
+    }
+
+    void ProductionSystem::Restart(BuildingType type, usize index)
+    {
+        Batch& batch = GetBatch(type);
+        Scheduler& scheduler = Scheduler::Get();
+
+        if (!IsRunning(batch, index))
+        {
+            scheduler.Cancel(batch.Timers[index]);
+            return;
+        }
+
+        if (mSuspended)
+        {
+            batch.Sequences[index] = scheduler.ReserveStamp();
+            return;
+        }
+
+        f64 duration = batch.CycleTimes[index] / batch.Efficiencies[index];
+        f64 due_time = batch.ProgressTimes[index] + (1.0 - batch.Progress[index]) * duration;
+
+        if (!scheduler.Reschedule(batch.Timers[index], due_time))
+        {
+            ProductionHandle handle{ type, batch.Ids[index] };
+            batch.Timers[index] = scheduler.ScheduleAt(due_time, [this, handle](TimerHandle timer, f64 time)
+            {
+                OnCycleComplete(handle, timer, time);
+            });
+        }
+        batch.Sequences[index] = scheduler.GetStamp(batch.Timers[index]);
+    }
+
+    void ProductionSystem::OnCycleComplete(ProductionHandle handle, TimerHandle timer, f64 due_time)
+    {
+        Batch& batch = GetBatch(handle.Type);
+        usize index;
+        if (!Resolve(batch, handle, index))
+            return;
+
+        // a full warehouse loses the cycle's output, the producer keeps working
+        bool stored = Warehouse::Get().Add(batch.Output, batch.OutputAmount);
+        ResourceTelemetry::Get().Record(handle.Type, stored ? ResourceFlow::Produced : ResourceFlow::Lost, batch.Output, batch.OutputAmount);
+
+        // the next cycle starts when this one was due, not when the tick noticed it
+        batch.Progress[index] = 0.0f;
+        batch.ProgressTimes[index] = due_time;
+
+        f64 duration = batch.CycleTimes[index] / batch.Efficiencies[index];
+        Scheduler::Get().Reschedule(timer, due_time + duration);
+        batch.Sequences[index] = Scheduler::Get().GetStamp(timer);
+    }
+} // namespace RealmFortress
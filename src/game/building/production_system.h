@@ -0,0 +1,157 @@
+/**
+ * @file production_system.h
+ * @brief
+ * @date 12/22/2025
+ */
+
+#pragma once
+
+#include "core/base.h"
+#include "game/building/building.h"
+#include "game/resource/resource.h"
+#include "game/system/scheduler.h"
+#include <array>
+#include <vector>
+
+namespace RealmFortress
+{
+    /**
+     * @class ProductionSystem
+     * @brief Keeps every timed producer in flat per-type arrays and drives them from the Scheduler.
+     *
+     * Each building type has one batch holding parallel arrays of cycle time, efficiency and
+     * progress. Nothing is touched per tick: a producer has one pending timer for the moment
+     * its current cycle completes, and is only rescheduled when it completes or when its
+     * efficiency or active state changes. Buildings keep a ProductionHandle and read their
+     * state back through it; the handle stays stable while the arrays are compacted with
+     * swap-and-pop on removal.
+     *
+     * Progress is stored as a snapshot (value and the time it was taken) and extrapolated on
+     * read, so an efficiency change keeps the progress already made and only changes the rate.
+     *
+     * While suspended no timers are kept; AdvanceTo credits every cycle completed up to a point
+     * in time in closed form instead, which is how the economy fast-forwards long spans. The
+     * sweep runs in parallel chunks on the JobSystem; the warehouse is only touched afterwards,
+     * on the calling thread, so capacity clamping resolves the same as in a serial sweep.
+     *
+     * Only that catch-up path scales with cores. Per-tick completions still fire one timer at a
+     * time from Scheduler::OnUpdate on the main thread; a tick completes a handful of cycles,
+     * too few to pay for a job dispatch.
+     */
+    class ProductionSystem
+    {
+        struct Batch
+        {
+            ResourceType Output{ ResourceType::Count };
+            i32 OutputAmount{ 0 };
+
+            // dense, one entry per producer, indexed together
+            std::vector<f32> CycleTimes;
+            std::vector<f32> Efficiencies;
+            std::vector<f32> Progress;
+            std::vector<f64> ProgressTimes;
+            std::vector<u8> Active;
+            std::vector<TimerHandle> Timers;
+            // scheduler stamp of the last (re)schedule, kept up while suspended too
+            std::vector<u64> Sequences;
+            std::vector<u32> Ids;
+
+            // sparse, handle id -> dense index
+            std::vector<u32> DenseIndices;
+            std::vector<u32> FreeIds;
+        };
+
+    public:
+        struct State
+        {
+            std::array<Batch, static_cast<usize>(BuildingType::Count)> Batches;
+            bool Suspended{ false };
+        };
+
+        static ProductionSystem& Get()
+        {
+            static ProductionSystem instance;
+            return instance;
+        }
+
+        ProductionSystem(const ProductionSystem&) = delete;
+        ProductionSystem& operator=(const ProductionSystem&) = delete;
+
+        ProductionHandle Register(BuildingType type, ResourceType output, i32 output_amount, f32 cycle_time);
+        void Unregister(ProductionHandle& handle);
+
+        void SetEfficiency(ProductionHandle handle, f32 efficiency);
+        void SetActive(ProductionHandle handle, bool active);
+
+        f32 GetEfficiency(ProductionHandle handle) const;
+        f32 GetProgress(ProductionHandle handle) const;
+        f32 GetCycleTime(ProductionHandle handle) const;
+
+        usize GetProducerCount() const;
+        usize GetProducerCount(BuildingType type) const;
+
+        // drops every timer, production then only advances through AdvanceTo until Resume
+        void Suspend();
+        void Resume();
+        bool IsSuspended() const { return mSuspended; }
+
+        // credits all cycles completing before time, in completion order once the warehouse
+        // gets close to full; a cycle due exactly at time counts if it would fire before the
+        // timer with the given stamp. Returns how many cycles completed
+        u64 AdvanceTo(f64 time, u64 stamp = std::numeric_limits<u64>::max());
+
+        State SaveState() const;
+        void RestoreState(const State& state);
+
+        void Clear();
+
+    private:
+        ProductionSystem() = default;
+
+        // producers per job when AdvanceTo sweeps a batch in parallel
+        static constexpr usize ProducerGrain = 2048;
+
+        struct Completion
+        {
+            f64 NextTime;
+            f64 LastTime;
+            f64 Duration;
+            u64 Remaining;
+            u64 Sequence;
+            BuildingType Type;
+            u32 Index;
+
+            // the order the scheduler would fire them in: by time, then by who was rescheduled first
+            bool operator>(const Completion& other) const
+            {
+                return NextTime != other.NextTime ? NextTime > other.NextTime : Sequence > other.Sequence;
+            }
+        };
+
+        // what one chunk of producers completed during AdvanceTo, merged in chunk order
+        struct ChunkResult
+        {
+            ResourceVector Totals;
+            i64 SpaceNeeded{ 0 };
+            u64 Completed{ 0 };
+            std::vector<Completion> Completions;
+        };
+
+        Batch& GetBatch(BuildingType type) { return mBatches[static_cast<usize>(type)]; }
+        const Batch& GetBatch(BuildingType type) const { return mBatches[static_cast<usize>(type)]; }
+
+        static bool Resolve(const Batch& batch, ProductionHandle handle, usize& out_index);
+        static bool IsRunning(const Batch& batch, usize index);
+        static f32 GetCurrentProgress(const Batch& batch, usize index);
+
+        void AdvanceRange(BuildingType type, usize begin, usize end, f64 time, u64 stamp, ChunkResult& out_result);
+        void Restart(BuildingType type, usize index);
+        void OnCycleComplete(ProductionHandle handle, TimerHandle timer, f64 due_time);
+
+    private:
+        std::array<Batch, static_cast<usize>(BuildingType::Count)> mBatches;
+        std::vector<Completion> mCompletions;
+        std::vector<ChunkResult> mChunkResults;
+        bool mSuspended{ false };
+    };
+} // namespace RealmFortress
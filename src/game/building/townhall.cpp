@@ -8,49 +8,64 @@
 #include "townhall.h"
 #include "game/resource/warehouse.h"
 #include "game/building/building_manager.h"
+#include "game/system/resource_telemetry.h"
 #include <imgui.h>
 
 namespace RealmFortress
 {
     Townhall::Townhall(const Coordinate& coordinate)
         : Building(BuildingType::Townhall, coordinate)
-        , mStorageCapacityBonus(200), mTime(0.0f), mFoodCycleTime(15.0f)
+        , mStorageCapacityBonus(200), mFoodCycleTime(15.0f)
         , mFoodNeeded(5), mIsStarving(false)
     {
     }
 
-    void Townhall::OnUpdate(Timestep ts)
+    Townhall::~Townhall()
     {
-        mTime += ts;
+        Scheduler::Get().Cancel(mFoodTimer);
+    }
 
-        if (mTime >= mFoodCycleTime)
-        {
-            mTime -= mFoodCycleTime;
+    void Townhall::OnFoodCycle(TimerHandle timer, f64 due_time)
+    {
+        Scheduler::Get().Reschedule(timer, due_time + mFoodCycleTime);
 
-            usize total_buildings = BuildingManager::Get().GetAllBuildings().size();
+        usize total_buildings = BuildingManager::Get().GetAllBuildings().size();
 
-            mFoodNeeded = 5 + (static_cast<i32>(total_buildings) * 2);
+        mFoodNeeded = 5 + (static_cast<i32>(total_buildings) * 2);
+
+        // try to consume food
+        if (Warehouse::Get().Consume(ResourceType::Wheat, mFoodNeeded))
+        {
+            ResourceTelemetry::Get().Record(BuildingType::Townhall, ResourceFlow::Consumed, ResourceType::Wheat, mFoodNeeded);
 
-            // try to consume food
-            if (Warehouse::Get().Consume(ResourceType::Wheat, mFoodNeeded))
+            if (mIsStarving)
             {
-                if (mIsStarving)
-                {
-                    RF_CORE_INFO("Townhall is operational again (Wheat consumed: {})", mFoodNeeded);
-                    mIsStarving = false;
-                }
+                RF_CORE_INFO("Townhall is operational again (Wheat consumed: {})", mFoodNeeded);
+                mIsStarving = false;
+                BuildingManager::Get().InvalidateDependency(BuildingDependencyStarvation);
             }
-            else
+        }
+        else
+        {
+            if (!mIsStarving)
             {
-                if (!mIsStarving)
-                {
-                    RF_CORE_WARN("Townhall is STARVING! Not enough Wheat (Needed: {}). Efficiency penalized.", mFoodNeeded);
-                    mIsStarving = true;
-                }
+                RF_CORE_WARN("Townhall is STARVING! Not enough Wheat (Needed: {}). Efficiency penalized.", mFoodNeeded);
+                mIsStarving = true;
+                BuildingManager::Get().InvalidateDependency(BuildingDependencyStarvation);
             }
         }
     }
 
+    void Townhall::RestoreState(const State& state)
+    {
+        mFoodNeeded = state.FoodNeeded;
+        if (mIsStarving != state.IsStarving)
+        {
+            mIsStarving = state.IsStarving;
+            BuildingManager::Get().InvalidateDependency(BuildingDependencyStarvation);
+        }
+    }
+
     void Townhall::OnInspected()
     {
         // Food Consumption Rate
@@ -77,6 +92,11 @@ namespace RealmFortress
     void Townhall::OnPlaced(const Map& map)
     {
         Warehouse::Get().IncreaseCapacity(mStorageCapacityBonus);
+        mFoodTimer = Scheduler::Get().Schedule(mFoodCycleTime, [this](TimerHandle timer, f64 due_time)
+        {
+            OnFoodCycle(timer, due_time);
+        });
+        BuildingManager::Get().InvalidateDependency(BuildingDependencyTownhall);
         RF_CORE_INFO("Townhall placed. Warehouse capacity increased by {}", mStorageCapacityBonus);
     }
 
@@ -84,19 +104,11 @@ namespace RealmFortress
     {
         // TODO: implement DecreaseCapacity()
         Warehouse::Get().IncreaseCapacity(-mStorageCapacityBonus);
+        Scheduler::Get().Cancel(mFoodTimer);
+        BuildingManager::Get().InvalidateDependency(BuildingDependencyTownhall);
     }
 
     void Townhall::OnMapChanged(const Map& map)
     {
     }
-
-    bool Townhall::CanPlace(const Coordinate& coord, const Map& map) const
-    {
-        auto tile = map.GetTile(coord);
-
-        if (tile->GetDecoration() != DecorationType::None) return false;
-        if (tile->GetType() == TileType::Water) return false;
-
-        return true;
-    }
 }
@@ -15,21 +15,31 @@ namespace RealmFortress
     class Townhall final : public Building
     {
     public:
+        struct State
+        {
+            i32 FoodNeeded;
+            bool IsStarving;
+        };
+
         Townhall(const Coordinate& coordinate);
+        ~Townhall() override;
 
-        void OnUpdate(Timestep ts) override;
         void OnInspected() override;
         void OnPlaced(const Map& map) override;
         void OnDestroyed(const Map& map) override;
         void OnMapChanged(const Map& map) override;
 
-        bool CanPlace(const Coordinate& coord, const Map& map) const override;
-
         bool IsStarving() const { return mIsStarving; }
 
+        State SaveState() const { return { mFoodNeeded, mIsStarving }; }
+        void RestoreState(const State& state);
+
+    private:
+        void OnFoodCycle(TimerHandle timer, f64 due_time);
+
     private:
         i32 mStorageCapacityBonus;
-        f32 mTime;
+        TimerHandle mFoodTimer;
         f32 mFoodCycleTime;
         i32 mFoodNeeded;
         bool mIsStarving;
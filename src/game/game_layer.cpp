@@ -9,18 +9,23 @@
 #include "core/logger.h"
 #include "core/application.h"
 #include "core/input.h"
+#include "core/frame_allocator.h"
+#include "core/memory_tracker.h"
+#include "core/profiler.h"
 #include "renderer/renderer.h"
 #include "renderer/model_cache.h"
 #include "game/building/mine.h"
 #include "game/building/lumbermill.h"
 #include "game/thumbnail_generator.h"
 #include "game/system/constants.h"
+#include "game/system/economy.h"
+#include "game/system/resource_telemetry.h"
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include <imgui.h>
 
 namespace RealmFortress
 {
-    GameLayer::GameLayer()
+    GameLayer::GameLayer(const std::filesystem::path& benchmark_script)
         : Layer("GameLayer")
     {
         mBasicShader = mShaderLibrary.Load("assets/shaders/basic.glsl");
@@ -30,13 +35,44 @@ namespace RealmFortress
         auto& window = Application::Get().GetWindow();
         f32 aspect_ratio = static_cast<f32>(window.GetWidth()) / static_cast<f32>(window.GetHeight());
         mCameraController = CreateRef<CameraController>(aspect_ratio);
+
+        if (!benchmark_script.empty())
+        {
+            mFlythrough = CreateScope<FlythroughBenchmark>();
+            if (mFlythrough->Load(benchmark_script))
+            {
+                // timings should show what a frame costs, not the display's refresh rate
+                window.SetVSync(false);
+            }
+            else
+            {
+                mFlythrough.reset();
+                Application::Get().Close();
+            }
+        }
     }
 
     void GameLayer::OnAttach()
     {
         RF_CORE_INFO("GameLayer attached");
 
+        // roomy for a long session, crossing one is worth a look rather than an error
+        constexpr usize mb = 1024 * 1024;
+        MemoryTracker::SetBudget(MemoryTag::Map, 128 * mb);
+        MemoryTracker::SetBudget(MemoryTag::Models, ModelCache::GetMemoryBudget());
+        MemoryTracker::SetBudget(MemoryTag::Textures, 256 * mb);
+        MemoryTracker::SetBudget(MemoryTag::Framebuffers, 64 * mb);
+        MemoryTracker::SetBudget(MemoryTag::Buildings, 16 * mb);
+        MemoryTracker::SetBudget(MemoryTag::ImGui, 32 * mb);
+
         ThumbnailGenerator::Init(512);
+        mAssetPreloader.Start();
+
+        if (mFlythrough)
+        {
+            mMap.Regenerate(mFlythrough->GetSeed());
+            mMap.SetChunkBudget(FlythroughBenchmark::ChunkBudget);
+        }
 
         mCameraController->GetCamera().SetPosition(glm::vec3(0.0f, 15.0f, 15.0f));
         mCameraController->GetCamera().SetRotation(glm::vec3(-45.0f, 0.0f, 0.0f));
@@ -64,6 +100,8 @@ namespace RealmFortress
     {
         RF_CORE_INFO("GameLayer detached");
         BuildingManager::Get().Clear();
+        Scheduler::Get().Clear();
+        ResourceTelemetry::Get().Clear();
         ThumbnailGenerator::Shutdown();
     }
 
@@ -71,11 +109,60 @@ namespace RealmFortress
     {
         mTime += ts;
 
-        Warehouse::Get().OnUpdate(ts);
-        BuildingManager::Get().OnUpdate(ts);
+        if (!mAssetsLoaded)
+        {
+            Renderer::SetClearColor(glm::vec4(0.1f, 0.1f, 0.08f, 1.0f));
+            Renderer::Clear();
+
+            if (mAssetPreloader.Update())
+            {
+                mAssetsLoaded = true;
+                RegisterInputHandlers();
+                ModelCache::SetWarnOnLoad(true);
+            }
+            return;
+        }
+
+        mPerformanceMonitor.OnFrame(ts);
 
-        mCameraController->OnUpdate(ts);
+        if (mFlythrough)
+        {
+            mFlythrough->BeginFrame();
+            // the simulation and camera see the script's step, so every run plays the same frames
+            ts = mFlythrough->GetStep();
+        }
+
+        // whatever piled up while minimized goes first, in one analytic step
+        if (mSuspendedTime > 0.0)
+        {
+            FastForward(mSuspendedTime);
+            mSuspendedTime = 0.0;
+        }
+
+        auto simulation_start = std::chrono::steady_clock::now();
+        // even at MaxTimeScale a frame spans well under one producer cycle, so stepping it is
+        // cheaper than suspending and resuming every timer around an analytic step
+        u32 ticks = mSimulationClock.Advance(ts);
+        for (u32 tick = 0; tick < ticks; tick++)
+        {
+            SimulationTick(mSimulationClock.GetTickDelta());
+        }
+        mPerformanceMonitor.AddSimulationTime(std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - simulation_start).count(), ticks);
+
+        if (mFlythrough)
+        {
+            CameraKeyframe pose = mFlythrough->GetPose();
+            mCameraController->SetView(pose.FocalPoint, pose.Yaw, pose.Pitch, pose.Distance);
+        }
+        else
+        {
+            mCameraController->OnUpdate(ts);
+        }
         mMap.OnUpdate(mCameraController->GetCamera().GetPosition());
+        for (ChunkCoordinate chunk : mMap.GetLoadedChunks())
+        {
+            BuildingManager::Get().InvalidateChunk(chunk);
+        }
 
         Renderer::BeginFrame();
         Renderer::SetClearColor(glm::vec4(0.53f, 0.81f, 0.92f, 1.0f));
@@ -90,15 +177,37 @@ namespace RealmFortress
         mBasicShader->Bind();
         mBasicShader->SetMat4("uViewProjection", Renderer::GetViewProjectionMatrix());
 
+        FrameVector<const Building*> under_construction(FrameAllocator::GetResource());
         for (const auto& building : BuildingManager::Get().GetAllBuildings())
         {
-            if (building && building->GetModel())
+            if (building && building->IsUnderConstruction())
+            {
+                under_construction.push_back(building.get());
+                continue;
+            }
+
+            if (Model* model = building ? building->GetModel() : nullptr)
             {
-                building->GetModel()->Draw(mBasicShader, building->GetTransform());
+                model->Draw(mBasicShader, building->GetTransform());
             }
         }
 
-        std::unordered_set<Coordinate> lifted_tiles;
+        if (!under_construction.empty())
+        {
+            mGhostBuildingShader->Bind();
+            mGhostBuildingShader->SetMat4("uViewProjection", Renderer::GetViewProjectionMatrix());
+            mGhostBuildingShader->SetFloat3("uHighlightColor", glm::vec3(1.0f, 0.8f, 0.2f));
+            mGhostBuildingShader->SetFloat("uPulseTime", mTime);
+            mGhostBuildingShader->SetFloat("uHighlightIntensity", 0.3f);
+
+            for (const Building* building : under_construction)
+            {
+                if (Model* model = building->GetModel())
+                {
+                    model->Draw(mGhostBuildingShader, building->GetTransform());
+                }
+            }
+        }
 
         if (mGameMode == GameMode::Building)
         {
@@ -117,13 +226,35 @@ namespace RealmFortress
 
         Renderer::EndScene();
         Renderer::EndFrame();
+
+        if (mFlythrough)
+        {
+            mFlythrough->EndFrame(Renderer::GetStats(), mMap.GetPendingChunkCount());
+            if (mFlythrough->IsFinished())
+            {
+                mFlythrough->WriteResults();
+                mFlythrough.reset();
+                Application::Get().Close();
+            }
+        }
     }
 
     void GameLayer::OnImGuiRender()
     {
+        if (!mAssetsLoaded)
+        {
+            DrawLoadingScreen();
+            return;
+        }
+
         ImVec2 action_bar_pos, action_bar_size;
         ImVec2 building_panel_pos, building_panel_size;
 
+        if (mGameMode == GameMode::Building)
+        {
+            DrawPlacementOverlay();
+        }
+
         DrawTimeHUD();
         DrawActionBar(&action_bar_pos, &action_bar_size);
 
@@ -146,16 +277,28 @@ namespace RealmFortress
         {
             DrawInspectPanel();
         }
+
+        if (mShowPerformanceOverlay)
+        {
+            DrawPerformanceOverlay();
+        }
     }
 
-    void GameLayer::OnEvent(Event& event)
+    void GameLayer::RegisterInputHandlers()
     {
-        EventDispatcher dispatcher(event);
-        dispatcher.Dispatch<MouseButtonPressedEvent>(RF_BIND_EVENT_FN(OnMouseButtonPressed));
-        dispatcher.Dispatch<MouseMovedEvent>(RF_BIND_EVENT_FN(OnMouseMoved));
-        dispatcher.Dispatch<KeyPressedEvent>(RF_BIND_EVENT_FN(OnKeyPressed));
+        // a scripted run never registers any, so stray mouse moves can't change what gets rendered
+        if (mFlythrough)
+            return;
 
-        mCameraController->OnEvent(event);
+        mEventHandlers.Register<MouseButtonPressedEvent, &GameLayer::OnMouseButtonPressed>(this);
+        mEventHandlers.Register<MouseMovedEvent, &GameLayer::OnMouseMoved>(this);
+        mEventHandlers.Register<MouseScrolledEvent, &GameLayer::OnMouseScrolled>(this);
+        mEventHandlers.Register<KeyPressedEvent, &GameLayer::OnKeyPressed>(this);
+    }
+
+    bool GameLayer::OnMouseScrolled(MouseScrolledEvent& event)
+    {
+        return mCameraController->OnMouseScrolled(event);
     }
 
     bool GameLayer::OnMouseButtonPressed(MouseButtonPressedEvent& event)
@@ -232,6 +375,44 @@ namespace RealmFortress
             return true;
         }
 
+        if (event.GetKeyCode() == Key::Space)
+        {
+            mSimulationClock.TogglePaused();
+            return true;
+        }
+
+        if (event.GetKeyCode() == Key::F9)
+        {
+            mValidateFastForward = !mValidateFastForward;
+            RF_CORE_INFO("Fast-forward validation {}", mValidateFastForward ? "enabled" : "disabled");
+            return true;
+        }
+
+        if (event.GetKeyCode() == Key::F3)
+        {
+            mShowPerformanceOverlay = !mShowPerformanceOverlay;
+            return true;
+        }
+
+        if (event.GetKeyCode() == Key::F7)
+        {
+            // the first press only marks a starting point, later ones report what changed since the last
+            MemorySnapshot snapshot = MemoryTracker::TakeSnapshot();
+            if (mMemorySnapshot)
+                MemoryTracker::LogDiff(*mMemorySnapshot, snapshot);
+            else
+                RF_CORE_INFO("Memory snapshot taken, press F7 again to see what changed");
+            mMemorySnapshot = snapshot;
+            return true;
+        }
+
+        if (event.GetKeyCode() == Key::F8)
+        {
+            Profiler::BeginCapture();
+            RF_CORE_INFO("Profiler capture of {} frames queued", Profiler::DefaultCaptureFrames);
+            return true;
+        }
+
         if (event.GetKeyCode() == Key::F11)
         {
             Application::Get().GetWindow().ToggleFullscreen();
@@ -241,6 +422,36 @@ namespace RealmFortress
         return false;
     }
 
+    void GameLayer::OnSuspended(Timestep ts)
+    {
+        if (!mAssetsLoaded)
+            return;
+
+        mSuspendedTime += mSimulationClock.Skip(ts);
+        if (mSuspendedTime >= FAST_FORWARD_SUSPENDED_BATCH)
+        {
+            FastForward(mSuspendedTime);
+            mSuspendedTime = 0.0;
+        }
+    }
+
+    void GameLayer::SimulationTick(Timestep ts)
+    {
+        Economy::Tick(ts, mMap);
+    }
+
+    void GameLayer::FastForward(f64 duration)
+    {
+        if (mValidateFastForward)
+        {
+            Economy::ValidateFastForward(duration, mSimulationClock.GetTickDelta(), mMap);
+        }
+        else
+        {
+            Economy::FastForward(duration, mMap);
+        }
+    }
+
     void GameLayer::UpdateSelection()
     {
         glm::vec2 mouse_pos = Input::GetMousePosition();
@@ -292,7 +503,7 @@ namespace RealmFortress
         }
         else
         {
-            RF_CORE_WARN("Cannot place building at ({}, {})", coord.Q, coord.R);
+            RF_CORE_WARN_RATE_LIMITED("Cannot place building at ({}, {})", coord.Q, coord.R);
         }
     }
 
@@ -305,15 +516,10 @@ namespace RealmFortress
         bool can_place = BuildingManager::Get().CanPlaceBuilding(mSelectedBuildingType, coord, mMap);
 
         const auto& definition = GetBuildingDefinition(mSelectedBuildingType);
-        auto model = ModelCache::Get(definition.ModelPath);
-
+        Model* model = ModelCache::Get(ModelCache::Load(definition.ModelPath));
         if (!model)
         {
-            model = ModelCache::Load(definition.ModelPath);
-            if (!model)
-            {
-                model = ModelCache::Get("assets/objects/buildings/blue/building_mine_blue.gltf");
-            }
+            model = ModelCache::Get(ModelCache::Find("assets/objects/buildings/blue/building_mine_blue.gltf"));
         }
 
         if (model)
@@ -364,11 +570,258 @@ namespace RealmFortress
 
     constexpr f32 EconomyPanel_HeightScale{ 0.61f };
     constexpr f32 EconomyPanel_WidthScale{ 0.32f };
+    constexpr f32 EconomyPanel_PlotHeight{ 40.0f };
+    constexpr f64 EconomyPanel_RateWindows[] = { 1.0, 10.0, 60.0 };
 
     constexpr ImVec2 InspectPanel_SizeScale(0.25f, 0.55f);
 
+    constexpr f32 LoadingScreen_Width{ 480.0f };
+
+    constexpr f32 TimeHUD_ButtonWidth{ 42.0f };
+    constexpr f32 TimeHUD_Speeds[] = { 1.0f, 2.0f, 4.0f, 8.0f, 16.0f };
+
+    constexpr f32 PerformanceOverlay_Width{ 300.0f };
+    constexpr f32 PerformanceOverlay_Margin{ 10.0f };
+    constexpr f32 PerformanceOverlay_PlotHeight{ 60.0f };
+
+    constexpr i32 PlacementOverlay_Radius{ 8 };
+    constexpr f32 PlacementOverlay_HexScale{ 0.9f };
+
+    void GameLayer::DrawLoadingScreen()
+    {
+        ImGuiViewport* viewport = ImGui::GetMainViewport();
+        ImVec2 pos(viewport->Pos.x + viewport->Size.x * 0.5f, viewport->Pos.y + viewport->Size.y * 0.5f);
+        ImGui::SetNextWindowPos(pos, ImGuiCond_Always, ImVec2(0.5f, 0.5f));
+        ImGui::SetNextWindowSize(ImVec2(LoadingScreen_Width, 0.0f), ImGuiCond_Always);
+
+        ImGuiWindowFlags flags = ImGuiWindowFlags_NoNav
+                               | ImGuiWindowFlags_NoTitleBar
+                               | ImGuiWindowFlags_NoResize
+                               | ImGuiWindowFlags_NoMove
+                               | ImGuiWindowFlags_NoSavedSettings
+                               | ImGuiWindowFlags_NoBackground
+                               | ImGuiWindowFlags_NoDecoration;
+
+        ImGui::Begin("LoadingScreen", nullptr, flags);
+        {
+            ImGui::SetWindowFontScale(1.5f);
+            ImGui::Text("Loading...");
+            ImGui::SetWindowFontScale(1.0f);
+
+            ImGui::PushStyleColor(ImGuiCol_PlotHistogram, IM_COL32(125, 127, 102, 255));
+            ImGui::ProgressBar(mAssetPreloader.GetProgress(), ImVec2(-1.0f, 0.0f));
+            ImGui::PopStyleColor();
+
+            ImGui::TextDisabled("%zu / %zu  %s",
+                mAssetPreloader.GetLoadedCount(),
+                mAssetPreloader.GetTotalCount(),
+                mAssetPreloader.GetLastLoaded().c_str());
+        }
+        ImGui::End();
+    }
+
     void GameLayer::DrawTimeHUD()
     {
+        ImGuiViewport* viewport = ImGui::GetMainViewport();
+        ImVec2 pos(viewport->Pos.x + viewport->Size.x * 0.5f, viewport->Pos.y);
+        ImGui::SetNextWindowPos(pos, ImGuiCond_Always, ImVec2(0.5f, 0.0f));
+        ImGui::SetNextWindowBgAlpha(0.85f);
+
+        ImGuiWindowFlags flags = ImGuiWindowFlags_NoNav
+                               | ImGuiWindowFlags_NoTitleBar
+                               | ImGuiWindowFlags_NoResize
+                               | ImGuiWindowFlags_NoMove
+                               | ImGuiWindowFlags_NoSavedSettings
+                               | ImGuiWindowFlags_AlwaysAutoResize
+                               | ImGuiWindowFlags_NoBringToFrontOnFocus;
+
+        ImGui::Begin("TimeHUD", nullptr, flags);
+        {
+            f64 time = mSimulationClock.GetSimulationTime();
+            i32 day = static_cast<i32>(time / DAY_LENGTH) + 1;
+            i32 minute_of_day = static_cast<i32>(std::fmod(time, DAY_LENGTH) / DAY_LENGTH * 24.0 * 60.0);
+
+            ImGui::Text("Day %d  %02d:%02d", day, minute_of_day / 60, minute_of_day % 60);
+            ImGui::SameLine();
+
+            bool paused = mSimulationClock.IsPaused();
+            if (paused) ImGui::PushStyleColor(ImGuiCol_Button, IM_COL32(120, 60, 40, 255));
+            if (ImGui::Button(paused ? ">" : "||", ImVec2(TimeHUD_ButtonWidth, 0.0f)))
+            {
+                mSimulationClock.TogglePaused();
+            }
+            if (paused) ImGui::PopStyleColor();
+
+            for (f32 speed : TimeHUD_Speeds)
+            {
+                ImGui::SameLine();
+
+                bool active = !paused && mSimulationClock.GetTimeScale() == speed;
+                if (active) ImGui::PushStyleColor(ImGuiCol_Button, IM_COL32(90, 110, 50, 255));
+
+                std::string label = std::format("{}x", speed);
+                if (ImGui::Button(label.c_str(), ImVec2(TimeHUD_ButtonWidth, 0.0f)))
+                {
+                    mSimulationClock.SetTimeScale(speed);
+                    mSimulationClock.SetPaused(false);
+                }
+
+                if (active) ImGui::PopStyleColor();
+            }
+
+            if constexpr (MemoryTracker::IsEnabled())
+            {
+                ImGui::SameLine();
+                ImGui::TextDisabled("%llu allocs/frame", static_cast<unsigned long long>(MemoryTracker::GetFrameAllocationCount()));
+            }
+        }
+        ImGui::End();
+    }
+
+    void GameLayer::DrawPerformanceOverlay()
+    {
+        ImGuiViewport* viewport = ImGui::GetMainViewport();
+        ImVec2 pos(viewport->Pos.x + PerformanceOverlay_Margin, viewport->Pos.y + PerformanceOverlay_Margin);
+        ImGui::SetNextWindowPos(pos, ImGuiCond_Always);
+        ImGui::SetNextWindowSize(ImVec2(PerformanceOverlay_Width, 0.0f), ImGuiCond_Always);
+        ImGui::SetNextWindowBgAlpha(0.75f);
+
+        ImGuiWindowFlags flags = ImGuiWindowFlags_NoNav
+                               | ImGuiWindowFlags_NoTitleBar
+                               | ImGuiWindowFlags_NoResize
+                               | ImGuiWindowFlags_NoMove
+                               | ImGuiWindowFlags_NoSavedSettings
+                               | ImGuiWindowFlags_NoInputs
+                               | ImGuiWindowFlags_NoFocusOnAppearing
+                               | ImGuiWindowFlags_NoBringToFrontOnFocus;
+
+        constexpr f32 mb = 1024.0f * 1024.0f;
+
+        ImGui::Begin("PerformanceOverlay", nullptr, flags);
+        {
+            f32 frame_time = mPerformanceMonitor.GetLastFrameTime();
+            ImGui::Text("%.2f ms  (%.0f FPS)", frame_time, frame_time > 0.0f ? 1000.0f / frame_time : 0.0f);
+
+            FrameTimePercentiles percentiles = mPerformanceMonitor.ComputeFrameTimePercentiles();
+            char overlay[64];
+            std::snprintf(overlay, sizeof(overlay), "p50 %.1f  p95 %.1f  p99 %.1f", percentiles.P50, percentiles.P95, percentiles.P99);
+
+            // never scaled tighter than 60 FPS, so a smooth run reads as a flat line
+            const auto& frame_times = mPerformanceMonitor.GetFrameTimes();
+            f32 scale_max = std::max(percentiles.Max * 1.1f, 1000.0f / 60.0f);
+            ImGui::PlotLines("##FrameTimes", frame_times.data(), static_cast<i32>(frame_times.size()), static_cast<i32>(mPerformanceMonitor.GetOffset()),
+                             overlay, 0.0f, scale_max, ImVec2(ImGui::GetContentRegionAvail().x, PerformanceOverlay_PlotHeight));
+
+            ImGui::Separator();
+
+            const Renderer::Statistics& stats = Renderer::GetStats();
+            ImGui::Text("Draw calls   %u", stats.DrawCalls);
+            ImGui::Text("Triangles    %u", stats.TriangleCount);
+            ImGui::Text("Instances    %u", stats.InstanceCount);
+            ImGui::Text("Chunks       %zu resident, %zu pending", mMap.GetChunkCount(), mMap.GetPendingChunkCount());
+
+            ImGui::Separator();
+
+            ImGui::Text("Models       %zu, %.1f / %.0f MB", ModelCache::GetCachedCount(),
+                        static_cast<f32>(ModelCache::GetMemoryUsage()) / mb, static_cast<f32>(ModelCache::GetMemoryBudget()) / mb);
+            ImGui::Text("Frame arena  %.2f / %.0f MB, peak %.2f", static_cast<f32>(FrameAllocator::GetUsed()) / mb,
+                        static_cast<f32>(FrameAllocator::GetCapacity()) / mb, static_cast<f32>(FrameAllocator::GetPeak()) / mb);
+            if (u64 overflows = FrameAllocator::GetOverflowCount(); overflows > 0)
+            {
+                ImGui::TextColored(ImVec4(0.9f, 0.4f, 0.35f, 1.0f), "Frame arena overflowed %llu times", static_cast<unsigned long long>(overflows));
+            }
+            ImGui::Text("Log          %llu dropped, %llu collapsed", static_cast<unsigned long long>(Logger::GetDroppedMessageCount()),
+                        static_cast<unsigned long long>(Logger::GetSuppressedMessageCount()));
+
+            ImGui::Separator();
+
+            ImGui::Text("Memory%s", MemoryTracker::IsEnabled() ? "" : "       gpu only, heap tracking is off");
+            for (usize i = 0; i < MemoryTagCount; i++)
+            {
+                MemoryTag tag = static_cast<MemoryTag>(i);
+                MemoryTagUsage usage = MemoryTracker::GetUsage(tag);
+                usize budget = MemoryTracker::GetBudget(tag);
+                bool over_budget = budget > 0 && usage.CpuBytes + usage.GpuBytes > static_cast<i64>(budget);
+
+                f32 cpu = static_cast<f32>(usage.CpuBytes) / mb;
+                f32 gpu = static_cast<f32>(usage.GpuBytes) / mb;
+                if (over_budget)
+                    ImGui::TextColored(ImVec4(0.9f, 0.4f, 0.35f, 1.0f), "  %-11s cpu %6.1f  gpu %6.1f MB", MemoryTagToString(tag), cpu, gpu);
+                else
+                    ImGui::TextDisabled("  %-11s cpu %6.1f  gpu %6.1f MB", MemoryTagToString(tag), cpu, gpu);
+            }
+            if constexpr (MemoryTracker::IsEnabled())
+            {
+                ImGui::Text("Heap         %llu allocs/frame", static_cast<unsigned long long>(MemoryTracker::GetFrameAllocationCount()));
+            }
+
+            ImGui::Separator();
+
+            ImGui::Text("Buildings    %zu", BuildingManager::Get().GetAllBuildings().size());
+            for (u8 i = 0; i < static_cast<u8>(BuildingType::Count); i++)
+            {
+                BuildingType type = static_cast<BuildingType>(i);
+                ImGui::TextDisabled("  %-11s %d", GetBuildingDefinition(type).Name, BuildingManager::Get().GetBuildingCount(type));
+            }
+            ImGui::Text("Simulation   %.3f ms/tick, %.2f ms/frame", mPerformanceMonitor.GetAverageTickCost(), mPerformanceMonitor.GetAverageSimulationTime());
+        }
+        ImGui::End();
+    }
+
+    void GameLayer::DrawPlacementOverlay()
+    {
+        if (!mSelection.HasHover())
+            return;
+
+        Coordinate center = mSelection.GetHovered().value();
+
+        // member buffers, so after the first frame this allocates nothing
+        mPlacementOverlayCoords.clear();
+        for (i32 q = -PlacementOverlay_Radius; q <= PlacementOverlay_Radius; q++)
+        {
+            i32 r_min = std::max(-PlacementOverlay_Radius, -q - PlacementOverlay_Radius);
+            i32 r_max = std::min(PlacementOverlay_Radius, -q + PlacementOverlay_Radius);
+            for (i32 r = r_min; r <= r_max; r++)
+            {
+                mPlacementOverlayCoords.push_back(center + Coordinate(q, r));
+            }
+        }
+
+        mPlacementOverlayResults.resize(mPlacementOverlayCoords.size());
+        BuildingManager::Get().CheckPlacement(mSelectedBuildingType, mPlacementOverlayCoords, mMap, mPlacementOverlayResults);
+
+        const glm::mat4& view_projection = Renderer::GetViewProjectionMatrix();
+        ImGuiViewport* viewport = ImGui::GetMainViewport();
+        ImDrawList* draw_list = ImGui::GetBackgroundDrawList();
+
+        for (usize i = 0; i < mPlacementOverlayCoords.size(); i++)
+        {
+            PlacementResult result = mPlacementOverlayResults[i];
+            if (result == PlacementResult::NoTile || result == PlacementResult::Occupied)
+                continue;
+
+            glm::vec3 tile_center = mPlacementOverlayCoords[i].ToWorldPosition(0.02f);
+
+            ImVec2 points[6];
+            bool visible = true;
+            for (i32 corner = 0; corner < 6 && visible; corner++)
+            {
+                f32 angle = glm::radians(60.0f * corner + 30.0f);
+                glm::vec3 offset(std::cos(angle), 0.0f, std::sin(angle));
+                glm::vec4 clip = view_projection * glm::vec4(tile_center + offset * MODEL_SIZE * PlacementOverlay_HexScale, 1.0f);
+
+                visible = clip.w > 0.0f;
+                glm::vec2 ndc = glm::vec2(clip.x, clip.y) / clip.w;
+                points[corner] = ImVec2(viewport->Pos.x + (ndc.x * 0.5f + 0.5f) * viewport->Size.x,
+                                        viewport->Pos.y + (0.5f - ndc.y * 0.5f) * viewport->Size.y);
+            }
+
+            if (!visible)
+                continue;
+
+            ImU32 color = result == PlacementResult::Valid ? IM_COL32(40, 220, 60, 70) : IM_COL32(220, 50, 40, 50);
+            draw_list->AddConvexPolyFilled(points, 6, color);
+        }
     }
 
     void GameLayer::DrawActionBar(ImVec2* out_pos, ImVec2* out_size)
@@ -597,10 +1050,12 @@ namespace RealmFortress
                     {
                         if (ImGui::BeginTable("CostList", static_cast<int>(ResourceType::Count), ImGuiTableFlags_SizingFixedFit))
                         {
-                            auto cost = definition.ConstructionCost;
+                            const auto& cost = definition.ConstructionCost;
 
-                            for (auto [resource, amount] : cost)
+                            for (u8 i = 0; i < static_cast<u8>(ResourceType::Count); i++)
                             {
+                                ResourceType resource = static_cast<ResourceType>(i);
+                                i32 amount = cost[resource];
                                 if (amount <= 0) continue;
 
                                 ImGui::TableNextColumn();
@@ -714,11 +1169,20 @@ namespace RealmFortress
                 ImGuiTableFlags table_flags = ImGuiTableFlags_RowBg
                                             | ImGuiTableFlags_BordersInnerH
                                             | ImGuiTableFlags_SizingStretchProp;
-                if (ImGui::BeginTable("EconomyPanelTable", 3, table_flags))
+                ResourceTelemetry& telemetry = ResourceTelemetry::Get();
+                ResourceTelemetry::RateTable rates[std::size(EconomyPanel_RateWindows)];
+                for (usize w = 0; w < std::size(EconomyPanel_RateWindows); w++)
+                {
+                    telemetry.ComputeRates(EconomyPanel_RateWindows[w], rates[w]);
+                }
+                const ResourceTelemetry::RateTable& rates_10s = rates[1];
+
+                if (ImGui::BeginTable("EconomyPanelTable", 4, table_flags))
                 {
                     ImGui::TableSetupColumn("Icon", ImGuiTableColumnFlags_WidthFixed, 32.0f);
                     ImGui::TableSetupColumn("Resource");
                     ImGui::TableSetupColumn("Amount", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+                    ImGui::TableSetupColumn("Rate", ImGuiTableColumnFlags_WidthFixed, 100.0f);
 
                     for (u8 i = 0; i < static_cast<u8>(ResourceType::Count); i++)
                     {
@@ -740,11 +1204,66 @@ namespace RealmFortress
                         // Amount
                         ImGui::TableSetColumnIndex(2);
                         ImGui::Text("%d", amount);
+
+                        // Net rate over the last 10 seconds
+                        ImGui::TableSetColumnIndex(3);
+                        f32 net_rate = ResourceTelemetry::GetNetRate(rates_10s, resource);
+                        ImVec4 rate_color = net_rate >= 0.0f ? ImVec4(0.55f, 0.85f, 0.45f, 1.0f) : ImVec4(0.9f, 0.4f, 0.35f, 1.0f);
+                        ImGui::TextColored(rate_color, "%+.1f/s", net_rate);
                         ImGui::SetWindowFontScale(1.0f);
+
+                        if (ImGui::IsItemHovered())
+                        {
+                            ImGui::BeginTooltip();
+                            for (usize source = 0; source < ResourceTelemetry::SourceCount; source++)
+                            {
+                                BuildingType type = static_cast<BuildingType>(source);
+                                const char* name = type == BuildingType::Count ? "Other" : GetBuildingDefinition(type).Name;
+                                for (usize flow = 0; flow < ResourceTelemetry::FlowCount; flow++)
+                                {
+                                    f32 rate = ResourceTelemetry::GetRate(rates_10s, type, static_cast<ResourceFlow>(flow), resource);
+                                    if (rate != 0.0f)
+                                    {
+                                        ImGui::Text("%s %s: %.2f/s", name, ResourceFlowToString(static_cast<ResourceFlow>(flow)), rate);
+                                    }
+                                }
+                            }
+                            ImGui::EndTooltip();
+                        }
                     }
 
                     ImGui::EndTable();
                 }
+
+                ImGui::Spacing();
+                ImGui::Separator();
+                ImGui::Spacing();
+
+                // net change per second over the last minute, with the rolling averages on top
+                std::array<f32, ResourceTelemetry::HistorySeconds> history;
+                for (u8 i = 0; i < static_cast<u8>(ResourceType::Count); i++)
+                {
+                    ResourceType resource = static_cast<ResourceType>(i);
+                    usize count = telemetry.GetHistory(resource, history);
+                    usize shown = std::min<usize>(count, 60);
+
+                    char overlay[96];
+                    std::snprintf(overlay, sizeof(overlay), "%s  1s %+.1f  10s %+.1f  60s %+.1f", ResourceTypeToString(resource),
+                                  ResourceTelemetry::GetNetRate(rates[0], resource),
+                                  ResourceTelemetry::GetNetRate(rates[1], resource),
+                                  ResourceTelemetry::GetNetRate(rates[2], resource));
+
+                    ImGui::PushID(i);
+                    ImGui::PlotLines("##Trend", history.data() + (count - shown), static_cast<i32>(shown), 0, overlay, FLT_MAX, FLT_MAX,
+                                     ImVec2(ImGui::GetContentRegionAvail().x, EconomyPanel_PlotHeight));
+                    ImGui::PopID();
+
+                    f32 lost_rate = ResourceTelemetry::GetTotalRate(rates[2], ResourceFlow::Lost, resource);
+                    if (lost_rate > 0.0f)
+                    {
+                        ImGui::TextColored(ImVec4(0.9f, 0.6f, 0.3f, 1.0f), "Warehouse full: losing %.1f %s/s", lost_rate, ResourceTypeToString(resource));
+                    }
+                }
             }
             ImGui::EndChild();
             ImGui::PopStyleColor();
@@ -794,7 +1313,16 @@ namespace RealmFortress
                 ImGui::Separator();
 
                 // Building Specific
-                mInspectedBuilding->OnInspected();
+                if (mInspectedBuilding->IsUnderConstruction())
+                {
+                    f32 progress = mInspectedBuilding->GetConstructionProgress();
+                    ImGui::Text("Under Construction");
+                    ImGui::ProgressBar(progress, ImVec2(-1, 0));
+                }
+                else
+                {
+                    mInspectedBuilding->OnInspected();
+                }
 
                 // Action Buttons
                 ImGui::Spacing();
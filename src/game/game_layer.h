@@ -8,16 +8,21 @@
 
 #include "core/base.h"
 #include "core/layer.h"
+#include "core/memory_tracker.h"
 #include "renderer/shader.h"
 #include "renderer/vertex_array.h"
 #include "events/event.h"
 #include "events/mouse_event.h"
 #include "events/key_event.h"
 #include "game/system/camera_controller.h"
+#include "game/system/flythrough_benchmark.h"
+#include "game/system/performance_monitor.h"
 #include "game/system/picker.h"
 #include "game/system/selection.h"
+#include "game/system/simulation_clock.h"
 #include "game/resource/warehouse.h"
 #include "game/building/building_manager.h"
+#include "game/asset_preloader.h"
 #include "map/map.h"
 
 struct ImVec2;
@@ -49,22 +54,27 @@ namespace RealmFortress
     class GameLayer final : public Layer
     {
     public:
-        GameLayer();
+        // a non-empty script runs the flythrough benchmark instead of taking input, then quits
+        explicit GameLayer(const std::filesystem::path& benchmark_script = {});
         ~GameLayer() override = default;
 
         void OnAttach() override;
         void OnDetach() override;
 
         void OnUpdate(Timestep ts) override;
+        void OnSuspended(Timestep ts) override;
         void OnImGuiRender() override;
-        void OnEvent(Event& event) override;
 
     private:
+        void RegisterInputHandlers();
         bool OnMouseButtonPressed(MouseButtonPressedEvent& event);
         bool OnMouseMoved(MouseMovedEvent& event);
+        bool OnMouseScrolled(MouseScrolledEvent& event);
         bool OnKeyPressed(KeyPressedEvent& event);
 
         void UpdateSelection();
+        void SimulationTick(Timestep ts);
+        void FastForward(f64 duration);
 
         void EnterBuildMode(BuildingType type);
         void ExitBuildMode();
@@ -74,7 +84,10 @@ namespace RealmFortress
         // UI
         void SetupTheme();
 
+        void DrawLoadingScreen();
         void DrawTimeHUD();
+        void DrawPerformanceOverlay();
+        void DrawPlacementOverlay();
         void DrawActionBar(ImVec2* out_pos, ImVec2* out_size);
         void DrawBuildingPanel(ImVec2 action_bar_pos, ImVec2 action_bar_size, ImVec2* out_pos, ImVec2* out_size);
         void DrawBuildConfirmPanel(ImVec2 building_panel_pos, ImVec2 building_panel_size);
@@ -89,6 +102,9 @@ namespace RealmFortress
 
         Ref<CameraController> mCameraController;
 
+        AssetPreloader mAssetPreloader;
+        bool mAssetsLoaded{ false };
+
         Map mMap;
 
         Picker mPicker;
@@ -98,12 +114,19 @@ namespace RealmFortress
         i16 mUIPanelFlags{ 0 };
         std::optional<BuildingType> mSelectedBuildingToConfirm;
 
-        f32 mGameTime{ 0.0f };
-        i32 mGameDay{ 1 };
-        f32 mTimeSpeed{ 1.0f };
+        SimulationClock mSimulationClock;
+        f64 mSuspendedTime{ 0.0 };
+        bool mValidateFastForward{ false };
+
+        PerformanceMonitor mPerformanceMonitor;
+        bool mShowPerformanceOverlay{ false };
+        std::optional<MemorySnapshot> mMemorySnapshot;
+        Scope<FlythroughBenchmark> mFlythrough;
 
         GameMode mGameMode{ GameMode::Normal };
         BuildingType mSelectedBuildingType{ BuildingType::Mine };
+        std::vector<Coordinate> mPlacementOverlayCoords;
+        std::vector<PlacementResult> mPlacementOverlayResults;
         Building* mInspectedBuilding{ nullptr };
 
         Ref<VertexArray> mSelectionRingVA;
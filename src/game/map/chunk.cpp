@@ -6,6 +6,8 @@
 
 #include "core/pch.h"
 #include "chunk.h"
+#include "core/memory_tracker.h"
+#include "core/profiler.h"
 #include "game/map/perlin_noise.h"
 #include "renderer/model_cache.h"
 
@@ -59,6 +61,30 @@ namespace RealmFortress
     {
     }
 
+    Chunk::~Chunk()
+    {
+        ReleaseModels();
+    }
+
+    Chunk::Chunk(Chunk&& other) noexcept
+        : mCoord(other.mCoord), mTiles(std::move(other.mTiles)), mModelReferences(std::move(other.mModelReferences))
+    {
+        other.mModelReferences.clear();
+    }
+
+    Chunk& Chunk::operator=(Chunk&& other) noexcept
+    {
+        if (this != &other)
+        {
+            ReleaseModels();
+            mCoord = other.mCoord;
+            mTiles = std::move(other.mTiles);
+            mModelReferences = std::move(other.mModelReferences);
+            other.mModelReferences.clear();
+        }
+        return *this;
+    }
+
     static f32 HashToAngle(u32 seed, i32 q, i32 r)
     {
         u32 h = seed;
@@ -70,6 +96,10 @@ namespace RealmFortress
 
     void Chunk::Generate(u32 seed)
     {
+        RF_PROFILE_SCOPE("Chunk::Generate");
+        RF_MEMORY_TAG(MemoryTag::Map);
+
+        ReleaseModels();
         mTiles.clear();
 
         PerlinNoise elevation_noise(seed);
@@ -98,7 +128,7 @@ namespace RealmFortress
                 Tile tile(Coordinate(global_q, global_r), type, "", height);
 
                 std::string model_path = TileTypeToModelPath(type);
-                tile.SetModel(ModelCache::Load(model_path));
+                tile.SetModel(ModelCache::Load(model_path, VertexFormat::Standard));
                 tile.SetDecoration(deco);
 
                 if (deco != DecorationType::None)
@@ -110,6 +140,8 @@ namespace RealmFortress
                 mTiles[local_coord] = std::move(tile);
             }
         }
+
+        AcquireModels();
     }
 
     Tile* Chunk::GetTile(const Coordinate& local_coord)
@@ -117,4 +149,28 @@ namespace RealmFortress
         auto it = mTiles.find(local_coord);
         return it != mTiles.end() ? &it->second : nullptr;
     }
+
+    void Chunk::AcquireModels()
+    {
+        for (const auto& tile : mTiles | std::views::values)
+        {
+            for (ModelHandle handle : { tile.GetModel(), tile.GetDecorationModel() })
+            {
+                if (handle != NullModelHandle && std::ranges::find(mModelReferences, handle) == mModelReferences.end())
+                {
+                    ModelCache::Acquire(handle);
+                    mModelReferences.push_back(handle);
+                }
+            }
+        }
+    }
+
+    void Chunk::ReleaseModels()
+    {
+        for (ModelHandle handle : mModelReferences)
+        {
+            ModelCache::Release(handle);
+        }
+        mModelReferences.clear();
+    }
 } // namespace RealmFortress
@@ -9,6 +9,7 @@
 #include "core/base.h"
 #include "game/system/tile.h"
 #include <unordered_map>
+#include <vector>
 
 namespace RealmFortress
 {
@@ -32,6 +33,12 @@ namespace RealmFortress
     {
     public:
         Chunk(ChunkCoordinate coord);
+        ~Chunk();
+
+        Chunk(const Chunk&) = delete;
+        Chunk& operator=(const Chunk&) = delete;
+        Chunk(Chunk&& other) noexcept;
+        Chunk& operator=(Chunk&& other) noexcept;
 
         void Generate(u32 seed);
 
@@ -40,8 +47,15 @@ namespace RealmFortress
 
         ChunkCoordinate GetCoordinate() const { return mCoord; }
 
+    private:
+        void AcquireModels();
+        void ReleaseModels();
+
     private:
         ChunkCoordinate mCoord;
         std::unordered_map<Coordinate, Tile> mTiles;
+
+        // one reference per distinct model the tiles use, keeps them out of cache eviction
+        std::vector<ModelHandle> mModelReferences;
     };
 } // namespace RealmFortress
@@ -6,6 +6,9 @@
 
 #include "core/pch.h"
 #include "map.h"
+#include "core/job_system.h"
+#include "core/memory_tracker.h"
+#include "core/profiler.h"
 #include "game/map/perlin_noise.h"
 #include "renderer/model_cache.h"
 
@@ -18,7 +21,11 @@ namespace RealmFortress
 
     void Map::OnUpdate(const glm::vec3& camera_position)
     {
+        RF_PROFILE_SCOPE("Map::OnUpdate");
+        RF_MEMORY_TAG(MemoryTag::Map);
+
         mLastCameraPos = camera_position;
+        mLoadedChunks.clear();
 
         Coordinate center = Coordinate::FromWorldPosition(camera_position);
 
@@ -67,16 +74,33 @@ namespace RealmFortress
             return a.DistSq < b.DistSq;
         });
 
-        i32 loaded_count = 0;
-        for (const auto& missing : missing_chunks)
+        // chunks generate independently, so every thread in the pool takes its share of the
+        // per-frame budget and the frame waits about as long as for a single chunk
+        usize budget = mChunkBudget > 0 ? mChunkBudget : static_cast<usize>(mChunksLoadedPerFrame) * (JobSystem::GetWorkerCount() + 1);
+        usize load_count = std::min<usize>(missing_chunks.size(), budget);
+
+        mPendingChunkCount = missing_chunks.size() - load_count;
+
+        std::vector<Chunk> new_chunks;
+        new_chunks.reserve(load_count);
+        for (usize i = 0; i < load_count; i++)
         {
-            if (loaded_count >= mChunksLoadedPerFrame) break;
+            new_chunks.emplace_back(missing_chunks[i].Coord);
+        }
 
-            Chunk new_chunk(missing.Coord);
-            new_chunk.Generate(mSeed);
-            mChunks.emplace(missing.Coord, std::move(new_chunk));
+        JobSystem::ParallelFor(new_chunks.size(), 1, [&](usize, usize begin, usize end)
+        {
+            for (usize i = begin; i < end; i++)
+            {
+                new_chunks[i].Generate(mSeed);
+            }
+        });
 
-            loaded_count++;
+        for (Chunk& new_chunk : new_chunks)
+        {
+            ChunkCoordinate coord = new_chunk.GetCoordinate();
+            mChunks.emplace(coord, std::move(new_chunk));
+            mLoadedChunks.push_back(coord);
         }
     }
 
@@ -84,6 +108,8 @@ namespace RealmFortress
     {
         mSeed = seed;
         mChunks.clear();
+        mLoadedChunks.clear();
+        mPendingChunkCount = 0;
         RF_CORE_INFO("Map cleared and seed updated to {}", mSeed);
     }
 
@@ -109,25 +135,22 @@ namespace RealmFortress
         return GetTile(coord) != nullptr;
     }
 
-    std::vector<const Tile*> Map::GetNeighbors(const Coordinate& coord) const
+    // shared by the frame-allocated and the caller-owned overloads
+    template<typename Container>
+    static void AppendNeighbors(const Map& map, const Coordinate& coord, Container& out)
     {
-        std::vector<const Tile*> neighbors;
-        auto neighbor_coords = coord.GetNeighbors();
-
-        for (const auto& nc : neighbor_coords)
+        for (const auto& nc : coord.GetNeighbors())
         {
-            if (auto* tile = GetTile(nc))
+            if (auto* tile = map.GetTile(nc))
             {
-                neighbors.push_back(tile);
+                out.push_back(tile);
             }
         }
-        return neighbors;
     }
 
-    std::vector<const Tile*> Map::GetTilesInRadius(const Coordinate& center, i32 radius) const
+    template<typename Container>
+    static void AppendTilesInRadius(const Map& map, const Coordinate& center, i32 radius, Container& out)
     {
-        std::vector<const Tile*> tiles;
-
         for (i32 q = -radius; q <= radius; ++q)
         {
             i32 r1 = std::max(-radius, -q - radius);
@@ -136,16 +159,38 @@ namespace RealmFortress
             for (i32 r = r1; r <= r2; ++r)
             {
                 Coordinate coord = center + Coordinate(q, r);
-                if (auto* tile = GetTile(coord))
+                if (auto* tile = map.GetTile(coord))
                 {
-                    tiles.push_back(tile);
+                    out.push_back(tile);
                 }
             }
         }
+    }
+
+    FrameVector<const Tile*> Map::GetNeighbors(const Coordinate& coord) const
+    {
+        auto neighbors = MakeFrameVector<const Tile*>(static_cast<usize>(Direction::Count));
+        AppendNeighbors(*this, coord, neighbors);
+        return neighbors;
+    }
+
+    void Map::GetNeighbors(const Coordinate& coord, std::vector<const Tile*>& out) const
+    {
+        AppendNeighbors(*this, coord, out);
+    }
 
+    FrameVector<const Tile*> Map::GetTilesInRadius(const Coordinate& center, i32 radius) const
+    {
+        auto tiles = MakeFrameVector<const Tile*>(static_cast<usize>(3 * radius * (radius + 1) + 1));
+        AppendTilesInRadius(*this, center, radius, tiles);
         return tiles;
     }
 
+    void Map::GetTilesInRadius(const Coordinate& center, i32 radius, std::vector<const Tile*>& out) const
+    {
+        AppendTilesInRadius(*this, center, radius, out);
+    }
+
     std::vector<const Tile*> Map::GetTilesInLine(const Coordinate& start, const Coordinate& end) const
     {
         std::vector<const Tile*> tiles;
@@ -164,6 +209,8 @@ namespace RealmFortress
 
     void Map::Draw(const Ref<Shader>& shader)
     {
+        RF_PROFILE_SCOPE("Map::Draw");
+
         if (!shader)
         {
             RF_CORE_ERROR("Cannot draw map: shader is null");
@@ -175,8 +222,22 @@ namespace RealmFortress
         shader->SetFloat("uFogEnd", 130.0f);
         shader->SetFloat3("uFogColor", glm::vec3(0.53f, 0.81f, 0.92f));
 
-        std::map<Model*, std::vector<glm::mat4>> batch_data;
+        // instance lists are rebuilt every frame, so they live in the frame arena
+        DrawBatches batch_data(FrameAllocator::GetResource());
+        BuildDrawBatches(batch_data);
 
+        for (auto& [handle, transforms] : batch_data)
+        {
+            Model* model = ModelCache::Get(handle);
+            if (model && !transforms.empty())
+            {
+                model->DrawInstanced(shader, transforms);
+            }
+        }
+    }
+
+    void Map::BuildDrawBatches(DrawBatches& out_batches) const
+    {
         f32 max_draw_dist_sq = 140.0f * 140.0f;
 
         for (const auto& [chunk_coord, chunk] : mChunks)
@@ -189,25 +250,17 @@ namespace RealmFortress
             for (const auto& tile : chunk.GetTiles() | std::views::values)
             {
                 // Draw Base Model
-                if (auto model = tile.GetModel())
-                    batch_data[model.get()].push_back(tile.GetTransform());
+                if (ModelHandle model = tile.GetModel())
+                    out_batches[model].push_back(tile.GetTransform());
 
                 // Draw Decoration
                 if (tile.GetDecoration() != DecorationType::None)
                 {
-                    if (auto deco_model = tile.GetDecorationModel())
-                        batch_data[deco_model.get()].push_back(tile.GetDecorationTransform());
+                    if (ModelHandle deco_model = tile.GetDecorationModel())
+                        out_batches[deco_model].push_back(tile.GetDecorationTransform());
                 }
             }
         }
-
-        for (auto& [model_ptr, transforms] : batch_data)
-        {
-            if (model_ptr && !transforms.empty())
-            {
-                model_ptr->DrawInstanced(shader, transforms);
-            }
-        }
     }
 
     usize Map::GetTileCount() const
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "core/base.h"
+#include "core/frame_allocator.h"
 #include "game/system/tile.h"
 #include "game/system/coordinate.h"
 #include "game/map/chunk.h"
@@ -29,12 +30,29 @@ namespace RealmFortress
         Tile* GetTile(const Coordinate& coord);
         const Tile* GetTile(const Coordinate& coord) const;
         bool HasTile(const Coordinate& coord) const;
-        std::vector<const Tile*> GetNeighbors(const Coordinate& coord) const;
-        std::vector<const Tile*> GetTilesInRadius(const Coordinate& center, i32 radius) const;
+        // frame-allocated, valid until the next Renderer::BeginFrame; don't keep the result
+        // past the frame, use the overloads that append to a caller-owned vector for that
+        FrameVector<const Tile*> GetNeighbors(const Coordinate& coord) const;
+        void GetNeighbors(const Coordinate& coord, std::vector<const Tile*>& out) const;
+        FrameVector<const Tile*> GetTilesInRadius(const Coordinate& center, i32 radius) const;
+        void GetTilesInRadius(const Coordinate& center, i32 radius, std::vector<const Tile*>& out) const;
         std::vector<const Tile*> GetTilesInLine(const Coordinate& start, const Coordinate& end) const;
         usize GetTileCount() const;
 
+        // chunks generated by the last OnUpdate
+        const std::vector<ChunkCoordinate>& GetLoadedChunks() const { return mLoadedChunks; }
+        usize GetChunkCount() const { return mChunks.size(); }
+        // in render distance but not generated yet, as of the last OnUpdate
+        usize GetPendingChunkCount() const { return mPendingChunkCount; }
+        // chunks generated per OnUpdate regardless of the worker count; 0 scales with the pool
+        void SetChunkBudget(u32 chunks_per_update) { mChunkBudget = chunks_per_update; }
+
+        // instance transforms per model, frame-allocated
+        using DrawBatches = FrameMap<ModelHandle, FrameVector<glm::mat4>>;
+
         void Draw(const Ref<Shader>& shader);
+        // the CPU half of Draw: gathers every tile within draw distance, makes no GL calls
+        void BuildDrawBatches(DrawBatches& out_batches) const;
 
     private:
         ChunkCoordinate WorldToChunkCoord(const Coordinate& coord) const;
@@ -44,11 +62,14 @@ namespace RealmFortress
 
     private:
         std::unordered_map<ChunkCoordinate, Chunk, ChunkCoordHash> mChunks;
+        std::vector<ChunkCoordinate> mLoadedChunks;
+        usize mPendingChunkCount{ 0 };
         u32 mSeed{ 0 };
         i32 mRenderDistance{ 5 };
 
         glm::vec3 mLastCameraPos{ 0.0f };
 
         i32 mChunksLoadedPerFrame{ 1 };
+        u32 mChunkBudget{ 0 };
     };
 } // namespace RealmFortress
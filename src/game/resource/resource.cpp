@@ -7,28 +7,16 @@
 #include "core/base.h"
 #include "resource.h"
 
-#include <ranges>
-
 namespace RealmFortress
 {
-    ResourceStorage::ResourceStorage()
-    {
-        mStorages[ResourceType::Lumber] = 0;
-        mStorages[ResourceType::Stone] = 0;
-        mStorages[ResourceType::Wheat] = 0;
-    }
-
     void ResourceStorage::Add(ResourceType type, i32 amount)
     {
         mStorages[type] += amount;
     }
 
-    void ResourceStorage::Add(const ResourceCost& cost)
+    void ResourceStorage::Add(const ResourceVector& amounts)
     {
-        for (const auto& [type, amount] : cost)
-        {
-            mStorages[type] += amount;
-        }
+        mStorages += amounts;
     }
 
     bool ResourceStorage::Consume(ResourceType type, i32 amount)
@@ -42,17 +30,14 @@ namespace RealmFortress
         return true;
     }
 
-    bool ResourceStorage::Consume(const ResourceCost& cost)
+    bool ResourceStorage::Consume(const ResourceVector& amounts)
     {
-        if (!Has(cost))
+        if (!Has(amounts))
         {
             return false;
         }
 
-        for (const auto& [type, amount] : cost)
-        {
-            mStorages[type] -= amount;
-        }
+        mStorages -= amounts;
         return true;
     }
 
@@ -61,31 +46,18 @@ namespace RealmFortress
         return GetAmount(type) >= amount;
     }
 
-    bool ResourceStorage::Has(const ResourceCost& cost) const
+    bool ResourceStorage::Has(const ResourceVector& amounts) const
     {
-        for (const auto& [type, amount] : cost)
-        {
-            if (!Has(type, amount))
-            {
-                return false;
-            }
-        }
-        return true;
+        return mStorages.Covers(amounts);
     }
 
     i32 ResourceStorage::GetAmount(ResourceType type) const
     {
-        auto it = mStorages.find(type);
-        return it != mStorages.end() ? it->second : 0;
+        return mStorages[type];
     }
 
     i32 ResourceStorage::GetUsedSpace() const
     {
-        i32 used = 0;
-        for (const auto& [type, amount] : mStorages)
-        {
-            used += ResourceTypeToSpace(type) * amount;
-        }
-        return used;
+        return mStorages.Dot(RESOURCE_SPACE);
     }
 } // namespace RealmFortress
@@ -7,7 +7,8 @@
 #pragma once
 
 #include "core/base.h"
-#include <unordered_map>
+#include <array>
+#include <initializer_list>
 
 namespace RealmFortress
 {
@@ -20,8 +21,6 @@ namespace RealmFortress
         Count
     };
 
-    using ResourceCost = std::unordered_map<ResourceType, i32>;
-
     inline const char* ResourceTypeToString(ResourceType type)
     {
         switch (type)
@@ -33,7 +32,7 @@ namespace RealmFortress
         }
     }
 
-    inline i32 ResourceTypeToSpace(ResourceType type)
+    constexpr i32 ResourceTypeToSpace(ResourceType type)
     {
         switch (type)
         {
@@ -55,26 +54,117 @@ namespace RealmFortress
         }
     }
 
+    /**
+     * @class ResourceVector
+     * @brief One amount per ResourceType in a fixed array, indexed by the enum.
+     *
+     * Used for costs, storage and per-unit weights alike. Every operation is a fixed-length
+     * loop over ResourceType::Count lanes with no allocation, which the compiler unrolls.
+     */
+    class ResourceVector
+    {
+    public:
+        static constexpr usize Size = static_cast<usize>(ResourceType::Count);
+
+        struct Entry
+        {
+            ResourceType Type;
+            i32 Amount;
+        };
+
+        constexpr ResourceVector() = default;
+        constexpr ResourceVector(std::initializer_list<Entry> entries)
+        {
+            for (const Entry& entry : entries)
+            {
+                (*this)[entry.Type] += entry.Amount;
+            }
+        }
+
+        static constexpr ResourceVector Single(ResourceType type, i32 amount)
+        {
+            ResourceVector result;
+            result[type] = amount;
+            return result;
+        }
+
+        constexpr i32& operator[](ResourceType type) { return mAmounts[static_cast<usize>(type)]; }
+        constexpr i32 operator[](ResourceType type) const { return mAmounts[static_cast<usize>(type)]; }
+
+        constexpr ResourceVector& operator+=(const ResourceVector& other)
+        {
+            for (usize i = 0; i < Size; i++) mAmounts[i] += other.mAmounts[i];
+            return *this;
+        }
+
+        constexpr ResourceVector& operator-=(const ResourceVector& other)
+        {
+            for (usize i = 0; i < Size; i++) mAmounts[i] -= other.mAmounts[i];
+            return *this;
+        }
+
+        constexpr ResourceVector& operator*=(i32 scale)
+        {
+            for (usize i = 0; i < Size; i++) mAmounts[i] *= scale;
+            return *this;
+        }
+
+        friend constexpr ResourceVector operator+(ResourceVector a, const ResourceVector& b) { return a += b; }
+        friend constexpr ResourceVector operator-(ResourceVector a, const ResourceVector& b) { return a -= b; }
+        friend constexpr ResourceVector operator*(ResourceVector a, i32 scale) { return a *= scale; }
+
+        constexpr bool operator==(const ResourceVector& other) const = default;
+
+        // true when every lane is at least the other's, i.e. this can pay for other
+        constexpr bool Covers(const ResourceVector& other) const
+        {
+            bool covers = true;
+            for (usize i = 0; i < Size; i++) covers &= mAmounts[i] >= other.mAmounts[i];
+            return covers;
+        }
+
+        constexpr i32 Dot(const ResourceVector& other) const
+        {
+            i32 sum = 0;
+            for (usize i = 0; i < Size; i++) sum += mAmounts[i] * other.mAmounts[i];
+            return sum;
+        }
+
+        constexpr bool IsZero() const { return *this == ResourceVector{}; }
+
+        constexpr const std::array<i32, Size>& GetAmounts() const { return mAmounts; }
+
+    private:
+        std::array<i32, Size> mAmounts{};
+    };
+
+    // storage space one unit of each resource takes in the warehouse
+    constexpr ResourceVector RESOURCE_SPACE = {
+        { ResourceType::Lumber, ResourceTypeToSpace(ResourceType::Lumber) },
+        { ResourceType::Stone,  ResourceTypeToSpace(ResourceType::Stone) },
+        { ResourceType::Wheat,  ResourceTypeToSpace(ResourceType::Wheat) },
+    };
+
     class ResourceStorage
     {
     public:
-        ResourceStorage();
+        ResourceStorage() = default;
 
         void Add(ResourceType type, i32 amount);
-        void Add(const ResourceCost& cost);
+        void Add(const ResourceVector& amounts);
 
         bool Consume(ResourceType type, i32 amount);
-        bool Consume(const ResourceCost& cost);
+        bool Consume(const ResourceVector& amounts);
 
         bool Has(ResourceType type, i32 amount) const;
-        bool Has(const ResourceCost& cost) const;
+        bool Has(const ResourceVector& amounts) const;
 
         i32 GetAmount(ResourceType type) const;
         i32 GetUsedSpace() const;
 
-        const auto& GetAll() const { return mStorages; }
+        const ResourceVector& GetAll() const { return mStorages; }
 
     private:
-        std::unordered_map<ResourceType, i32> mStorages;
+        ResourceVector mStorages;
     };
 } // namespace RealmFortress
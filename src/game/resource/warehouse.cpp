@@ -15,21 +15,26 @@ namespace RealmFortress
 
     bool Warehouse::Add(ResourceType type, i32 amount)
     {
-        ResourceCost cost;
-        cost[type] = amount;
+        i32 space_needed = ResourceTypeToSpace(type) * amount;
+        if (space_needed > mCapacity - mUsedSpace)
+        {
+            return false;
+        }
 
-        return Add(cost);
+        mStorage.Add(type, amount);
+        mUsedSpace += space_needed;
+        return true;
     }
 
-    bool Warehouse::Add(const ResourceCost& cost)
+    bool Warehouse::Add(const ResourceVector& amounts)
     {
-        if (!CanFit(cost))
+        if (!CanFit(amounts))
         {
             return false;
         }
 
-        mStorage.Add(cost);
-        RecalculateUsedSpace();
+        mStorage.Add(amounts);
+        mUsedSpace += amounts.Dot(RESOURCE_SPACE);
         return true;
     }
 
@@ -37,16 +42,16 @@ namespace RealmFortress
     {
         bool success = mStorage.Consume(type, amount);
         if (success)
-            RecalculateUsedSpace();
+            mUsedSpace -= ResourceTypeToSpace(type) * amount;
 
         return success;
     }
 
-    bool Warehouse::Consume(const ResourceCost& cost)
+    bool Warehouse::Consume(const ResourceVector& amounts)
     {
-        bool success = mStorage.Consume(cost);
+        bool success = mStorage.Consume(amounts);
         if (success)
-            RecalculateUsedSpace();
+            mUsedSpace -= amounts.Dot(RESOURCE_SPACE);
 
         return success;
     }
@@ -56,21 +61,15 @@ namespace RealmFortress
         return mStorage.Has(type, amount);
     }
 
-    bool Warehouse::Has(const ResourceCost& cost) const
+    bool Warehouse::Has(const ResourceVector& amounts) const
     {
-        return mStorage.Has(cost);
+        return mStorage.Has(amounts);
     }
 
-    bool Warehouse::CanFit(const ResourceCost& cost) const
+    bool Warehouse::CanFit(const ResourceVector& amounts) const
     {
-        i32 space_needed = 0;
-        for (const auto& [type, amount] : cost)
-        {
-            space_needed += ResourceTypeToSpace(type) * amount;
-        }
-
         i32 remaining_space = mCapacity - mUsedSpace;
-        return space_needed <= remaining_space;
+        return amounts.Dot(RESOURCE_SPACE) <= remaining_space;
     }
 
     i32 Warehouse::GetAmount(ResourceType type) const
@@ -98,13 +97,15 @@ namespace RealmFortress
         mCapacity += amount;
     }
 
-    Warehouse::Warehouse()
-        : mUsedSpace(0), mCapacity(500)
+    void Warehouse::RestoreState(const State& state)
     {
+        mStorage = state.Storage;
+        mUsedSpace = state.UsedSpace;
+        mCapacity = state.Capacity;
     }
 
-    void Warehouse::RecalculateUsedSpace()
+    Warehouse::Warehouse()
+        : mUsedSpace(0), mCapacity(500)
     {
-        mUsedSpace = mStorage.GetUsedSpace();
     }
 } // namespace RealmFortress
@@ -15,6 +15,13 @@ namespace RealmFortress
     class Warehouse
     {
     public:
+        struct State
+        {
+            ResourceStorage Storage;
+            i32 UsedSpace;
+            i32 Capacity;
+        };
+
         static Warehouse& Get()
         {
             static Warehouse instance;
@@ -27,15 +34,15 @@ namespace RealmFortress
         void OnUpdate(Timestep ts);
 
         bool Add(ResourceType type, i32 amount);
-        bool Add(const ResourceCost& cost);
+        bool Add(const ResourceVector& amounts);
 
         bool Consume(ResourceType type, i32 amount);
-        bool Consume(const ResourceCost& cost);
+        bool Consume(const ResourceVector& amounts);
 
         bool Has(ResourceType type, i32 amount) const;
-        bool Has(const ResourceCost& cost) const;
+        bool Has(const ResourceVector& amounts) const;
 
-        bool CanFit(const ResourceCost& cost) const;
+        bool CanFit(const ResourceVector& amounts) const;
 
         i32 GetAmount(ResourceType type) const;
         i32 GetUsedSpace() const;
@@ -44,11 +51,12 @@ namespace RealmFortress
 
         void IncreaseCapacity(i32 amount);
 
+        State SaveState() const { return { mStorage, mUsedSpace, mCapacity }; }
+        void RestoreState(const State& state);
+
     private:
         Warehouse();
 
-        void RecalculateUsedSpace();
-
     private:
         ResourceStorage mStorage;
         i32 mUsedSpace;
@@ -66,18 +66,23 @@ namespace RealmFortress
         UpdateCameraView();
     }
 
-    void CameraController::OnEvent(Event& event)
-    {
-        EventDispatcher dispatcher(event);
-        dispatcher.Dispatch<MouseScrolledEvent>(RF_BIND_EVENT_FN(CameraController::OnMouseScrolled));
-    }
-
     void CameraController::SetAspectRatio(f32 aspect_ratio)
     {
         mAspectRatio = aspect_ratio;
         mCamera.SetProjection(mFOV, mAspectRatio, 0.1f, 1000.0f);
     }
 
+    void CameraController::SetView(const glm::vec3& focal_point, f32 yaw, f32 pitch, f32 distance)
+    {
+        mFocalPoint = focal_point;
+        mYaw = yaw;
+        mPitch = std::clamp(pitch, MIN_PITCH, MAX_PITCH);
+        mDistance = std::clamp(distance, MIN_DISTANCE, MAX_DISTANCE);
+        mTargetDistance = mDistance;
+
+        UpdateCameraView();
+    }
+
     bool CameraController::OnMouseScrolled(MouseScrolledEvent& event)
     {
         mTargetDistance -= event.GetYOffset() * mZoomSpeed;
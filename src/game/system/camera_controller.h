@@ -18,7 +18,7 @@ namespace RealmFortress
         CameraController(f32 aspect_ratio);
 
         void OnUpdate(Timestep ts);
-        void OnEvent(Event& event);
+        bool OnMouseScrolled(class MouseScrolledEvent& event);
 
         PerspectiveCamera& GetCamera() { return mCamera; }
         const PerspectiveCamera& GetCamera() const { return mCamera; }
@@ -26,9 +26,10 @@ namespace RealmFortress
 
         void SetAspectRatio(f32 aspect_ratio);
         void SetFocalPoint(const glm::vec3& point) { mFocalPoint = point; }
+        // jumps straight there, without input or zoom smoothing; for scripted cameras
+        void SetView(const glm::vec3& focal_point, f32 yaw, f32 pitch, f32 distance);
 
     private:
-        bool OnMouseScrolled(class MouseScrolledEvent& event);
         bool OnWindowResize(class WindowResizeEvent& event);
 
         void UpdateCameraView();
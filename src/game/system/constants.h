@@ -17,4 +17,11 @@ namespace RealmFortress
 
     constexpr f32 ELEVATION_STEP = 0.5f;
     constexpr f32 BASE_HEIGHT = 0.0f;
+
+    // simulated seconds in one in-game day
+    constexpr f64 DAY_LENGTH = 240.0;
+
+    // simulated seconds collected while minimized before they are fast-forwarded; a few cycles
+    // of the fastest producer, so each analytic step covers more than its timer churn costs
+    constexpr f64 FAST_FORWARD_SUSPENDED_BATCH = 30.0;
 } // namespace RealmFortress
@@ -93,14 +93,13 @@ namespace RealmFortress
         return *this + DirectionVector(dir);
     }
 
-    std::vector<Coordinate> Coordinate::GetNeighbors() const noexcept
+    std::array<Coordinate, 6> Coordinate::GetNeighbors() const noexcept
     {
-        std::vector<Coordinate> neighbors;
-        neighbors.reserve(6);
+        std::array<Coordinate, 6> neighbors;
 
         for (u8 i = 0; i < static_cast<u8>(Direction::Count); ++i)
         {
-            neighbors.push_back(GetNeighbor(static_cast<Direction>(i)));
+            neighbors[i] = GetNeighbor(static_cast<Direction>(i));
         }
 
         return neighbors;
@@ -8,6 +8,8 @@
 
 #include "core/base.h"
 #include <glm/glm.hpp>
+#include <array>
+#include <vector>
 
 namespace RealmFortress
 {
@@ -44,7 +46,7 @@ namespace RealmFortress
         i32 DistanceTo(const Coordinate& other) const noexcept;
 
         Coordinate GetNeighbor(Direction dir) const noexcept;
-        std::vector<Coordinate> GetNeighbors() const noexcept;
+        std::array<Coordinate, 6> GetNeighbors() const noexcept;
 
         std::vector<Coordinate> LineTo(const Coordinate& target) const;
 
@@ -0,0 +1,230 @@
+/**
+ * @file economy.cpp
+ * @brief
+ * @date 12/22/2025
+ */
+
+#include "core/pch.h"
+#include "economy.h"
+#include "core/profiler.h"
+#include "game/system/scheduler.h"
+#include "game/system/resource_telemetry.h"
+#include "game/resource/warehouse.h"
+#include "game/building/building_manager.h"
+#include "game/building/production_system.h"
+#include "game/building/townhall.h"
+#include "game/map/map.h"
+
+namespace RealmFortress
+{
+    static constexpr f32 ValidationProgressTolerance = 0.02f;
+
+    struct EconomySnapshot
+    {
+        Scheduler::State SchedulerState;
+        ProductionSystem::State ProductionState;
+        Warehouse::State WarehouseState;
+        std::optional<Townhall::State> TownhallState;
+        ResourceTelemetry::State TelemetryState;
+    };
+
+    struct EconomyOutcome
+    {
+        f64 Time;
+        ResourceVector Amounts;
+        bool Starving;
+        std::vector<f32> Progress;
+    };
+
+    static Townhall* GetTownhall()
+    {
+        return static_cast<Townhall*>(BuildingManager::Get().GetFirstBuildingOfType(BuildingType::Townhall));
+    }
+
+    static EconomySnapshot SaveSnapshot()
+    {
+        EconomySnapshot snapshot{
+            Scheduler::Get().SaveState(),
+            ProductionSystem::Get().SaveState(),
+            Warehouse::Get().SaveState(),
+            std::nullopt,
+            ResourceTelemetry::Get().SaveState()
+        };
+
+        if (Townhall* townhall = GetTownhall())
+        {
+            snapshot.TownhallState = townhall->SaveState();
+        }
+        return snapshot;
+    }
+
+    static void RestoreSnapshot(const EconomySnapshot& snapshot)
+    {
+        Scheduler::Get().RestoreState(snapshot.SchedulerState);
+        ProductionSystem::Get().RestoreState(snapshot.ProductionState);
+        Warehouse::Get().RestoreState(snapshot.WarehouseState);
+        ResourceTelemetry::Get().RestoreState(snapshot.TelemetryState);
+
+        Townhall* townhall = GetTownhall();
+        if (townhall && snapshot.TownhallState)
+        {
+            townhall->RestoreState(*snapshot.TownhallState);
+        }
+    }
+
+    static EconomyOutcome CaptureOutcome()
+    {
+        Townhall* townhall = GetTownhall();
+        EconomyOutcome outcome{
+            Scheduler::Get().GetTime(),
+            Warehouse::Get().SaveState().Storage.GetAll(),
+            townhall && townhall->IsStarving(),
+            {}
+        };
+
+        for (const auto& building : BuildingManager::Get().GetAllBuildings())
+        {
+            if (building->IsProducer())
+            {
+                outcome.Progress.push_back(ProductionSystem::Get().GetProgress(building->GetProductionHandle()));
+            }
+        }
+        return outcome;
+    }
+
+    static void Step(Timestep ts, const Map& map)
+    {
+        Scheduler::Get().OnUpdate(ts);
+        Warehouse::Get().OnUpdate(ts);
+        BuildingManager::Get().OnUpdate(ts);
+        BuildingManager::Get().UpdateDependencies(map);
+    }
+
+    void Economy::Tick(Timestep ts, const Map& map)
+    {
+        RF_PROFILE_SCOPE("Economy::Tick");
+
+        Step(ts, map);
+        ResourceTelemetry::Get().EndTick(Scheduler::Get().GetTime());
+    }
+
+    FastForwardStats Economy::FastForward(f64 duration, const Map& map)
+    {
+        RF_PROFILE_SCOPE("Economy::FastForward");
+
+        Scheduler& scheduler = Scheduler::Get();
+        ProductionSystem& production = ProductionSystem::Get();
+        BuildingManager& building_manager = BuildingManager::Get();
+
+        FastForwardStats stats;
+        stats.Duration = duration;
+        if (duration <= 0.0)
+            return stats;
+
+        f64 end_time = scheduler.GetTime() + duration;
+        usize fired_before = scheduler.GetFiredCount();
+
+        // production timers are the bulk of the heap; without them only the events that can
+        // change the economy's course are left to split the span at
+        production.Suspend();
+
+        while (true)
+        {
+            u64 next_stamp;
+            f64 segment_start = scheduler.GetTime();
+            f64 segment_end = scheduler.GetNextDueTime(&next_stamp);
+            if (segment_end > end_time)
+            {
+                segment_end = end_time;
+                next_stamp = std::numeric_limits<u64>::max();
+            }
+            Timestep segment(static_cast<f32>(segment_end - segment_start));
+
+            stats.Cycles += production.AdvanceTo(segment_end, next_stamp);
+            Warehouse::Get().OnUpdate(segment);
+            building_manager.OnUpdate(segment);
+
+            scheduler.AdvanceTo(segment_end);
+            building_manager.UpdateDependencies(map);
+            stats.Segments++;
+
+            if (segment_end >= end_time)
+                break;
+        }
+
+        production.Resume();
+        ResourceTelemetry::Get().EndTick(scheduler.GetTime());
+
+        stats.Events = scheduler.GetFiredCount() - fired_before;
+        return stats;
+    }
+
+    bool Economy::ValidateFastForward(f64 duration, Timestep tick, const Map& map)
+    {
+        // finishing construction registers producers and links buildings, which a snapshot of
+        // the economy alone can't roll back
+        for (const auto& building : BuildingManager::Get().GetAllBuildings())
+        {
+            if (building->IsUnderConstruction())
+            {
+                RF_CORE_WARN_RATE_LIMITED("Fast-forward validation skipped: a building is under construction");
+                FastForward(duration, map);
+                return true;
+            }
+        }
+
+        EconomySnapshot snapshot = SaveSnapshot();
+
+        u64 ticks = static_cast<u64>(duration / tick.GetSeconds());
+        for (u64 i = 0; i < ticks; i++)
+        {
+            Step(tick, map);
+        }
+
+        f64 remainder = snapshot.SchedulerState.Time + duration - Scheduler::Get().GetTime();
+        if (remainder > 0.0)
+        {
+            Step(Timestep(static_cast<f32>(remainder)), map);
+        }
+
+        // the stepped run is rolled back along with its flows; anything recorded earlier this
+        // tick, such as a placement's cost, stays and the fast-forward is recorded on top
+        EconomyOutcome stepped = CaptureOutcome();
+        RestoreSnapshot(snapshot);
+
+        FastForwardStats stats = FastForward(stepped.Time - snapshot.SchedulerState.Time, map);
+        EconomyOutcome analytic = CaptureOutcome();
+
+        bool matches = true;
+        for (usize i = 0; i < static_cast<usize>(ResourceType::Count); i++)
+        {
+            ResourceType type = static_cast<ResourceType>(i);
+            if (stepped.Amounts[type] != analytic.Amounts[type])
+            {
+                RF_CORE_WARN("Fast-forward mismatch: {} is {} stepped, {} analytic", ResourceTypeToString(type), stepped.Amounts[type], analytic.Amounts[type]);
+                matches = false;
+            }
+        }
+
+        if (stepped.Starving != analytic.Starving)
+        {
+            RF_CORE_WARN("Fast-forward mismatch: townhall starving is {} stepped, {} analytic", stepped.Starving, analytic.Starving);
+            matches = false;
+        }
+
+        for (usize i = 0; i < stepped.Progress.size() && i < analytic.Progress.size(); i++)
+        {
+            if (std::abs(stepped.Progress[i] - analytic.Progress[i]) > ValidationProgressTolerance)
+            {
+                RF_CORE_WARN("Fast-forward mismatch: producer {} progress is {:.3f} stepped, {:.3f} analytic", i, stepped.Progress[i], analytic.Progress[i]);
+                matches = false;
+            }
+        }
+
+        if (matches)
+        {
+            RF_CORE_INFO("Fast-forward validated over {:.1f}s: {} ticks vs {} segments, {} cycles", stats.Duration, ticks, stats.Segments, stats.Cycles);
+        }
+        return matches;
+    }
+} // namespace RealmFortress
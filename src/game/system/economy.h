@@ -0,0 +1,46 @@
+/**
+ * @file economy.h
+ * @brief
+ * @date 12/22/2025
+ */
+
+#pragma once
+
+#include "core/base.h"
+#include "core/timestep.h"
+
+namespace RealmFortress
+{
+    class Map;
+
+    struct FastForwardStats
+    {
+        f64 Duration{ 0.0 };
+        u64 Cycles{ 0 };
+        usize Events{ 0 };
+        u32 Segments{ 0 };
+    };
+
+    /**
+     * @class Economy
+     * @brief Advances production, food and construction either one tick at a time or analytically.
+     *
+     * FastForward splits a span at every scheduled event that is not a production cycle (food
+     * cycles, finished construction). Between two such events nothing but production happens,
+     * so every producer's completed cycles are counted in closed form and credited at once;
+     * the events themselves then fire in order and dependent efficiencies are recomputed
+     * before the next segment. The cost grows with the number of events, not with the span.
+     */
+    class Economy
+    {
+    public:
+        // one fixed simulation step, what the game runs every tick
+        static void Tick(Timestep ts, const Map& map);
+
+        static FastForwardStats FastForward(f64 duration, const Map& map);
+
+        // runs the span tick by tick from a snapshot first, then restores it and fast-forwards,
+        // logging every difference; the fast-forwarded state is the one that is kept
+        static bool ValidateFastForward(f64 duration, Timestep tick, const Map& map);
+    };
+} // namespace RealmFortress
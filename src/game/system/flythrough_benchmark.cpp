@@ -0,0 +1,298 @@
+/**
+ * @file flythrough_benchmark.cpp
+ * @brief
+ * @date 12/22/2025
+ */
+
+#include "core/pch.h"
+#include "flythrough_benchmark.h"
+#include "core/application.h"
+#include "core/json.h"
+#include "core/logger.h"
+#include "core/statistics.h"
+#include <glad/gl.h>
+#include <fstream>
+#include <sstream>
+
+namespace RealmFortress
+{
+    namespace
+    {
+        struct Summary
+        {
+            f64 Mean = 0.0;
+            f64 P50 = 0.0;
+            f64 P95 = 0.0;
+            f64 P99 = 0.0;
+            f64 Max = 0.0;
+        };
+
+        Summary Summarize(std::vector<f64> values)
+        {
+            if (values.empty())
+                return {};
+
+            std::ranges::sort(values);
+
+            f64 sum = 0.0;
+            for (f64 value : values)
+                sum += value;
+
+            return { sum / static_cast<f64>(values.size()), SortedPercentile(values, 0.50), SortedPercentile(values, 0.95),
+                     SortedPercentile(values, 0.99), values.back() };
+        }
+
+        std::string FormatSummary(const char* name, const Summary& summary)
+        {
+            return std::format("    \"{}\": {{ \"mean\": {:.4f}, \"p50\": {:.4f}, \"p95\": {:.4f}, \"p99\": {:.4f}, \"max\": {:.4f} }}",
+                               name, summary.Mean, summary.P50, summary.P95, summary.P99, summary.Max);
+        }
+    }
+
+    FlythroughBenchmark::FlythroughBenchmark()
+    {
+        glCreateQueries(GL_TIME_ELAPSED, static_cast<GLsizei>(QueryCount), mQueries.data());
+        mQueryRecords.fill(-1);
+    }
+
+    FlythroughBenchmark::~FlythroughBenchmark()
+    {
+        glDeleteQueries(static_cast<GLsizei>(QueryCount), mQueries.data());
+    }
+
+    bool FlythroughBenchmark::Load(const std::filesystem::path& path)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            RF_CORE_ERROR("Could not open benchmark script {}", path.string());
+            return false;
+        }
+
+        mScriptPath = path;
+        mOutputPath = path.stem();
+        mKeyframes.clear();
+
+        std::string line;
+        u32 line_number = 0;
+        while (std::getline(file, line))
+        {
+            line_number++;
+            line = line.substr(0, line.find('#'));
+
+            std::istringstream stream(line);
+            std::string directive;
+            if (!(stream >> directive))
+                continue;
+
+            bool valid = true;
+            if (directive == "seed")
+            {
+                valid = static_cast<bool>(stream >> mSeed);
+            }
+            else if (directive == "step")
+            {
+                valid = static_cast<bool>(stream >> mStep) && mStep > 0.0f;
+            }
+            else if (directive == "output")
+            {
+                std::string output;
+                valid = static_cast<bool>(stream >> output);
+                mOutputPath = output;
+            }
+            else
+            {
+                CameraKeyframe keyframe;
+                std::istringstream keyframe_stream(line);
+                valid = static_cast<bool>(keyframe_stream >> keyframe.Time
+                                                          >> keyframe.FocalPoint.x >> keyframe.FocalPoint.y >> keyframe.FocalPoint.z
+                                                          >> keyframe.Yaw >> keyframe.Pitch >> keyframe.Distance);
+
+                if (valid && !mKeyframes.empty() && keyframe.Time <= mKeyframes.back().Time)
+                {
+                    RF_CORE_ERROR("{}:{}: keyframe times must increase", path.string(), line_number);
+                    return false;
+                }
+                mKeyframes.push_back(keyframe);
+            }
+
+            if (!valid)
+            {
+                RF_CORE_ERROR("{}:{}: could not parse '{}'", path.string(), line_number, line);
+                return false;
+            }
+        }
+
+        if (mKeyframes.size() < 2)
+        {
+            RF_CORE_ERROR("{}: a flythrough needs at least two keyframes", path.string());
+            return false;
+        }
+
+        RF_CORE_INFO("Benchmark script {}: {} keyframes over {:.1f}s, seed {}",
+                     path.string(), mKeyframes.size(), mKeyframes.back().Time, mSeed);
+        return true;
+    }
+
+    CameraKeyframe FlythroughBenchmark::GetPose() const
+    {
+        if (mPhase == Phase::Settling || mPlaybackTime <= mKeyframes.front().Time)
+            return mKeyframes.front();
+        if (mPlaybackTime >= mKeyframes.back().Time)
+            return mKeyframes.back();
+
+        auto next = std::ranges::upper_bound(mKeyframes, mPlaybackTime, {}, &CameraKeyframe::Time);
+        const CameraKeyframe& to = *next;
+        const CameraKeyframe& from = *(next - 1);
+        f32 t = (mPlaybackTime - from.Time) / (to.Time - from.Time);
+
+        CameraKeyframe pose;
+        pose.Time = mPlaybackTime;
+        pose.FocalPoint = glm::mix(from.FocalPoint, to.FocalPoint, t);
+        pose.Yaw = glm::mix(from.Yaw, to.Yaw, t);
+        pose.Pitch = glm::mix(from.Pitch, to.Pitch, t);
+        pose.Distance = glm::mix(from.Distance, to.Distance, t);
+        return pose;
+    }
+
+    void FlythroughBenchmark::BeginFrame()
+    {
+        mFrameStart = std::chrono::steady_clock::now();
+
+        // the slot was last used QueryCount frames ago, so its result is normally in already
+        usize slot = mFrameIndex % QueryCount;
+        if (mQueryRecords[slot] >= 0)
+            ResolveQuery(slot);
+
+        glBeginQuery(GL_TIME_ELAPSED, mQueries[slot]);
+    }
+
+    void FlythroughBenchmark::EndFrame(const Renderer::Statistics& stats, usize pending_chunks)
+    {
+        glEndQuery(GL_TIME_ELAPSED);
+
+        auto now = std::chrono::steady_clock::now();
+        usize slot = mFrameIndex++ % QueryCount;
+
+        f64 frame_time = mHasPreviousFrame ? std::chrono::duration<f64, std::milli>(mFrameStart - mPreviousFrameStart).count() : 0.0;
+        mPreviousFrameStart = mFrameStart;
+        mHasPreviousFrame = true;
+
+        if (mPhase == Phase::Settling)
+        {
+            if (pending_chunks == 0 || ++mSettleFrames >= MaxSettleFrames)
+            {
+                if (pending_chunks > 0)
+                    RF_CORE_WARN("Chunk streaming did not settle after {} frames, recording anyway", mSettleFrames);
+
+                RF_CORE_INFO("Benchmark settled after {} frames, recording", mSettleFrames);
+                mPhase = Phase::Recording;
+                mPlaybackTime = mKeyframes.front().Time;
+                // the first recorded frame would otherwise include a settling frame's time
+                mHasPreviousFrame = false;
+            }
+            return;
+        }
+
+        if (mPhase != Phase::Recording)
+            return;
+
+        FrameRecord record;
+        record.Time = mPlaybackTime;
+        record.FrameTime = frame_time;
+        record.CpuTime = std::chrono::duration<f64, std::milli>(now - mFrameStart).count();
+        record.Stats = stats;
+        record.PendingChunks = pending_chunks;
+
+        mQueryRecords[slot] = static_cast<i64>(mRecords.size());
+        mRecords.push_back(record);
+
+        mPlaybackTime += mStep;
+        if (mPlaybackTime > mKeyframes.back().Time)
+        {
+            for (usize i = 0; i < QueryCount; i++)
+            {
+                if (mQueryRecords[i] >= 0)
+                    ResolveQuery(i);
+            }
+            mPhase = Phase::Finished;
+        }
+    }
+
+    void FlythroughBenchmark::ResolveQuery(usize slot)
+    {
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(mQueries[slot], GL_QUERY_RESULT, &nanoseconds);
+
+        mRecords[static_cast<usize>(mQueryRecords[slot])].GpuTime = static_cast<f64>(nanoseconds) / 1e6;
+        mQueryRecords[slot] = -1;
+    }
+
+    bool FlythroughBenchmark::WriteResults() const
+    {
+        std::filesystem::path csv_path = mOutputPath;
+        std::filesystem::path json_path = mOutputPath;
+        csv_path += ".csv";
+        json_path += ".json";
+
+        std::ofstream csv(csv_path, std::ios::binary);
+        std::ofstream json(json_path, std::ios::binary);
+        if (!csv || !json)
+        {
+            RF_CORE_ERROR("Could not write benchmark results to {}", mOutputPath.string());
+            return false;
+        }
+
+        std::vector<f64> frame_times;
+        std::vector<f64> cpu_times;
+        std::vector<f64> gpu_times;
+        std::vector<f64> draw_calls;
+        std::vector<f64> triangles;
+        std::vector<f64> instances;
+
+        std::string rows = "frame,time,frame_ms,cpu_ms,gpu_ms,draw_calls,triangles,instances,vertices,indices,pending_chunks\n";
+        for (usize i = 0; i < mRecords.size(); i++)
+        {
+            const FrameRecord& record = mRecords[i];
+            rows += std::format("{},{:.4f},{:.4f},{:.4f},{:.4f},{},{},{},{},{},{}\n", i, record.Time, record.FrameTime,
+                                record.CpuTime, record.GpuTime, record.Stats.DrawCalls, record.Stats.TriangleCount,
+                                record.Stats.InstanceCount, record.Stats.VertexCount, record.Stats.IndexCount, record.PendingChunks);
+
+            // the first frame has no predecessor to measure from
+            if (i > 0)
+                frame_times.push_back(record.FrameTime);
+            cpu_times.push_back(record.CpuTime);
+            if (record.GpuTime >= 0.0)
+                gpu_times.push_back(record.GpuTime);
+            draw_calls.push_back(record.Stats.DrawCalls);
+            triangles.push_back(record.Stats.TriangleCount);
+            instances.push_back(record.Stats.InstanceCount);
+        }
+        csv.write(rows.data(), static_cast<std::streamsize>(rows.size()));
+
+        const Window& window = Application::Get().GetWindow();
+        const char* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+        const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+
+        std::string text = std::format("{{\n  \"script\": \"{}\",\n  \"seed\": {},\n  \"step\": {:.6f},\n"
+                                       "  \"renderer\": \"{}\",\n  \"gl_version\": \"{}\",\n  \"resolution\": [{}, {}],\n"
+                                       "  \"settle_frames\": {},\n  \"frames\": {},\n  \"summary\": {{\n",
+                                       EscapeJson(mScriptPath.generic_string()), mSeed, mStep,
+                                       EscapeJson(renderer ? renderer : ""), EscapeJson(version ? version : ""),
+                                       window.GetWidth(), window.GetHeight(), mSettleFrames, mRecords.size());
+        text += FormatSummary("frame_ms", Summarize(frame_times)) + ",\n";
+        text += FormatSummary("cpu_ms", Summarize(cpu_times)) + ",\n";
+        text += FormatSummary("gpu_ms", Summarize(gpu_times)) + ",\n";
+        text += FormatSummary("draw_calls", Summarize(draw_calls)) + ",\n";
+        text += FormatSummary("triangles", Summarize(triangles)) + ",\n";
+        text += FormatSummary("instances", Summarize(instances)) + "\n  }\n}\n";
+        json.write(text.data(), static_cast<std::streamsize>(text.size()));
+
+        Summary frame = Summarize(frame_times);
+        Summary gpu = Summarize(gpu_times);
+        RF_CORE_INFO("Benchmark: {} frames, frame p50 {:.2f} ms / p99 {:.2f} ms, gpu p50 {:.2f} ms / p99 {:.2f} ms",
+                     mRecords.size(), frame.P50, frame.P99, gpu.P50, gpu.P99);
+        RF_CORE_INFO("Benchmark results written to {} and {}", csv_path.string(), json_path.string());
+        return true;
+    }
+} // namespace RealmFortress
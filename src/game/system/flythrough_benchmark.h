@@ -0,0 +1,118 @@
+/**
+ * @file flythrough_benchmark.h
+ * @brief Plays a scripted camera path and records per-frame timings for --benchmark.
+ * @date 12/22/2025
+ *
+ * The script is plain text, one directive per line, '#' starts a comment:
+ *
+ *     seed 1337                  # map seed, fixed so every run sees the same terrain
+ *     step 0.016667              # playback seconds per frame (default 1/60)
+ *     output flythrough          # writes flythrough.csv and flythrough.json
+ *     # time  focal x y z        yaw   pitch  distance
+ *     0       0 0 0              0     45     20
+ *     10      120 0 -40          90    30     35
+ *
+ * Playback advances by the fixed step every frame rather than by wall time, and chunks
+ * stream in at a fixed ChunkBudget per frame rather than one per worker, so a slow machine
+ * or one with fewer cores renders exactly the same frames as a fast one, only slower.
+ */
+
+#pragma once
+
+#include "core/base.h"
+#include "renderer/renderer.h"
+#include <glm/glm.hpp>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace RealmFortress
+{
+    struct CameraKeyframe
+    {
+        f32 Time = 0.0f;
+        glm::vec3 FocalPoint{ 0.0f };
+        f32 Yaw = 0.0f;
+        f32 Pitch = 45.0f;
+        f32 Distance = 10.0f;
+    };
+
+    /**
+     * @class FlythroughBenchmark
+     * @brief Drives the camera along keyframes and records CPU/GPU frame timings.
+     *
+     * Holds the camera on the first keyframe until chunk streaming settles, then records
+     * one sample per frame until the last keyframe, writes CSV and JSON, and reports
+     * IsFinished(). GPU time comes from GL_TIME_ELAPSED queries read a few frames late so
+     * the CPU never waits on them.
+     */
+    class FlythroughBenchmark
+    {
+    public:
+        static constexpr usize QueryCount = 4;
+        // about 30 seconds at 60 fps; recording starts anyway, with a warning
+        static constexpr u32 MaxSettleFrames = 1800;
+        // chunks generated per frame during the run, the same on every machine
+        static constexpr u32 ChunkBudget = 4;
+
+        FlythroughBenchmark();
+        ~FlythroughBenchmark();
+
+        bool Load(const std::filesystem::path& path);
+
+        u32 GetSeed() const { return mSeed; }
+        f32 GetStep() const { return mStep; }
+        bool IsFinished() const { return mPhase == Phase::Finished; }
+
+        // where the camera should be this frame
+        CameraKeyframe GetPose() const;
+
+        // brackets everything GameLayer renders in a frame
+        void BeginFrame();
+        void EndFrame(const Renderer::Statistics& stats, usize pending_chunks);
+
+        bool WriteResults() const;
+
+    private:
+        enum class Phase
+        {
+            Settling,
+            Recording,
+            Finished
+        };
+
+        struct FrameRecord
+        {
+            f32 Time = 0.0f;
+            f64 FrameTime = 0.0;  // ms, wall clock since the previous frame began
+            f64 CpuTime = 0.0;    // ms, BeginFrame to EndFrame
+            f64 GpuTime = -1.0;   // ms, negative until the query resolves
+            Renderer::Statistics Stats;
+            usize PendingChunks = 0;
+        };
+
+        void ResolveQuery(usize slot);
+
+    private:
+        std::filesystem::path mScriptPath;
+        std::filesystem::path mOutputPath;
+        std::vector<CameraKeyframe> mKeyframes;
+        u32 mSeed{ 1337 };
+        f32 mStep{ 1.0f / 60.0f };
+
+        Phase mPhase{ Phase::Settling };
+        u32 mSettleFrames{ 0 };
+        f32 mPlaybackTime{ 0.0f };
+        std::vector<FrameRecord> mRecords;
+
+        std::chrono::steady_clock::time_point mFrameStart;
+        std::chrono::steady_clock::time_point mPreviousFrameStart;
+        bool mHasPreviousFrame{ false };
+
+        std::array<u32, QueryCount> mQueries{};
+        std::array<i64, QueryCount> mQueryRecords{};  // record each query belongs to, or -1
+        usize mFrameIndex{ 0 };
+    };
+} // namespace RealmFortress
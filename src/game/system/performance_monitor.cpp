@@ -0,0 +1,71 @@
+/**
+ * @file performance_monitor.cpp
+ * @brief
+ * @date 12/22/2025
+ */
+
+#include "core/pch.h"
+#include "performance_monitor.h"
+#include "core/statistics.h"
+#include <span>
+
+namespace RealmFortress
+{
+    void PerformanceMonitor::OnFrame(Timestep ts)
+    {
+        mFrameTimes[mHead] = ts.GetMilliseconds();
+        mSimulationTimes[mHead] = static_cast<f32>(mFrameSimulationTime);
+        mTickCounts[mHead] = mFrameTicks;
+
+        mHead = (mHead + 1) % HistorySize;
+        mCount = std::min(mCount + 1, HistorySize);
+
+        mFrameSimulationTime = 0.0;
+        mFrameTicks = 0;
+    }
+
+    void PerformanceMonitor::AddSimulationTime(f64 milliseconds, u32 ticks)
+    {
+        mFrameSimulationTime += milliseconds;
+        mFrameTicks += ticks;
+    }
+
+    FrameTimePercentiles PerformanceMonitor::ComputeFrameTimePercentiles() const
+    {
+        if (mCount == 0)
+            return {};
+
+        // at most a few hundred floats, sorting a copy is cheaper than keeping a sorted structure
+        std::array<f32, HistorySize> sorted;
+        std::copy_n(mFrameTimes.begin(), mCount, sorted.begin());
+        std::sort(sorted.begin(), sorted.begin() + mCount);
+
+        std::span<const f32> values(sorted.data(), mCount);
+        return { SortedPercentile(values, 0.50), SortedPercentile(values, 0.95), SortedPercentile(values, 0.99), values.back() };
+    }
+
+    f32 PerformanceMonitor::GetAverageTickCost() const
+    {
+        f64 total_time = 0.0;
+        u64 total_ticks = 0;
+        for (usize i = 0; i < mCount; i++)
+        {
+            total_time += mSimulationTimes[i];
+            total_ticks += mTickCounts[i];
+        }
+        return total_ticks > 0 ? static_cast<f32>(total_time / static_cast<f64>(total_ticks)) : 0.0f;
+    }
+
+    f32 PerformanceMonitor::GetAverageSimulationTime() const
+    {
+        if (mCount == 0)
+            return 0.0f;
+
+        f64 total_time = 0.0;
+        for (usize i = 0; i < mCount; i++)
+        {
+            total_time += mSimulationTimes[i];
+        }
+        return static_cast<f32>(total_time / static_cast<f64>(mCount));
+    }
+} // namespace RealmFortress
@@ -0,0 +1,62 @@
+/**
+ * @file performance_monitor.h
+ * @brief
+ * @date 12/22/2025
+ */
+
+#pragma once
+
+#include "core/base.h"
+#include "core/timestep.h"
+#include <array>
+
+namespace RealmFortress
+{
+    struct FrameTimePercentiles
+    {
+        f32 P50 = 0.0f;
+        f32 P95 = 0.0f;
+        f32 P99 = 0.0f;
+        f32 Max = 0.0f;
+    };
+
+    /**
+     * @class PerformanceMonitor
+     * @brief Keeps the last few seconds of frame and simulation timings for the perf overlay.
+     *
+     * Recording is a couple of stores into fixed rings, so it runs every frame whether or not
+     * the overlay is shown; percentiles are only computed when asked for.
+     */
+    class PerformanceMonitor
+    {
+    public:
+        static constexpr usize HistorySize = 240;
+
+        // once per frame, with the frame's delta time
+        void OnFrame(Timestep ts);
+        // time spent ticking the simulation this frame; ticks may be zero when nothing was due
+        void AddSimulationTime(f64 milliseconds, u32 ticks);
+
+        FrameTimePercentiles ComputeFrameTimePercentiles() const;
+        // averaged over the history; zero until a tick has run
+        f32 GetAverageTickCost() const;
+        f32 GetAverageSimulationTime() const;
+
+        // oldest first when read from GetOffset(), wrapping, as ImGui::PlotLines expects
+        const std::array<f32, HistorySize>& GetFrameTimes() const { return mFrameTimes; }
+        usize GetOffset() const { return mHead; }
+        usize GetSampleCount() const { return mCount; }
+        f32 GetLastFrameTime() const { return mFrameTimes[(mHead + HistorySize - 1) % HistorySize]; }
+
+    private:
+        std::array<f32, HistorySize> mFrameTimes{};
+        std::array<f32, HistorySize> mSimulationTimes{};
+        std::array<u32, HistorySize> mTickCounts{};
+        usize mHead{ 0 };
+        usize mCount{ 0 };
+
+        // accumulates until the next OnFrame
+        f64 mFrameSimulationTime{ 0.0 };
+        u32 mFrameTicks{ 0 };
+    };
+} // namespace RealmFortress
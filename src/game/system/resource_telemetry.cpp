@@ -0,0 +1,222 @@
+/**
+ * @file resource_telemetry.cpp
+ * @brief
+ * @date 12/22/2025
+ */
+
+#include "core/pch.h"
+#include "resource_telemetry.h"
+
+namespace RealmFortress
+{
+    void ResourceTelemetry::Record(BuildingType source, ResourceFlow flow, const ResourceVector& amounts)
+    {
+        for (usize i = 0; i < ResourceCount; i++)
+        {
+            ResourceType type = static_cast<ResourceType>(i);
+            if (amounts[type] != 0)
+            {
+                Record(source, flow, type, amounts[type]);
+            }
+        }
+    }
+
+    void ResourceTelemetry::EndTick(f64 time)
+    {
+        u64 count = mSampleCount.load(std::memory_order_relaxed);
+        Sample& sample = mSamples[count % SampleCapacity];
+        sample.EndTime = time;
+        sample.Duration = std::max(0.0, time - mLastTickTime);
+
+        std::array<i32, ResourceCount> net{};
+        for (usize i = 0; i < ValueCount; i++)
+        {
+            i32 value = mCurrent[i].exchange(0, std::memory_order_relaxed);
+            sample.Values[i] = value;
+
+            usize flow = (i / ResourceCount) % FlowCount;
+            if (flow == static_cast<usize>(ResourceFlow::Produced))
+                net[i % ResourceCount] += value;
+            else if (flow == static_cast<usize>(ResourceFlow::Consumed))
+                net[i % ResourceCount] -= value;
+        }
+
+        mSampleCount.store(count + 1, std::memory_order_release);
+
+        AccumulateHistory(mLastTickTime, time, net);
+        mLastTickTime = time;
+    }
+
+    void ResourceTelemetry::DiscardTick()
+    {
+        for (auto& value : mCurrent)
+        {
+            value.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ResourceTelemetry::State ResourceTelemetry::SaveState() const
+    {
+        State state;
+        for (usize i = 0; i < ValueCount; i++)
+        {
+            state.Current[i] = mCurrent[i].load(std::memory_order_relaxed);
+        }
+        return state;
+    }
+
+    void ResourceTelemetry::RestoreState(const State& state)
+    {
+        for (usize i = 0; i < ValueCount; i++)
+        {
+            mCurrent[i].store(state.Current[i], std::memory_order_relaxed);
+        }
+    }
+
+    void ResourceTelemetry::ComputeRates(f64 window, RateTable& out_rates) const
+    {
+        out_rates.fill(0.0f);
+
+        u64 count = mSampleCount.load(std::memory_order_acquire);
+        if (count == 0 || window <= 0.0)
+            return;
+
+        u64 available = std::min<u64>(count, SampleCapacity);
+        f64 newest = mSamples[(count - 1) % SampleCapacity].EndTime;
+        f64 window_start = newest - window;
+        f64 covered_start = newest;
+
+        std::array<f64, ValueCount> sums{};
+        for (u64 i = 0; i < available; i++)
+        {
+            const Sample& sample = mSamples[(count - 1 - i) % SampleCapacity];
+            f64 sample_start = sample.EndTime - sample.Duration;
+            if (sample.EndTime <= window_start)
+                break;
+
+            // a fast-forwarded sample can straddle the window's start; count only the part inside
+            f64 fraction = 1.0;
+            if (sample.Duration > 0.0 && sample_start < window_start)
+            {
+                fraction = (sample.EndTime - window_start) / sample.Duration;
+            }
+
+            for (usize v = 0; v < ValueCount; v++)
+            {
+                sums[v] += static_cast<f64>(sample.Values[v]) * fraction;
+            }
+            covered_start = std::max(sample_start, window_start);
+        }
+
+        // right after a start or a clear there is less history than the window asks for
+        f64 covered = newest - covered_start;
+        if (covered <= 0.0)
+            return;
+
+        for (usize v = 0; v < ValueCount; v++)
+        {
+            out_rates[v] = static_cast<f32>(sums[v] / covered);
+        }
+    }
+
+    f32 ResourceTelemetry::GetRate(const RateTable& rates, BuildingType source, ResourceFlow flow, ResourceType resource)
+    {
+        return rates[GetIndex(source, flow, resource)];
+    }
+
+    f32 ResourceTelemetry::GetTotalRate(const RateTable& rates, ResourceFlow flow, ResourceType resource)
+    {
+        f32 total = 0.0f;
+        for (usize source = 0; source < SourceCount; source++)
+        {
+            total += rates[GetIndex(static_cast<BuildingType>(source), flow, resource)];
+        }
+        return total;
+    }
+
+    f32 ResourceTelemetry::GetNetRate(const RateTable& rates, ResourceType resource)
+    {
+        return GetTotalRate(rates, ResourceFlow::Produced, resource) - GetTotalRate(rates, ResourceFlow::Consumed, resource);
+    }
+
+    usize ResourceTelemetry::GetHistory(ResourceType resource, std::array<f32, HistorySeconds>& out_values) const
+    {
+        const auto& history = mHistory[static_cast<usize>(resource)];
+        usize count = static_cast<usize>(std::min<u64>(mHistoryCount, HistorySeconds));
+        u64 first = mHistoryCount - count;
+
+        for (usize i = 0; i < count; i++)
+        {
+            out_values[i] = history[(first + i) % HistorySeconds];
+        }
+        return count;
+    }
+
+    void ResourceTelemetry::Clear()
+    {
+        DiscardTick();
+        mSampleCount.store(0, std::memory_order_release);
+        mLastTickTime = 0.0;
+
+        for (auto& history : mHistory)
+        {
+            history.fill(0.0f);
+        }
+        mHistoryCurrent.fill(0.0f);
+        mHistorySecond = 0;
+        mHistoryCount = 0;
+    }
+
+    void ResourceTelemetry::AccumulateHistory(f64 start, f64 end, const std::array<i32, ResourceCount>& net)
+    {
+        f64 duration = end - start;
+        std::array<f64, ResourceCount> remaining{};
+        for (usize r = 0; r < ResourceCount; r++)
+        {
+            remaining[r] = static_cast<f64>(net[r]);
+        }
+
+        // only the last HistorySeconds of a long fast-forward can still be shown
+        if (duration > static_cast<f64>(HistorySeconds))
+        {
+            f64 kept_start = end - static_cast<f64>(HistorySeconds);
+            for (auto& value : remaining)
+            {
+                value *= (end - kept_start) / duration;
+            }
+            start = kept_start;
+            duration = end - start;
+        }
+
+        f64 cursor = start;
+        while (true)
+        {
+            i64 second = static_cast<i64>(std::floor(cursor));
+            while (mHistorySecond < second)
+            {
+                for (usize r = 0; r < ResourceCount; r++)
+                {
+                    mHistory[r][mHistoryCount % HistorySeconds] = mHistoryCurrent[r];
+                }
+                mHistoryCurrent.fill(0.0f);
+                mHistoryCount++;
+
+                // a gap longer than the whole ring leaves nothing worth stepping through
+                mHistorySecond = std::max(mHistorySecond + 1, second - static_cast<i64>(HistorySeconds));
+            }
+
+            f64 bucket_end = std::min(end, static_cast<f64>(second + 1));
+            f64 fraction = duration > 0.0 ? (bucket_end - cursor) / (end - cursor) : 1.0;
+            for (usize r = 0; r < ResourceCount; r++)
+            {
+                f64 part = remaining[r] * fraction;
+                mHistoryCurrent[r] += static_cast<f32>(part);
+                remaining[r] -= part;
+            }
+
+            if (bucket_end >= end)
+                break;
+            cursor = bucket_end;
+        }
+    }
+} // namespace RealmFortress
@@ -0,0 +1,132 @@
+/**
+ * @file resource_telemetry.h
+ * @brief
+ * @date 12/22/2025
+ */
+
+#pragma once
+
+#include "core/base.h"
+#include "game/building/building.h"
+#include "game/resource/resource.h"
+#include <array>
+#include <atomic>
+
+namespace RealmFortress
+{
+    enum class ResourceFlow : u8
+    {
+        Produced,
+        Consumed,
+        Lost, // produced but the warehouse had no room
+
+        Count
+    };
+
+    inline const char* ResourceFlowToString(ResourceFlow flow)
+    {
+        switch (flow)
+        {
+        case ResourceFlow::Produced: return "Produced";
+        case ResourceFlow::Consumed: return "Consumed";
+        case ResourceFlow::Lost:     return "Lost";
+        default:                     return "Unknown";
+        }
+    }
+
+    /**
+     * @class ResourceTelemetry
+     * @brief Records every warehouse change by source building type and keeps a short history.
+     *
+     * Record() is one relaxed atomic add into the current tick's counters, cheap enough to stay
+     * on in release builds and safe from any thread. EndTick() closes the tick into a fixed ring
+     * of samples, each stamped with the simulated span it covers, so fast-forwarded spans are
+     * weighted correctly. Rolling rates over any window are computed from the ring on demand,
+     * and a per-second ring of net changes feeds the plots.
+     */
+    class ResourceTelemetry
+    {
+    public:
+        static constexpr usize SourceCount = static_cast<usize>(BuildingType::Count) + 1; // last: not a building
+        static constexpr usize FlowCount = static_cast<usize>(ResourceFlow::Count);
+        static constexpr usize ResourceCount = static_cast<usize>(ResourceType::Count);
+        static constexpr usize ValueCount = SourceCount * FlowCount * ResourceCount;
+
+        static constexpr usize SampleCapacity = 2048;
+        static constexpr usize HistorySeconds = 120;
+
+        // amounts per simulated second, indexed like the samples
+        using RateTable = std::array<f32, ValueCount>;
+
+        // the counters recorded since the last EndTick
+        struct State
+        {
+            std::array<i32, ValueCount> Current;
+        };
+
+        static ResourceTelemetry& Get()
+        {
+            static ResourceTelemetry instance;
+            return instance;
+        }
+
+        ResourceTelemetry(const ResourceTelemetry&) = delete;
+        ResourceTelemetry& operator=(const ResourceTelemetry&) = delete;
+
+        // BuildingType::Count as the source stands for anything that isn't a building
+        void Record(BuildingType source, ResourceFlow flow, ResourceType resource, i32 amount)
+        {
+            mCurrent[GetIndex(source, flow, resource)].fetch_add(amount, std::memory_order_relaxed);
+        }
+        void Record(BuildingType source, ResourceFlow flow, const ResourceVector& amounts);
+
+        // closes the counters recorded since the last call into a sample ending at time
+        void EndTick(f64 time);
+        // drops the counters recorded since the last EndTick
+        void DiscardTick();
+
+        // for spans that are rolled back: restoring drops only what was recorded after the save
+        State SaveState() const;
+        void RestoreState(const State& state);
+
+        void ComputeRates(f64 window, RateTable& out_rates) const;
+        static f32 GetRate(const RateTable& rates, BuildingType source, ResourceFlow flow, ResourceType resource);
+        static f32 GetTotalRate(const RateTable& rates, ResourceFlow flow, ResourceType resource);
+        static f32 GetNetRate(const RateTable& rates, ResourceType resource);
+
+        // net change per simulated second, oldest first, for ImGui::PlotLines
+        usize GetHistory(ResourceType resource, std::array<f32, HistorySeconds>& out_values) const;
+
+        void Clear();
+
+    private:
+        ResourceTelemetry() = default;
+
+        static usize GetIndex(BuildingType source, ResourceFlow flow, ResourceType resource)
+        {
+            return (static_cast<usize>(source) * FlowCount + static_cast<usize>(flow)) * ResourceCount + static_cast<usize>(resource);
+        }
+
+        void AccumulateHistory(f64 start, f64 end, const std::array<i32, ResourceCount>& net);
+
+    private:
+        struct Sample
+        {
+            f64 EndTime{ 0.0 };
+            f64 Duration{ 0.0 };
+            std::array<i32, ValueCount> Values{};
+        };
+
+        std::array<std::atomic<i32>, ValueCount> mCurrent{};
+        f64 mLastTickTime{ 0.0 };
+
+        // single writer (EndTick), mSampleCount only grows, the newest sample is at count - 1
+        std::array<Sample, SampleCapacity> mSamples;
+        std::atomic<u64> mSampleCount{ 0 };
+
+        std::array<std::array<f32, HistorySeconds>, ResourceCount> mHistory{};
+        std::array<f32, ResourceCount> mHistoryCurrent{};
+        i64 mHistorySecond{ 0 };
+        u64 mHistoryCount{ 0 };
+    };
+} // namespace RealmFortress
@@ -0,0 +1,218 @@
+/**
+ * @file scheduler.cpp
+ * @brief
+ * @date 12/22/2025
+ */
+
+#include "core/pch.h"
+#include "scheduler.h"
+
+namespace RealmFortress
+{
+    void Scheduler::OnUpdate(Timestep ts)
+    {
+        AdvanceTo(mTime + ts.GetSeconds());
+    }
+
+    void Scheduler::AdvanceTo(f64 time)
+    {
+        mTime = std::max(mTime, time);
+
+        while (!mHeap.empty() && mHeap.front().DueTime <= mTime)
+        {
+            std::ranges::pop_heap(mHeap, std::greater<>());
+            Entry entry = mHeap.back();
+            mHeap.pop_back();
+
+            Timer& timer = mTimers[entry.Index];
+            if (!timer.Pending || timer.Stamp != entry.Stamp)
+                continue;
+
+            timer.Pending = false;
+            mPendingCount--;
+            mFiredCount++;
+
+            // moved out so the callback may cancel its own timer without destroying itself
+            TimerHandle handle{ entry.Index, timer.Generation };
+            Callback function = std::move(timer.Function);
+            function(handle, entry.DueTime);
+
+            if (timer.Generation != handle.Generation)
+                continue;
+
+            if (timer.Pending)
+                timer.Function = std::move(function);
+            else
+                Release(entry.Index);
+        }
+    }
+
+    f64 Scheduler::GetNextDueTime(u64* out_stamp)
+    {
+        // drop stale entries off the top so the answer is a timer that will actually fire
+        while (!mHeap.empty())
+        {
+            const Entry& top = mHeap.front();
+            const Timer& timer = mTimers[top.Index];
+            if (timer.Pending && timer.Stamp == top.Stamp)
+            {
+                if (out_stamp)
+                    *out_stamp = top.Stamp;
+                return top.DueTime;
+            }
+
+            std::ranges::pop_heap(mHeap, std::greater<>());
+            mHeap.pop_back();
+        }
+
+        if (out_stamp)
+            *out_stamp = std::numeric_limits<u64>::max();
+        return std::numeric_limits<f64>::infinity();
+    }
+
+    TimerHandle Scheduler::Schedule(f64 delay, Callback callback)
+    {
+        return ScheduleAt(mTime + delay, std::move(callback));
+    }
+
+    TimerHandle Scheduler::ScheduleAt(f64 time, Callback callback)
+    {
+        u32 index;
+        if (!mFreeTimers.empty())
+        {
+            index = mFreeTimers.back();
+            mFreeTimers.pop_back();
+        }
+        else
+        {
+            index = static_cast<u32>(mTimers.size());
+            mTimers.emplace_back();
+        }
+
+        Timer& timer = mTimers[index];
+        timer.Function = std::move(callback);
+        Push(index, time);
+
+        return { index, timer.Generation };
+    }
+
+    bool Scheduler::Reschedule(TimerHandle handle, f64 time)
+    {
+        Timer* timer = Resolve(handle);
+        if (!timer)
+            return false;
+
+        Push(handle.Index, time);
+        return true;
+    }
+
+    void Scheduler::Cancel(TimerHandle& handle)
+    {
+        if (Resolve(handle))
+        {
+            Release(handle.Index);
+        }
+        handle = {};
+    }
+
+    bool Scheduler::IsPending(TimerHandle handle) const
+    {
+        const Timer* timer = Resolve(handle);
+        return timer && timer->Pending;
+    }
+
+    f64 Scheduler::GetDueTime(TimerHandle handle) const
+    {
+        const Timer* timer = Resolve(handle);
+        return timer && timer->Pending ? timer->DueTime : 0.0;
+    }
+
+    Scheduler::State Scheduler::SaveState() const
+    {
+        return { mTimers, mFreeTimers, mHeap, mTime, mNextStamp, mPendingCount, mFiredCount };
+    }
+
+    void Scheduler::RestoreState(const State& state)
+    {
+        mTimers = state.Timers;
+        mFreeTimers = state.FreeTimers;
+        mHeap = state.Heap;
+        mTime = state.Time;
+        mNextStamp = state.NextStamp;
+        mPendingCount = state.PendingCount;
+        mFiredCount = state.FiredCount;
+    }
+
+    u64 Scheduler::GetStamp(TimerHandle handle) const
+    {
+        const Timer* timer = Resolve(handle);
+        return timer && timer->Pending ? timer->Stamp : 0;
+    }
+
+    void Scheduler::Clear()
+    {
+        mTimers.clear();
+        mFreeTimers.clear();
+        mHeap.clear();
+        mTime = 0.0;
+        mNextStamp = 1;
+        mPendingCount = 0;
+        mFiredCount = 0;
+    }
+
+    Scheduler::Timer* Scheduler::Resolve(TimerHandle handle)
+    {
+        if (!handle.IsValid() || handle.Index >= mTimers.size())
+            return nullptr;
+
+        Timer& timer = mTimers[handle.Index];
+        return timer.Generation == handle.Generation ? &timer : nullptr;
+    }
+
+    const Scheduler::Timer* Scheduler::Resolve(TimerHandle handle) const
+    {
+        return const_cast<Scheduler*>(this)->Resolve(handle);
+    }
+
+    void Scheduler::Push(u32 index, f64 time)
+    {
+        Timer& timer = mTimers[index];
+        if (!timer.Pending)
+        {
+            timer.Pending = true;
+            mPendingCount++;
+        }
+
+        // a new stamp invalidates whatever entry this timer already has in the heap
+        timer.DueTime = time;
+        timer.Stamp = mNextStamp++;
+
+        mHeap.push_back({ time, timer.Stamp, index });
+        std::ranges::push_heap(mHeap, std::greater<>());
+
+        // frequent rescheduling leaves stale entries behind, rebuild once they dominate
+        if (mHeap.size() > mPendingCount * 2 + 64)
+        {
+            std::erase_if(mHeap, [this](const Entry& e)
+            {
+                const Timer& t = mTimers[e.Index];
+                return !t.Pending || t.Stamp != e.Stamp;
+            });
+            std::ranges::make_heap(mHeap, std::greater<>());
+        }
+    }
+
+    void Scheduler::Release(u32 index)
+    {
+        Timer& timer = mTimers[index];
+        if (timer.Pending)
+        {
+            timer.Pending = false;
+            mPendingCount--;
+        }
+
+        timer.Function = nullptr;
+        timer.Generation = timer.Generation + 1 != 0 ? timer.Generation + 1 : 1;
+        mFreeTimers.push_back(index);
+    }
+} // namespace RealmFortress
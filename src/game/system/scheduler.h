@@ -0,0 +1,134 @@
+/**
+ * @file scheduler.h
+ * @brief
+ * @date 12/22/2025
+ */
+
+#pragma once
+
+#include "core/base.h"
+#include "core/timestep.h"
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace RealmFortress
+{
+    struct TimerHandle
+    {
+        u32 Index{ 0 };
+        u32 Generation{ 0 };
+
+        bool IsValid() const { return Generation != 0; }
+    };
+
+    /**
+     * @class Scheduler
+     * @brief Fires callbacks at points in simulation time, in a deterministic order.
+     *
+     * Timers sit in a min-heap keyed by due time, so a tick only touches the timers that are due.
+     * Rescheduling or cancelling leaves the old heap entry behind and marks it stale; it is
+     * skipped when it reaches the top. Timers due at the same time fire in the order they were
+     * (re)scheduled.
+     *
+     * A callback receives its own handle and the exact time it was due. A timer is one-shot
+     * unless its callback reschedules it, which is how repeating cycles avoid drifting.
+     */
+    class Scheduler
+    {
+    public:
+        using Callback = std::function<void(TimerHandle handle, f64 due_time)>;
+
+    private:
+        struct Timer
+        {
+            Callback Function;
+            f64 DueTime{ 0.0 };
+            u64 Stamp{ 0 };
+            u32 Generation{ 1 };
+            bool Pending{ false };
+        };
+
+        struct Entry
+        {
+            f64 DueTime;
+            u64 Stamp;
+            u32 Index;
+
+            bool operator>(const Entry& other) const
+            {
+                return DueTime != other.DueTime ? DueTime > other.DueTime : Stamp > other.Stamp;
+            }
+        };
+
+    public:
+        // full copy of the timer state, callbacks included, for replaying a span of simulation
+        struct State
+        {
+            std::deque<Timer> Timers;
+            std::vector<u32> FreeTimers;
+            std::vector<Entry> Heap;
+            f64 Time{ 0.0 };
+            u64 NextStamp{ 1 };
+            usize PendingCount{ 0 };
+            usize FiredCount{ 0 };
+        };
+
+        static Scheduler& Get()
+        {
+            static Scheduler instance;
+            return instance;
+        }
+
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+
+        // advances simulation time by one tick and fires everything due
+        void OnUpdate(Timestep ts);
+        void AdvanceTo(f64 time);
+
+        // due time of the earliest pending timer, infinity when nothing is pending
+        f64 GetNextDueTime(u64* out_stamp = nullptr);
+
+        TimerHandle Schedule(f64 delay, Callback callback);
+        TimerHandle ScheduleAt(f64 time, Callback callback);
+        bool Reschedule(TimerHandle handle, f64 time);
+        void Cancel(TimerHandle& handle);
+
+        bool IsPending(TimerHandle handle) const;
+        f64 GetDueTime(TimerHandle handle) const;
+
+        // stamps order timers due at the same time; a system standing in for its timers while
+        // they are suspended reserves stamps so it keeps its place in that order
+        u64 GetStamp(TimerHandle handle) const;
+        u64 ReserveStamp() { return mNextStamp++; }
+        f64 GetTime() const { return mTime; }
+
+        usize GetPendingCount() const { return mPendingCount; }
+        usize GetFiredCount() const { return mFiredCount; }
+
+        State SaveState() const;
+        void RestoreState(const State& state);
+
+        void Clear();
+
+    private:
+        Scheduler() = default;
+
+        Timer* Resolve(TimerHandle handle);
+        const Timer* Resolve(TimerHandle handle) const;
+        void Push(u32 index, f64 time);
+        void Release(u32 index);
+
+    private:
+        // deque so callbacks can schedule new timers without moving the one being run
+        std::deque<Timer> mTimers;
+        std::vector<u32> mFreeTimers;
+        std::vector<Entry> mHeap;
+
+        f64 mTime{ 0.0 };
+        u64 mNextStamp{ 1 };
+        usize mPendingCount{ 0 };
+        usize mFiredCount{ 0 };
+    };
+} // namespace RealmFortress
@@ -0,0 +1,74 @@
+/**
+ * @file simulation_clock.cpp
+ * @brief
+ * @date 12/22/2025
+ */
+
+#include "core/pch.h"
+#include "simulation_clock.h"
+
+namespace RealmFortress
+{
+    SimulationClock::SimulationClock(f32 tick_rate)
+        : mTickRate(tick_rate), mTickDelta(1.0 / tick_rate)
+    {
+    }
+
+    u32 SimulationClock::Advance(Timestep frame_delta)
+    {
+        if (mPaused)
+            return 0;
+
+        mAccumulator += static_cast<f64>(frame_delta.GetSeconds()) * mTimeScale;
+
+        u32 ticks = static_cast<u32>(mAccumulator / mTickDelta);
+        mAccumulator -= ticks * mTickDelta;
+
+        // high time scales legitimately need more ticks, so the cap grows with the scale
+        u32 max_ticks = mMaxTicksPerFrame * static_cast<u32>(std::ceil(mTimeScale));
+        if (ticks > max_ticks)
+        {
+            mDroppedTicks += ticks - max_ticks;
+            ticks = max_ticks;
+        }
+
+        mTickCount += ticks;
+        mSimulationTime += ticks * mTickDelta;
+        return ticks;
+    }
+
+    f64 SimulationClock::Skip(Timestep frame_delta)
+    {
+        if (mPaused)
+            return 0.0;
+
+        f64 seconds = static_cast<f64>(frame_delta.GetSeconds()) * mTimeScale;
+        mSimulationTime += seconds;
+        return seconds;
+    }
+
+    void SimulationClock::SetTickRate(f32 tick_rate)
+    {
+        if (tick_rate <= 0.0f)
+            return;
+
+        // keep the partial tick as a fraction so changing the rate doesn't skip or repeat time
+        f64 alpha = mAccumulator / mTickDelta;
+        mTickRate = tick_rate;
+        mTickDelta = 1.0 / tick_rate;
+        mAccumulator = alpha * mTickDelta;
+    }
+
+    void SimulationClock::SetTimeScale(f32 scale)
+    {
+        mTimeScale = std::clamp(scale, 0.0f, MaxTimeScale);
+    }
+
+    void SimulationClock::Reset()
+    {
+        mAccumulator = 0.0;
+        mTickCount = 0;
+        mSimulationTime = 0.0;
+        mDroppedTicks = 0;
+    }
+} // namespace RealmFortress
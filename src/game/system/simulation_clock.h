@@ -0,0 +1,74 @@
+/**
+ * @file simulation_clock.h
+ * @brief
+ * @date 12/22/2025
+ */
+
+#pragma once
+
+#include "core/base.h"
+#include "core/timestep.h"
+
+namespace RealmFortress
+{
+    /**
+     * @class SimulationClock
+     * @brief Turns variable frame deltas into a whole number of fixed simulation ticks.
+     *
+     * Every tick advances the simulation by exactly GetTickDelta(), so the same sequence of
+     * ticks always produces the same economy regardless of frame rate. Frame time is scaled,
+     * accumulated, and drained one tick at a time; at most mMaxTicksPerFrame are run per frame
+     * and the rest of the backlog is dropped so a long hitch cannot spiral.
+     */
+    class SimulationClock
+    {
+    public:
+        static constexpr f32 DefaultTickRate = 20.0f;
+        static constexpr f32 MaxTimeScale = 16.0f;
+
+        explicit SimulationClock(f32 tick_rate = DefaultTickRate);
+
+        // returns how many fixed ticks the caller should run this frame
+        u32 Advance(Timestep frame_delta);
+
+        // advances simulation time by the scaled frame delta without producing ticks, for spans
+        // the caller fast-forwards analytically; returns the simulated seconds
+        f64 Skip(Timestep frame_delta);
+
+        void SetTickRate(f32 tick_rate);
+        f32 GetTickRate() const { return mTickRate; }
+        Timestep GetTickDelta() const { return Timestep(static_cast<f32>(mTickDelta)); }
+
+        void SetTimeScale(f32 scale);
+        f32 GetTimeScale() const { return mTimeScale; }
+
+        void SetPaused(bool paused) { mPaused = paused; }
+        void TogglePaused() { mPaused = !mPaused; }
+        bool IsPaused() const { return mPaused; }
+
+        void SetMaxTicksPerFrame(u32 max_ticks) { mMaxTicksPerFrame = max_ticks > 0 ? max_ticks : 1; }
+        u32 GetMaxTicksPerFrame() const { return mMaxTicksPerFrame; }
+
+        // fraction of a tick accumulated but not simulated yet, for interpolating between the last two states
+        f32 GetAlpha() const { return static_cast<f32>(mAccumulator / mTickDelta); }
+
+        u64 GetTickCount() const { return mTickCount; }
+        u64 GetDroppedTickCount() const { return mDroppedTicks; }
+        f64 GetSimulationTime() const { return mSimulationTime; }
+
+        void Reset();
+
+    private:
+        f32 mTickRate;
+        f64 mTickDelta;
+        f64 mAccumulator{ 0.0 };
+
+        f32 mTimeScale{ 1.0f };
+        bool mPaused{ false };
+        u32 mMaxTicksPerFrame{ 8 };
+
+        u64 mTickCount{ 0 };
+        f64 mSimulationTime{ 0.0 };
+        u64 mDroppedTicks{ 0 };
+    };
+} // namespace RealmFortress
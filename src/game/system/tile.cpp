@@ -54,12 +54,13 @@ namespace RealmFortress
     void Tile::SetDecoration(DecorationType decoration)
     {
         mDecoration = decoration;
+        mDecorationModel = NullModelHandle;
         if (decoration != DecorationType::None)
         {
             const char* path = DecorationTypeToModelPath(decoration);
             if (path)
             {
-                mDecorationModel = ModelCache::Load(path);
+                mDecorationModel = ModelCache::Load(path, VertexFormat::Standard);
             }
         }
     }
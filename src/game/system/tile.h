@@ -8,7 +8,7 @@
 
 #include "core/base.h"
 #include "game/system/coordinate.h"
-#include "renderer/model.h"
+#include "renderer/model_cache.h"
 #include <string>
 
 namespace RealmFortress
@@ -100,8 +100,8 @@ namespace RealmFortress
         glm::vec3 GetWorldPosition() const;
         glm::mat4 GetTransform() const;
 
-        void SetModel(const Ref<Model>& model) { mModel = model; }
-        Ref<Model> GetModel() const { return mModel; }
+        void SetModel(ModelHandle model) { mModel = model; }
+        ModelHandle GetModel() const { return mModel; }
 
         bool IsWalkable() const;
         bool IsWater() const;
@@ -109,7 +109,7 @@ namespace RealmFortress
         void SetDecoration(DecorationType decoration);
 
         DecorationType GetDecoration() const { return mDecoration; }
-        Ref<Model> GetDecorationModel() const { return mDecorationModel; }
+        ModelHandle GetDecorationModel() const { return mDecorationModel; }
         glm::mat4 GetDecorationTransform() const;
 
     private:
@@ -118,9 +118,9 @@ namespace RealmFortress
         std::string mModelPath;
         f32 mRotation{ 0.0f };
         i32 mElevation{ 0 };
-        Ref<Model> mModel{ nullptr };
+        ModelHandle mModel{ NullModelHandle };
 
         DecorationType mDecoration{ DecorationType::None };
-        Ref<Model> mDecorationModel;
+        ModelHandle mDecorationModel{ NullModelHandle };
     };
 } // namespace RealmFortress
@@ -26,7 +26,7 @@ namespace RealmFortress
         sThumbnailCache.clear();
     }
 
-    Ref<Framebuffer> ThumbnailGenerator::GenerateThumbnail(const Ref<Model>& model, f32 scale)
+    Ref<Framebuffer> ThumbnailGenerator::GenerateThumbnail(Model* model, f32 scale)
     {
         if (!model || !sThumbnailShader)
             return nullptr;
@@ -76,12 +76,7 @@ namespace RealmFortress
             return sThumbnailCache[model_path]->GetColorAttachmentRendererID();
         }
 
-        auto model = ModelCache::Get(model_path);
-        if (!model)
-        {
-            model = ModelCache::Load(model_path);
-        }
-
+        Model* model = ModelCache::Get(ModelCache::Load(model_path));
         if (model)
         {
             Ref<Framebuffer> fbo = GenerateThumbnail(model, scale);
@@ -100,7 +95,7 @@ namespace RealmFortress
         sThumbnailCache.clear();
     }
 
-    void ThumbnailGenerator::RenderModelToFramebuffer(const Ref<Model>& model)
+    void ThumbnailGenerator::RenderModelToFramebuffer(Model* model)
     {
     }
 } // namespace RealmFortress
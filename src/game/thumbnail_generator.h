@@ -23,9 +23,9 @@ namespace RealmFortress
         static void ClearCache();
 
     private:
-        static Ref<Framebuffer> GenerateThumbnail(const Ref<Model>& model, f32 scale);
+        static Ref<Framebuffer> GenerateThumbnail(Model* model, f32 scale);
 
-        static void RenderModelToFramebuffer(const Ref<Model>& model);
+        static void RenderModelToFramebuffer(Model* model);
 
     private:
         inline static Ref<Shader> sThumbnailShader;
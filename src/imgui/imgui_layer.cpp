@@ -7,6 +7,7 @@
 #include "core/pch.h"
 #include "imgui_layer.h"
 #include "core/application.h"
+#include "core/memory_tracker.h"
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
@@ -17,11 +18,23 @@ namespace RealmFortress
     ImGuiLayer::ImGuiLayer()
         : Layer("ImGuiLayer")
     {
+        // swallows input while an ImGui window wants it
+        mEventHandlers.Register<MouseButtonPressedEvent, &ImGuiLayer::OnMouseEvent>(this);
+        mEventHandlers.Register<MouseButtonReleasedEvent, &ImGuiLayer::OnMouseEvent>(this);
+        mEventHandlers.Register<MouseMovedEvent, &ImGuiLayer::OnMouseEvent>(this);
+        mEventHandlers.Register<MouseScrolledEvent, &ImGuiLayer::OnMouseEvent>(this);
+        mEventHandlers.Register<KeyPressedEvent, &ImGuiLayer::OnKeyEvent>(this);
+        mEventHandlers.Register<KeyReleasedEvent, &ImGuiLayer::OnKeyEvent>(this);
+        mEventHandlers.Register<KeyTypedEvent, &ImGuiLayer::OnKeyEvent>(this);
     }
 
     void ImGuiLayer::OnAttach()
     {
         IMGUI_CHECKVERSION();
+        // through operator new, so ImGui's memory shows up under its own tag
+        ImGui::SetAllocatorFunctions(
+            [](size_t size, void*) -> void* { RF_MEMORY_TAG(MemoryTag::ImGui); return ::operator new(size); },
+            [](void* memory, void*) { ::operator delete(memory); });
         ImGui::CreateContext();
         ImGuiIO& io = ImGui::GetIO();
         // io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
@@ -33,7 +46,14 @@ namespace RealmFortress
         // ImGui::StyleColorsLight();
 
         f32 font_size = 18.0f;
-        io.Fonts->AddFontFromFileTTF("assets/fonts/mali/Mali-SemiBold.ttf", font_size, nullptr, io.Fonts->GetGlyphRangesThai());
+        // the atlas keeps pointing at the font bytes, which stay alive in mFontData
+        mFontData = FileSystem::Read("assets/fonts/mali/Mali-SemiBold.ttf");
+        if (mFontData)
+        {
+            ImFontConfig font_config;
+            font_config.FontDataOwnedByAtlas = false;
+            io.Fonts->AddFontFromMemoryTTF(const_cast<u8*>(mFontData.Data()), static_cast<i32>(mFontData.Size()), font_size, &font_config, io.Fonts->GetGlyphRangesThai());
+        }
 
         ImGuiStyle& style = ImGui::GetStyle();
         if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
@@ -46,7 +66,7 @@ namespace RealmFortress
         GLFWwindow* window = static_cast<GLFWwindow*>(app.GetWindow().GetNativeWindow());
 
         ImGui_ImplGlfw_InitForOpenGL(window, true);
-        ImGui_ImplOpenGL3_Init("#version 460");
+        ImGui_ImplOpenGL3_Init("#version 450");
     }
 
     void ImGuiLayer::OnDetach()
@@ -56,14 +76,14 @@ namespace RealmFortress
         ImGui::DestroyContext();
     }
 
-    void ImGuiLayer::OnEvent(Event& event)
+    bool ImGuiLayer::OnMouseEvent(Event& event)
     {
-        if (mBlockEvent)
-        {
-            ImGuiIO& io = ImGui::GetIO();
-            event.mHandled |= event.IsInCategory(EventCategoryMouse) & io.WantCaptureMouse;
-            event.mHandled |= event.IsInCategory(EventCategoryKeyboard) & io.WantCaptureKeyboard;
-        }
+        return mBlockEvent && ImGui::GetIO().WantCaptureMouse;
+    }
+
+    bool ImGuiLayer::OnKeyEvent(Event& event)
+    {
+        return mBlockEvent && ImGui::GetIO().WantCaptureKeyboard;
     }
 
     void ImGuiLayer::Begin()
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "core/layer.h"
+#include "core/file_system.h"
 #include "events/application_event.h"
 #include "events/key_event.h"
 #include "events/mouse_event.h"
@@ -21,15 +22,19 @@ namespace RealmFortress
 
         void OnAttach() override;
         void OnDetach() override;
-        void OnEvent(Event& event) override;
 
         void Begin();
         void End();
 
         void BlockEvent(bool block) { mBlockEvent = block; }
 
+    private:
+        bool OnMouseEvent(Event& event);
+        bool OnKeyEvent(Event& event);
+
     private:
         bool mBlockEvent = true;
         f32 mTime = 0.0f;
+        FileData mFontData;
     };
 } // namespace RealmFortress
@@ -11,21 +11,26 @@
 namespace RealmFortress
 {
     VertexBuffer::VertexBuffer(u32 size)
+        : mMemoryUsage(size), mMemoryTag(MemoryTracker::GetCurrentTag())
     {
         glCreateBuffers(1, &mRendererID);
         glBindBuffer(GL_ARRAY_BUFFER, mRendererID);
         glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+        MemoryTracker::OnGpuAllocate(mMemoryTag, mMemoryUsage);
     }
 
     VertexBuffer::VertexBuffer(f32* vertices, u32 size)
+        : mMemoryUsage(size), mMemoryTag(MemoryTracker::GetCurrentTag())
     {
         glCreateBuffers(1, &mRendererID);
         glBindBuffer(GL_ARRAY_BUFFER, mRendererID);
         glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+        MemoryTracker::OnGpuAllocate(mMemoryTag, mMemoryUsage);
     }
 
     VertexBuffer::~VertexBuffer()
     {
+        MemoryTracker::OnGpuFree(mMemoryTag, mMemoryUsage);
         glDeleteBuffers(1, &mRendererID);
     }
 
@@ -56,15 +61,26 @@ namespace RealmFortress
     }
 
     IndexBuffer::IndexBuffer(u32* indices, u32 count)
-        : mCount(count)
+        : mCount(count), mFormat(IndexFormat::UInt32), mMemoryUsage(count * sizeof(u32)), mMemoryTag(MemoryTracker::GetCurrentTag())
     {
         glCreateBuffers(1, &mRendererID);
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mRendererID);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(u32), indices, GL_STATIC_DRAW);
+        MemoryTracker::OnGpuAllocate(mMemoryTag, mMemoryUsage);
+    }
+
+    IndexBuffer::IndexBuffer(u16* indices, u32 count)
+        : mCount(count), mFormat(IndexFormat::UInt16), mMemoryUsage(count * sizeof(u16)), mMemoryTag(MemoryTracker::GetCurrentTag())
+    {
+        glCreateBuffers(1, &mRendererID);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mRendererID);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(u16), indices, GL_STATIC_DRAW);
+        MemoryTracker::OnGpuAllocate(mMemoryTag, mMemoryUsage);
     }
 
     IndexBuffer::~IndexBuffer()
     {
+        MemoryTracker::OnGpuFree(mMemoryTag, mMemoryUsage);
         glDeleteBuffers(1, &mRendererID);
     }
 
@@ -82,4 +98,9 @@ namespace RealmFortress
     {
         return CreateRef<IndexBuffer>(indices, count);
     }
+
+    Ref<IndexBuffer> IndexBuffer::Create(u16* indices, u32 count)
+    {
+        return CreateRef<IndexBuffer>(indices, count);
+    }
 } // namespace RealmFortress
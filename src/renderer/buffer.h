@@ -7,6 +7,7 @@
 #pragma once
 
 #include "core/base.h"
+#include "core/memory_tracker.h"
 #include "core/logger.h"
 
 namespace RealmFortress
@@ -17,7 +18,8 @@ namespace RealmFortress
         Float, Float2, Float3, Float4,
         Mat3, Mat4,
         Int, Int2, Int3, Int4,
-        Bool
+        Bool,
+        Short4, Half2, Int2_10_10_10
     };
 
     static u32 ShaderDataTypeSize(ShaderDataType type)
@@ -35,6 +37,9 @@ namespace RealmFortress
             case ShaderDataType::Int3:   return 4 * 3;
             case ShaderDataType::Int4:   return 4 * 4;
             case ShaderDataType::Bool:   return 1;
+            case ShaderDataType::Short4: return 2 * 4;
+            case ShaderDataType::Half2:  return 2 * 2;
+            case ShaderDataType::Int2_10_10_10: return 4;
             default: break;
         }
         RF_CORE_ASSERT(false, "Unknown ShaderDataType!");
@@ -71,6 +76,9 @@ namespace RealmFortress
                 case ShaderDataType::Int3:   return 3;
                 case ShaderDataType::Int4:   return 4;
                 case ShaderDataType::Bool:   return 1;
+                case ShaderDataType::Short4: return 4;
+                case ShaderDataType::Half2:  return 2;
+                case ShaderDataType::Int2_10_10_10: return 4;
                 default: break;
             }
             RF_CORE_ASSERT(false, "Unknown ShaderDataType!");
@@ -135,23 +143,39 @@ namespace RealmFortress
     private:
         u32 mRendererID;
         BufferLayout mLayout;
+
+        // GPU memory goes on the tag current where the buffer was created
+        usize mMemoryUsage;
+        MemoryTag mMemoryTag;
+    };
+
+    enum class IndexFormat
+    {
+        UInt16, UInt32
     };
 
     class IndexBuffer
     {
     public:
         IndexBuffer(u32* indices, u32 count);
+        IndexBuffer(u16* indices, u32 count);
         ~IndexBuffer();
 
         void Bind() const;
         void Unbind() const;
 
         u32 GetCount() const { return mCount; }
+        IndexFormat GetFormat() const { return mFormat; }
 
         static Ref<IndexBuffer> Create(u32* indices, u32 count);
+        static Ref<IndexBuffer> Create(u16* indices, u32 count);
 
     private:
         u32 mRendererID;
         u32 mCount;
+        IndexFormat mFormat;
+
+        usize mMemoryUsage;
+        MemoryTag mMemoryTag;
     };
 } // namespace RealmFortress
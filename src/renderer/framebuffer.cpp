@@ -7,6 +7,7 @@
 #include "core/pch.h"
 #include "framebuffer.h"
 #include "core/logger.h"
+#include "core/memory_tracker.h"
 #include <glad/gl.h>
 
 namespace RealmFortress
@@ -83,6 +84,20 @@ namespace RealmFortress
 			return false;
 		}
 
+		// every format we support is 32 bits per sample
+		static usize BytesPerPixel(FramebufferTextureFormat format)
+		{
+			switch (format)
+			{
+			case FramebufferTextureFormat::RGBA8:           return 4;
+			case FramebufferTextureFormat::RED_INTEGER:     return 4;
+			case FramebufferTextureFormat::DEPTH24STENCIL8: return 4;
+			default: break;
+			}
+
+			return 0;
+		}
+
 		static GLenum HazelFBTextureFormatToGL(FramebufferTextureFormat format)
 		{
 			switch (format)
@@ -114,6 +129,7 @@ namespace RealmFortress
 
     Framebuffer::~Framebuffer()
     {
+        MemoryTracker::OnGpuFree(MemoryTag::Framebuffers, mMemoryUsage);
         glDeleteFramebuffers(1, &mRendererID);
         glDeleteTextures(mColorAttachments.size(), mColorAttachments.data());
         glDeleteTextures(1, &mDepthAttachment);
@@ -129,6 +145,9 @@ namespace RealmFortress
 
 			mColorAttachments.clear();
 			mDepthAttachment = 0;
+
+			MemoryTracker::OnGpuFree(MemoryTag::Framebuffers, mMemoryUsage);
+			mMemoryUsage = 0;
 		}
 
 		glCreateFramebuffers(1, &mRendererID);
@@ -185,6 +204,14 @@ namespace RealmFortress
 
 		RF_CORE_ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Framebuffer is incomplete!");
 
+		usize pixel_count = static_cast<usize>(mSpecification.Width) * mSpecification.Height * mSpecification.Samples;
+		for (const auto& attachment : mColorAttachmentSpecifications)
+		{
+			mMemoryUsage += pixel_count * Utils::BytesPerPixel(attachment.TextureFormat);
+		}
+		mMemoryUsage += pixel_count * Utils::BytesPerPixel(mDepthAttachmentSpecification.TextureFormat);
+		MemoryTracker::OnGpuAllocate(MemoryTag::Framebuffers, mMemoryUsage);
+
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
     }
 
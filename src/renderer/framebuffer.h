@@ -76,6 +76,7 @@ namespace RealmFortress
         u32 GetColorAttachmentRendererID(u32 index = 0) const { RF_CORE_ASSERT(index < mColorAttachments.size()); return mColorAttachments[index]; }
 
         const FramebufferSpecification& GetSpecification() const { return mSpecification; }
+        usize GetMemoryUsage() const { return mMemoryUsage; }
 
         static Ref<Framebuffer> Create(const FramebufferSpecification& spec);
 
@@ -88,5 +89,7 @@ namespace RealmFortress
 
         std::vector<uint32_t> mColorAttachments;
         uint32_t mDepthAttachment = 0;
+
+        usize mMemoryUsage = 0;
     };
 } // namespace RealmFortress
@@ -35,7 +35,7 @@ namespace RealmFortress
         glGetIntegerv(GL_MAJOR_VERSION, &major);
         glGetIntegerv(GL_MINOR_VERSION, &minor);
 
-        RF_CORE_ASSERT(major > 4 || (major == 4 && minor >= 6), "Realm Fortress requires at least OpenGL version 4.6!");
+        RF_CORE_ASSERT(major > 4 || (major == 4 && minor >= 5), "Realm Fortress requires at least OpenGL version 4.5!");
     }
 
     void GraphicsContext::SwapBuffers()
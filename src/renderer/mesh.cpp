@@ -7,27 +7,44 @@
 #include "mesh.h"
 #include "core/logger.h"
 #include "renderer/renderer.h"
+#include <glm/gtc/packing.hpp>
 
 namespace RealmFortress
 {
-    Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<u32>& indices, const std::vector<Ref<Texture2D>>& textures)
-        : mVertices(vertices), mIndices(indices), mTextures(textures)
+    Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<u32>& indices, const std::vector<Ref<Texture2D>>& textures, VertexFormat format)
+        : mVertices(vertices), mIndices(indices), mTextures(textures), mFormat(format)
     {
         SetupMesh();
     }
 
-    void Mesh::Draw(const Ref<Shader>& shader, const glm::mat4& transform)
+    usize Mesh::GetMemoryUsage() const
     {
-        for (u32 i = 0; i < mTextures.size(); i++)
+        usize vertex_size = mFormat == VertexFormat::Quantized ? sizeof(QuantizedVertex) : sizeof(Vertex);
+        usize index_size = mIndexBuffer->GetFormat() == IndexFormat::UInt16 ? sizeof(u16) : sizeof(u32);
+
+        usize bytes = mVertices.size() * vertex_size + mIndexBuffer->GetCount() * index_size;
+        for (const auto& texture : mTextures)
         {
-            mTextures[i]->Bind(i);
-            shader->SetInt("uTexture", i);
+            bytes += texture->GetMemoryUsage();
         }
+        return bytes;
+    }
+
+    void Mesh::Draw(const Ref<Shader>& shader, const glm::mat4& transform)
+    {
+        BindMaterial(shader);
 
         Renderer::DrawMesh(shader, mVertexArray, transform);
     }
 
-    void Mesh::DrawInstanced(const Ref<Shader>& shader, const std::vector<glm::mat4>& transforms)
+    void Mesh::DrawInstanced(const Ref<Shader>& shader, std::span<const glm::mat4> transforms)
+    {
+        BindMaterial(shader);
+
+        Renderer::DrawInstancedMesh(shader, mVertexArray, transforms);
+    }
+
+    void Mesh::BindMaterial(const Ref<Shader>& shader) const
     {
         for (u32 i = 0; i < mTextures.size(); i++)
         {
@@ -35,22 +52,89 @@ namespace RealmFortress
             shader->SetInt("uTexture", i);
         }
 
-        Renderer::DrawInstancedMesh(shader, mVertexArray, transforms);
+        shader->SetFloat3("uPositionScale", mPositionScale);
+        shader->SetFloat3("uPositionOffset", mPositionOffset);
     }
 
     void Mesh::SetupMesh()
     {
         mVertexArray = VertexArray::Create();
-        mVertexBuffer = VertexBuffer::Create(reinterpret_cast<float*>(mVertices.data()), mVertices.size() * sizeof(Vertex));
-        mVertexBuffer->SetLayout({
-            { ShaderDataType::Float3, "aPosition" },
-            { ShaderDataType::Float3, "aNormal" },
-            { ShaderDataType::Float2, "aTexCoords" }
-        });
+
+        if (mFormat == VertexFormat::Quantized)
+        {
+            std::vector<QuantizedVertex> packed = QuantizeVertices();
+            mVertexBuffer = VertexBuffer::Create(reinterpret_cast<float*>(packed.data()), packed.size() * sizeof(QuantizedVertex));
+            mVertexBuffer->SetLayout({
+                { ShaderDataType::Short4,        "aPosition", true },
+                { ShaderDataType::Int2_10_10_10, "aNormal",   true },
+                { ShaderDataType::Half2,         "aTexCoords" }
+            });
+        }
+        else
+        {
+            mVertexBuffer = VertexBuffer::Create(reinterpret_cast<float*>(mVertices.data()), mVertices.size() * sizeof(Vertex));
+            mVertexBuffer->SetLayout({
+                { ShaderDataType::Float3, "aPosition" },
+                { ShaderDataType::Float3, "aNormal" },
+                { ShaderDataType::Float2, "aTexCoords" }
+            });
+        }
 
         mVertexArray->AddVertexBuffer(mVertexBuffer);
 
-        mIndexBuffer = IndexBuffer::Create(mIndices.data(), mIndices.size());
+        if (mFormat == VertexFormat::Quantized && mVertices.size() <= 65536)
+        {
+            std::vector<u16> indices(mIndices.begin(), mIndices.end());
+            mIndexBuffer = IndexBuffer::Create(indices.data(), indices.size());
+        }
+        else
+        {
+            mIndexBuffer = IndexBuffer::Create(mIndices.data(), mIndices.size());
+        }
         mVertexArray->SetIndexBuffer(mIndexBuffer);
     }
+
+    std::vector<QuantizedVertex> Mesh::QuantizeVertices()
+    {
+        glm::vec3 min_bounds(std::numeric_limits<f32>::max());
+        glm::vec3 max_bounds(std::numeric_limits<f32>::lowest());
+        for (const auto& vertex : mVertices)
+        {
+            min_bounds = glm::min(min_bounds, vertex.mPosition);
+            max_bounds = glm::max(max_bounds, vertex.mPosition);
+        }
+
+        if (mVertices.empty())
+        {
+            min_bounds = max_bounds = glm::vec3(0.0f);
+        }
+
+        // positions are stored in [-1, 1] relative to the bounds, the shader scales them back
+        mPositionOffset = (min_bounds + max_bounds) * 0.5f;
+        mPositionScale = (max_bounds - min_bounds) * 0.5f;
+        for (i32 axis = 0; axis < 3; axis++)
+        {
+            if (mPositionScale[axis] <= 0.0f)
+                mPositionScale[axis] = 1.0f;
+        }
+
+        std::vector<QuantizedVertex> packed;
+        packed.reserve(mVertices.size());
+        for (const auto& vertex : mVertices)
+        {
+            glm::vec3 local = (vertex.mPosition - mPositionOffset) / mPositionScale;
+
+            QuantizedVertex quantized;
+            quantized.mPosition[0] = static_cast<i16>(glm::packSnorm1x16(local.x));
+            quantized.mPosition[1] = static_cast<i16>(glm::packSnorm1x16(local.y));
+            quantized.mPosition[2] = static_cast<i16>(glm::packSnorm1x16(local.z));
+            quantized.mPosition[3] = static_cast<i16>(glm::packSnorm1x16(1.0f));
+            quantized.mNormal = glm::packSnorm3x10_1x2(glm::vec4(vertex.mNormal, 0.0f));
+            quantized.mTexCoords[0] = glm::packHalf1x16(vertex.mTexCoords.x);
+            quantized.mTexCoords[1] = glm::packHalf1x16(vertex.mTexCoords.y);
+            packed.push_back(quantized);
+        }
+
+        return packed;
+    }
 } // namespace RealmFortress
@@ -11,6 +11,7 @@
 #include "renderer/shader.h"
 #include "renderer/texture.h"
 #include <glm/glm.hpp>
+#include <span>
 #include <vector>
 
 namespace RealmFortress
@@ -22,27 +23,57 @@ namespace RealmFortress
         glm::vec2 mTexCoords;
     };
 
+    /**
+     * @brief GPU-side vertex layout, selected per model.
+     *
+     * Standard uploads Vertex as-is (32 bytes). Quantized packs positions as snorm16
+     * relative to the mesh bounds, normals as snorm 10:10:10:2 and UVs as half floats
+     * (16 bytes), and uses 16-bit indices when the mesh has at most 65536 vertices.
+     * Shaders rebuild the position with `aPosition.xyz * uPositionScale + uPositionOffset`,
+     * which is the identity for Standard meshes. Only load a model as Quantized once the
+     * shaders that draw it apply those uniforms; without them it renders collapsed.
+     */
+    enum class VertexFormat
+    {
+        Standard, Quantized
+    };
+
+    struct QuantizedVertex
+    {
+        i16 mPosition[4];
+        u32 mNormal;
+        u16 mTexCoords[2];
+    };
+
     class Mesh
     {
     public:
-        Mesh(const std::vector<Vertex>& vertices, const std::vector<u32>& indices, const std::vector<Ref<Texture2D>>& textures);
+        Mesh(const std::vector<Vertex>& vertices, const std::vector<u32>& indices, const std::vector<Ref<Texture2D>>& textures, VertexFormat format = VertexFormat::Standard);
 
         void Draw(const Ref<Shader>& shader, const glm::mat4& transform = glm::mat4(1.0f));
-        void DrawInstanced(const Ref<Shader>& shader, const std::vector<glm::mat4>& transforms);
+        void DrawInstanced(const Ref<Shader>& shader, std::span<const glm::mat4> transforms);
 
         const std::vector<Vertex>& GetVertices() const { return mVertices; }
         const std::vector<u32>& GetIndices() const { return mIndices; }
         const std::vector<Ref<Texture2D>>& GetTextures() const { return mTextures; }
         Ref<VertexArray> GetVertexArray() const { return mVertexArray; }
+        VertexFormat GetVertexFormat() const { return mFormat; }
+        usize GetMemoryUsage() const;
 
     private:
         void SetupMesh();
+        std::vector<QuantizedVertex> QuantizeVertices();
+        void BindMaterial(const Ref<Shader>& shader) const;
 
     private:
         std::vector<Vertex> mVertices;
         std::vector<u32> mIndices;
         std::vector<Ref<Texture2D>> mTextures;
 
+        VertexFormat mFormat;
+        glm::vec3 mPositionScale{ 1.0f };
+        glm::vec3 mPositionOffset{ 0.0f };
+
         Ref<VertexArray> mVertexArray;
         Ref<VertexBuffer> mVertexBuffer;
         Ref<IndexBuffer> mIndexBuffer;
@@ -6,16 +6,125 @@
 
 #include "renderer/model.h"
 #include "core/logger.h"
+#include "core/file_system.h"
+#include "core/memory_tracker.h"
 #include "renderer/texture.h"
 #include <assimp/Importer.hpp>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
 namespace RealmFortress
 {
-    Model::Model(const std::string& path)
+    namespace
     {
-        LoadModel(path);
+        /**
+         * @brief Lets Assimp open the glTF file and its buffers through the FileSystem.
+         */
+        class FileSystemIOStream : public Assimp::IOStream
+        {
+        public:
+            FileSystemIOStream(FileData&& data)
+                : mData(std::move(data))
+            {
+            }
+
+            size_t Read(void* buffer, size_t size, size_t count) override
+            {
+                if (size == 0)
+                    return 0;
+
+                size_t available = (mData.Size() - mPosition) / size;
+                size_t read = std::min(count, available);
+                std::memcpy(buffer, mData.Data() + mPosition, read * size);
+                mPosition += read * size;
+                return read;
+            }
+
+            size_t Write(const void* buffer, size_t size, size_t count) override
+            {
+                return 0;
+            }
+
+            aiReturn Seek(size_t offset, aiOrigin origin) override
+            {
+                size_t target = 0;
+                switch (origin)
+                {
+                    case aiOrigin_SET: target = offset; break;
+                    case aiOrigin_CUR: target = mPosition + offset; break;
+                    case aiOrigin_END: target = mData.Size() - offset; break;
+                    default: return aiReturn_FAILURE;
+                }
+
+                if (target > mData.Size())
+                    return aiReturn_FAILURE;
+
+                mPosition = target;
+                return aiReturn_SUCCESS;
+            }
+
+            size_t Tell() const override { return mPosition; }
+            size_t FileSize() const override { return mData.Size(); }
+            void Flush() override {}
+
+        private:
+            FileData mData;
+            size_t mPosition = 0;
+        };
+
+        class FileSystemIOSystem : public Assimp::IOSystem
+        {
+        public:
+            bool Exists(const char* path) const override
+            {
+                return FileSystem::Exists(path);
+            }
+
+            char getOsSeparator() const override
+            {
+                return '/';
+            }
+
+            Assimp::IOStream* Open(const char* path, const char* mode) override
+            {
+                if (mode && std::strchr(mode, 'w'))
+                    return nullptr;
+
+                FileData data = FileSystem::Read(path);
+                return data ? new FileSystemIOStream(std::move(data)) : nullptr;
+            }
+
+            void Close(Assimp::IOStream* stream) override
+            {
+                delete stream;
+            }
+        };
+    }
+
+    Model::Model(const std::string& path, VertexFormat format)
+        : Model(Decode(path), format)
+    {
+    }
+
+    Model::Model(const ModelData& data, VertexFormat format)
+        : mFormat(format)
+    {
+        RF_MEMORY_TAG(MemoryTag::Models);
+
+        mMeshes.reserve(data.Meshes.size());
+        for (const auto& mesh_data : data.Meshes)
+        {
+            std::vector<Ref<Texture2D>> textures;
+            textures.reserve(mesh_data.Textures.size());
+            for (const auto& texture_data : mesh_data.Textures)
+            {
+                textures.push_back(Texture2D::Create(texture_data));
+            }
+
+            mMeshes.emplace_back(mesh_data.Vertices, mesh_data.Indices, textures, mFormat);
+        }
     }
 
     void Model::Draw(const Ref<Shader>& shader, const glm::mat4& transform)
@@ -26,7 +135,7 @@ namespace RealmFortress
         }
     }
 
-    void Model::DrawInstanced(const Ref<Shader>& shader, const std::vector<glm::mat4>& transforms)
+    void Model::DrawInstanced(const Ref<Shader>& shader, std::span<const glm::mat4> transforms)
     {
         for (auto& mesh : mMeshes)
         {
@@ -34,9 +143,25 @@ namespace RealmFortress
         }
     }
 
-    void Model::LoadModel(const std::string& path)
+    usize Model::GetMemoryUsage() const
+    {
+        usize bytes = 0;
+        for (const auto& mesh : mMeshes)
+        {
+            bytes += mesh.GetMemoryUsage();
+        }
+        return bytes;
+    }
+
+    ModelData Model::Decode(const std::string& path)
     {
+        RF_MEMORY_TAG(MemoryTag::Models);
+
+        ModelData data;
+        data.Path = path;
+
         Assimp::Importer importer;
+        importer.SetIOHandler(new FileSystemIOSystem());
         const aiScene* scene = importer.ReadFile(path,
             aiProcess_Triangulate |
             aiProcess_CalcTangentSpace |
@@ -50,32 +175,34 @@ namespace RealmFortress
         if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
         {
             RF_CORE_ERROR("Failed to load model: {}", importer.GetErrorString());
-            return;
+            return data;
         }
 
-        mDirectory = path.substr(0, path.find_last_of('/'));
-        ProcessNode(scene->mRootNode, scene);
+        std::string directory = path.substr(0, path.find_last_of('/'));
+        ProcessNode(scene->mRootNode, scene, directory, data);
+        data.Valid = true;
+        return data;
     }
 
-    void Model::ProcessNode(aiNode* node, const aiScene* scene)
+    void Model::ProcessNode(aiNode* node, const aiScene* scene, const std::string& directory, ModelData& data)
     {
         for (u32 i = 0; i < node->mNumMeshes; i++)
         {
             aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-            mMeshes.push_back(ProcessMesh(mesh, scene));
+            data.Meshes.push_back(ProcessMesh(mesh, scene, directory));
         }
 
         for (u32 i = 0; i < node->mNumChildren; i++)
         {
-            ProcessNode(node->mChildren[i], scene);
+            ProcessNode(node->mChildren[i], scene, directory, data);
         }
     }
 
-    Mesh Model::ProcessMesh(aiMesh* mesh, const aiScene* scene)
+    MeshData Model::ProcessMesh(aiMesh* mesh, const aiScene* scene, const std::string& directory)
     {
-        std::vector<Vertex> vertices;
-        std::vector<u32> indices;
-        std::vector<Ref<Texture2D>> textures;
+        MeshData data;
+        data.Vertices.reserve(mesh->mNumVertices);
+        data.Indices.reserve(mesh->mNumFaces * 3);
 
         for (u32 i = 0; i < mesh->mNumVertices; i++)
         {
@@ -112,39 +239,33 @@ namespace RealmFortress
                 vertex.mTexCoords = glm::vec2(0.0f);
             }
 
-            vertices.push_back(vertex);
+            data.Vertices.push_back(vertex);
         }
 
         for (u32 i = 0; i < mesh->mNumFaces; i++)
         {
             aiFace face = mesh->mFaces[i];
             for (u32 j = 0; j < face.mNumIndices; j++)
-                indices.push_back(face.mIndices[j]);
+                data.Indices.push_back(face.mIndices[j]);
         }
 
         aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
 
-        std::vector<Ref<Texture2D>> diffuse = LoadMaterialTextures(material, aiTextureType_DIFFUSE, "texture_diffuse");
-        textures.insert(textures.end(), diffuse.begin(), diffuse.end());
-
-        std::vector<Ref<Texture2D>> specular = LoadMaterialTextures(material, aiTextureType_SPECULAR, "texture_specular");
-        textures.insert(textures.end(), specular.begin(), specular.end());
+        LoadMaterialTextures(material, aiTextureType_DIFFUSE, directory, data.Textures);
+        LoadMaterialTextures(material, aiTextureType_SPECULAR, directory, data.Textures);
 
-        return Mesh(vertices, indices, textures);
+        return data;
     }
 
-    std::vector<Ref<Texture2D>> Model::LoadMaterialTextures(aiMaterial* mat, aiTextureType type, const std::string& name)
+    void Model::LoadMaterialTextures(aiMaterial* mat, aiTextureType type, const std::string& directory, std::vector<TextureData>& textures)
     {
-        std::vector<Ref<Texture2D>> textures;
         for (u32 i = 0; i < mat->GetTextureCount(type); i++)
         {
             aiString str;
             mat->GetTexture(type, i, &str);
 
-            std::string texturePath = mDirectory + "/" + std::string(str.C_Str());
-            auto texture = Texture2D::Create(texturePath);
-            textures.push_back(texture);
+            std::string texturePath = directory + "/" + std::string(str.C_Str());
+            textures.push_back(Texture2D::Decode(texturePath));
         }
-        return textures;
     }
 } // namespace RealmFortress
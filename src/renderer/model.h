@@ -10,31 +10,54 @@
 #include "renderer/mesh.h"
 #include "renderer/shader.h"
 #include <assimp/scene.h>
+#include <span>
 #include <string>
 #include <vector>
 
 namespace RealmFortress
 {
+    struct MeshData
+    {
+        std::vector<Vertex> Vertices;
+        std::vector<u32> Indices;
+        std::vector<TextureData> Textures;
+    };
+
+    /**
+     * @brief Everything read from a model file before any GL object exists.
+     *
+     * Decoding only touches the file system, Assimp and stb, so it can run on worker threads;
+     * constructing a Model from it does the GL upload and must happen on the render thread.
+     */
+    struct ModelData
+    {
+        std::string Path;
+        std::vector<MeshData> Meshes;
+        bool Valid = false;
+    };
+
     class Model
     {
     public:
-        Model(const std::string& path);
+        Model(const std::string& path, VertexFormat format = VertexFormat::Standard);
+        Model(const ModelData& data, VertexFormat format = VertexFormat::Standard);
 
         void Draw(const Ref<Shader>& shader, const glm::mat4& transform = glm::mat4(1.0f));
-        void DrawInstanced(const Ref<Shader>& shader, const std::vector<glm::mat4>& transforms);
+        void DrawInstanced(const Ref<Shader>& shader, std::span<const glm::mat4> transforms);
 
         const std::vector<Mesh>& GetMeshes() const { return mMeshes; }
+        VertexFormat GetVertexFormat() const { return mFormat; }
+        usize GetMemoryUsage() const;
 
-    private:
-        void LoadModel(const std::string& path);
-        void ProcessNode(aiNode* node, const aiScene* scene);
-
-        Mesh ProcessMesh(aiMesh* mesh, const aiScene* scene);
+        static ModelData Decode(const std::string& path);
 
-        std::vector<Ref<Texture2D>> LoadMaterialTextures(aiMaterial* mat, aiTextureType type, const std::string& name);
+    private:
+        static void ProcessNode(aiNode* node, const aiScene* scene, const std::string& directory, ModelData& data);
+        static MeshData ProcessMesh(aiMesh* mesh, const aiScene* scene, const std::string& directory);
+        static void LoadMaterialTextures(aiMaterial* mat, aiTextureType type, const std::string& directory, std::vector<TextureData>& textures);
 
     private:
         std::vector<Mesh> mMeshes;
-        std::string mDirectory;
+        VertexFormat mFormat;
     };
 } // namespace RealmFortress
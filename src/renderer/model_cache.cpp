@@ -6,52 +6,302 @@
 
 #include "core/pch.h"
 #include "model_cache.h"
+#include "core/profiler.h"
 
 namespace RealmFortress
 {
-    std::unordered_map<std::string, Ref<Model>> ModelCache::sModels;
+    std::array<ModelCache::Slot, ModelCache::MaxModels> ModelCache::sSlots;
+    std::unordered_map<std::string, ModelHandle> ModelCache::sPaths;
+    std::vector<u32> ModelCache::sFreeSlots;
+    std::vector<ModelCache::PendingUpload> ModelCache::sPendingUploads;
+    std::mutex ModelCache::sMutex;
 
-    Ref<Model> ModelCache::Load(const std::string& path)
+    void ModelCache::Init()
     {
-        if (sModels.contains(path))
+        sMainThread = std::this_thread::get_id();
+
+        std::lock_guard lock(sMutex);
+        sFreeSlots.clear();
+        sFreeSlots.reserve(MaxModels - 1);
+        // slot 0 is never handed out so that a zero handle stays null
+        for (u32 index = MaxModels - 1; index > 0; index--)
         {
-            // RF_CORE_TRACE("Model cache hit: {}", path);
-            return sModels[path];
+            sFreeSlots.push_back(index);
         }
+    }
+
+    void ModelCache::Shutdown()
+    {
+        Clear();
+    }
+
+    void ModelCache::OnUpdate()
+    {
+        RF_CORE_ASSERT(IsMainThread(), "ModelCache::OnUpdate must run on the main thread");
 
-        try
+        std::vector<PendingUpload> uploads;
         {
-            auto model = CreateRef<Model>(path);
-            sModels[path] = model;
-            // RF_CORE_INFO("Model loaded and cached: {}", path);
-            return model;
+            std::lock_guard lock(sMutex);
+            uploads.swap(sPendingUploads);
         }
-        catch (const std::exception& e)
+
+        for (auto& upload : uploads)
         {
-            RF_CORE_ERROR("Failed to load model {}: {}", path, e.what());
-            return nullptr;
+            if (ResolveSlot(upload.Handle))
+            {
+                Publish(upload.Handle, CreateScope<Model>(upload.Data, sSlots[HandleIndex(upload.Handle)].Format));
+            }
+        }
+
+        sFrame.fetch_add(1, std::memory_order_relaxed);
+        EvictOverBudget();
+    }
+
+    ModelHandle ModelCache::Load(const std::string& path, VertexFormat format)
+    {
+        RF_PROFILE_SCOPE("ModelCache::Load");
+
+        ModelHandle handle = NullModelHandle;
+        {
+            std::lock_guard lock(sMutex);
+            auto [it, inserted] = sPaths.try_emplace(path, NullModelHandle);
+            if (!inserted)
+            {
+                if (sSlots[HandleIndex(it->second)].Format != format)
+                {
+                    RF_CORE_WARN("Model {} is already cached with a different vertex format", path);
+                }
+                return it->second;
+            }
+
+            if (sWarnOnLoad)
+            {
+                RF_CORE_WARN_RATE_LIMITED("Model {} was not preloaded, loading it on demand", path);
+            }
+
+            handle = ReserveSlot(path, format);
+            if (handle == NullModelHandle)
+            {
+                sPaths.erase(it);
+                return NullModelHandle;
+            }
+            it->second = handle;
+        }
+
+        // decode outside the lock, other threads only see a handle that resolves to nullptr meanwhile
+        ModelData data = Model::Decode(path);
+        if (!data.Valid)
+        {
+            RF_CORE_ERROR("Failed to load model {}", path);
+            std::lock_guard lock(sMutex);
+            Evict(HandleIndex(handle));
+            return NullModelHandle;
+        }
+
+        if (IsMainThread())
+        {
+            Publish(handle, CreateScope<Model>(data, format));
         }
+        else
+        {
+            std::lock_guard lock(sMutex);
+            sPendingUploads.push_back({ handle, std::move(data) });
+        }
+
+        return handle;
+    }
+
+    ModelHandle ModelCache::Add(const std::string& path, VertexFormat format, Scope<Model> model)
+    {
+        ModelHandle handle = NullModelHandle;
+        {
+            std::lock_guard lock(sMutex);
+            auto [it, inserted] = sPaths.try_emplace(path, NullModelHandle);
+            if (!inserted)
+            {
+                return it->second;
+            }
+
+            handle = ReserveSlot(path, format);
+            if (handle == NullModelHandle)
+            {
+                sPaths.erase(it);
+                return NullModelHandle;
+            }
+            it->second = handle;
+        }
+
+        Publish(handle, std::move(model));
+        return handle;
+    }
+
+    ModelHandle ModelCache::Find(const std::string& path)
+    {
+        std::lock_guard lock(sMutex);
+        auto it = sPaths.find(path);
+        return it != sPaths.end() ? it->second : NullModelHandle;
     }
 
-    Ref<Model> ModelCache::Get(const std::string& path)
+    Model* ModelCache::Get(ModelHandle handle)
     {
-        auto it = sModels.find(path);
-        return it != sModels.end() ? it->second : nullptr;
+        Slot* slot = ResolveSlot(handle);
+        if (!slot)
+            return nullptr;
+
+        Model* model = slot->Instance.load(std::memory_order_acquire);
+        if (model)
+        {
+            slot->LastUsedFrame.store(sFrame.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        return model;
     }
 
     bool ModelCache::Exists(const std::string& path)
     {
-        return sModels.contains(path);
+        return Find(path) != NullModelHandle;
+    }
+
+    void ModelCache::Acquire(ModelHandle handle)
+    {
+        if (Slot* slot = ResolveSlot(handle))
+        {
+            slot->RefCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void ModelCache::Release(ModelHandle handle)
+    {
+        if (Slot* slot = ResolveSlot(handle))
+        {
+            slot->RefCount.fetch_sub(1, std::memory_order_acq_rel);
+        }
     }
 
     void ModelCache::Clear()
     {
-        RF_CORE_INFO("Clearing model cache ({} models)", sModels.size());
-        sModels.clear();
+        std::lock_guard lock(sMutex);
+        RF_CORE_INFO("Clearing model cache ({} models)", sPaths.size());
+
+        sPendingUploads.clear();
+        for (u32 index = 1; index < MaxModels; index++)
+        {
+            if (sSlots[index].InUse)
+            {
+                Evict(index);
+            }
+        }
     }
 
     usize ModelCache::GetCachedCount()
     {
-        return sModels.size();
+        std::lock_guard lock(sMutex);
+        return sPaths.size();
+    }
+
+    ModelCache::Slot* ModelCache::ResolveSlot(ModelHandle handle)
+    {
+        u32 index = HandleIndex(handle);
+        if (index == 0 || index >= MaxModels)
+            return nullptr;
+
+        Slot& slot = sSlots[index];
+        if (slot.Generation.load(std::memory_order_acquire) != HandleGeneration(handle))
+            return nullptr;
+
+        return &slot;
+    }
+
+    ModelHandle ModelCache::ReserveSlot(const std::string& path, VertexFormat format)
+    {
+        if (sFreeSlots.empty())
+        {
+            RF_CORE_ERROR("Model cache is full ({} models), cannot load {}", MaxModels - 1, path);
+            return NullModelHandle;
+        }
+
+        u32 index = sFreeSlots.back();
+        sFreeSlots.pop_back();
+
+        Slot& slot = sSlots[index];
+        slot.InUse = true;
+        slot.Path = path;
+        slot.Format = format;
+        slot.MemoryUsage = 0;
+        slot.RefCount.store(0, std::memory_order_relaxed);
+        slot.LastUsedFrame.store(sFrame.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+        return MakeHandle(index, slot.Generation.load(std::memory_order_relaxed));
+    }
+
+    void ModelCache::Publish(ModelHandle handle, Scope<Model> model)
+    {
+        usize memory_usage = model->GetMemoryUsage();
+
+        std::lock_guard lock(sMutex);
+        Slot* slot = ResolveSlot(handle);
+        if (!slot)
+            return;
+
+        slot->MemoryUsage = memory_usage;
+        slot->Owner = std::move(model);
+        slot->Instance.store(slot->Owner.get(), std::memory_order_release);
+        sMemoryUsage.fetch_add(memory_usage, std::memory_order_relaxed);
+    }
+
+    void ModelCache::Evict(u32 index)
+    {
+        Slot& slot = sSlots[index];
+
+        // bump the generation first so every outstanding handle stops resolving
+        slot.Instance.store(nullptr, std::memory_order_release);
+        u32 generation = (slot.Generation.load(std::memory_order_relaxed) + 1) & 0xFFFF;
+        slot.Generation.store(generation != 0 ? generation : 1, std::memory_order_release);
+
+        sPaths.erase(slot.Path);
+        sMemoryUsage.fetch_sub(slot.MemoryUsage, std::memory_order_relaxed);
+
+        slot.Owner.reset();
+        slot.Path.clear();
+        slot.MemoryUsage = 0;
+        slot.InUse = false;
+        sFreeSlots.push_back(index);
+    }
+
+    void ModelCache::EvictOverBudget()
+    {
+        if (sMemoryUsage.load(std::memory_order_relaxed) <= sMemoryBudget)
+            return;
+
+        std::lock_guard lock(sMutex);
+
+        std::vector<u32> candidates;
+        for (u32 index = 1; index < MaxModels; index++)
+        {
+            const Slot& slot = sSlots[index];
+            if (slot.InUse && slot.Instance.load(std::memory_order_relaxed) && slot.RefCount.load(std::memory_order_acquire) == 0)
+            {
+                candidates.push_back(index);
+            }
+        }
+
+        std::ranges::sort(candidates, [](u32 a, u32 b)
+        {
+            return sSlots[a].LastUsedFrame.load(std::memory_order_relaxed) < sSlots[b].LastUsedFrame.load(std::memory_order_relaxed);
+        });
+
+        usize evicted = 0;
+        for (u32 index : candidates)
+        {
+            if (sMemoryUsage.load(std::memory_order_relaxed) <= sMemoryBudget)
+                break;
+
+            Evict(index);
+            evicted++;
+        }
+
+        if (evicted > 0)
+        {
+            RF_CORE_INFO("Evicted {} models, cache now uses {:.1f} MB", evicted, static_cast<f64>(sMemoryUsage.load()) / (1024.0 * 1024.0));
+        }
     }
 } // namespace RealmFortress
@@ -8,21 +8,110 @@
 
 #include "core/base.h"
 #include "renderer/model.h"
+#include <array>
+#include <atomic>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 
 namespace RealmFortress
 {
+    /**
+     * @brief Small integer reference to a cached model: slot index in the low 16 bits,
+     * slot generation in the high 16 bits. 0 is never a valid handle.
+     */
+    using ModelHandle = u32;
+    constexpr ModelHandle NullModelHandle = 0;
+
+    /**
+     * @class ModelCache
+     * @brief Owns every loaded model and hands out ModelHandles to them.
+     *
+     * Get() is lock-free and may be called from any thread; a handle whose model was evicted
+     * simply resolves to nullptr. Path lookups and loading take a mutex. Loads requested from
+     * a worker thread decode on that thread and queue the GL upload, which OnUpdate() performs
+     * on the main thread; the handle resolves once it is done.
+     *
+     * Owners (chunks, buildings) Acquire() the handles they draw. Models nobody holds stay
+     * cached until the cache exceeds its memory budget, then the least recently used go first.
+     * Eviction only happens inside OnUpdate(), so a Model* obtained on the main thread stays
+     * valid for the rest of the frame.
+     */
     class ModelCache
     {
     public:
-        static Ref<Model> Load(const std::string& path);
-        static Ref<Model> Get(const std::string& path);
+        static void Init();
+        static void Shutdown();
+
+        // main thread, once per frame: finishes queued uploads and evicts over budget
+        static void OnUpdate();
+
+        static ModelHandle Load(const std::string& path, VertexFormat format = VertexFormat::Standard);
+        static ModelHandle Add(const std::string& path, VertexFormat format, Scope<Model> model);
+        static ModelHandle Find(const std::string& path);
+        static Model* Get(ModelHandle handle);
         static bool Exists(const std::string& path);
+
+        static void Acquire(ModelHandle handle);
+        static void Release(ModelHandle handle);
+
         static void Clear();
         static usize GetCachedCount();
+        static usize GetMemoryUsage() { return sMemoryUsage.load(std::memory_order_relaxed); }
+
+        static void SetMemoryBudget(usize bytes) { sMemoryBudget = bytes; }
+        static usize GetMemoryBudget() { return sMemoryBudget; }
+
+        // once assets are preloaded, a cache miss means a stall on the hot path
+        static void SetWarnOnLoad(bool enabled) { sWarnOnLoad = enabled; }
 
     private:
-        static std::unordered_map<std::string, Ref<Model>> sModels;
+        static constexpr u32 MaxModels = 1024;
+
+        struct Slot
+        {
+            std::atomic<Model*> Instance{ nullptr };
+            std::atomic<u32> Generation{ 1 };
+            std::atomic<i32> RefCount{ 0 };
+            std::atomic<u64> LastUsedFrame{ 0 };
+
+            // guarded by sMutex
+            Scope<Model> Owner;
+            std::string Path;
+            VertexFormat Format{ VertexFormat::Standard };
+            usize MemoryUsage{ 0 };
+            bool InUse{ false };
+        };
+
+        struct PendingUpload
+        {
+            ModelHandle Handle;
+            ModelData Data;
+        };
+
+        static ModelHandle MakeHandle(u32 index, u32 generation) { return (generation << 16) | index; }
+        static u32 HandleIndex(ModelHandle handle) { return handle & 0xFFFF; }
+        static u32 HandleGeneration(ModelHandle handle) { return handle >> 16; }
+
+        static Slot* ResolveSlot(ModelHandle handle);
+        static ModelHandle ReserveSlot(const std::string& path, VertexFormat format);
+        static void Publish(ModelHandle handle, Scope<Model> model);
+        static void Evict(u32 index);
+        static void EvictOverBudget();
+        static bool IsMainThread() { return std::this_thread::get_id() == sMainThread; }
+
+    private:
+        static std::array<Slot, MaxModels> sSlots;
+        static std::unordered_map<std::string, ModelHandle> sPaths;
+        static std::vector<u32> sFreeSlots;
+        static std::vector<PendingUpload> sPendingUploads;
+        static std::mutex sMutex;
+
+        inline static std::thread::id sMainThread;
+        inline static std::atomic<u64> sFrame{ 1 };
+        inline static std::atomic<usize> sMemoryUsage{ 0 };
+        inline static usize sMemoryBudget{ 256ull * 1024 * 1024 };
+        inline static bool sWarnOnLoad{ false };
     };
 } // namespace RealmFortress
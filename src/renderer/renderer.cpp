@@ -6,6 +6,9 @@
 
 #include "renderer.h"
 #include "core/logger.h"
+#include "core/frame_allocator.h"
+#include "core/memory_tracker.h"
+#include "renderer/model_cache.h"
 #include <glad/gl.h>
 
 namespace RealmFortress
@@ -14,6 +17,11 @@ namespace RealmFortress
     Renderer::Statistics Renderer::sStats;
     u32 Renderer::sInstanceVBO = 0;
 
+    static GLenum IndexFormatToOpenGLType(IndexFormat format)
+    {
+        return format == IndexFormat::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    }
+
     void Renderer::Init()
     {
         RF_CORE_INFO("Initializing Renderer (OpenGL)");
@@ -49,11 +57,14 @@ namespace RealmFortress
         glEnable(GL_LINE_SMOOTH);
 
         glGenBuffers(1, &sInstanceVBO);
+
+        ModelCache::Init();
     }
 
     void Renderer::Shutdown()
     {
         RF_CORE_INFO("Shutting down Renderer");
+        ModelCache::Shutdown();
     }
 
     void Renderer::OnWindowResize(u32 width, u32 height)
@@ -64,6 +75,8 @@ namespace RealmFortress
     void Renderer::BeginFrame()
     {
         ResetStats();
+        FrameAllocator::Reset();
+        MemoryTracker::BeginFrame();
     }
 
     void Renderer::EndFrame()
@@ -93,7 +106,7 @@ namespace RealmFortress
     void Renderer::DrawInstancedMesh(
         const Ref<Shader>&            shader,
         const Ref<VertexArray>&       vertex_array,
-        const std::vector<glm::mat4>& transforms
+        std::span<const glm::mat4>    transforms
     )
     {
         if (transforms.empty()) return;
@@ -113,8 +126,9 @@ namespace RealmFortress
             glVertexAttribDivisor(3 + i, 1); // บอกว่าเป็นข้อมูลต่อ 1 Instance ไม่ใช่ต่อ Vertex
         }
 
-        u32 count = vertex_array->GetIndexBuffer()->GetCount();
-        glDrawElementsInstanced(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr, (GLsizei)transforms.size());
+        const auto& index_buffer = vertex_array->GetIndexBuffer();
+        u32 count = index_buffer->GetCount();
+        glDrawElementsInstanced(GL_TRIANGLES, count, IndexFormatToOpenGLType(index_buffer->GetFormat()), nullptr, (GLsizei)transforms.size());
 
         for (int i = 0; i < 4; i++)
         {
@@ -126,14 +140,16 @@ namespace RealmFortress
         sStats.DrawCalls++;
         sStats.IndexCount += count * static_cast<u32>(transforms.size());
         sStats.TriangleCount += (count / 3) * static_cast<u32>(transforms.size());
+        sStats.InstanceCount += static_cast<u32>(transforms.size());
     }
 
     void Renderer::DrawIndexed(const Ref<VertexArray>& vertex_array, u32 index_count)
     {
         vertex_array->Bind();
-        u32 count = index_count ? index_count : vertex_array->GetIndexBuffer()->GetCount();
+        const auto& index_buffer = vertex_array->GetIndexBuffer();
+        u32 count = index_count ? index_count : index_buffer->GetCount();
 
-        glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
+        glDrawElements(GL_TRIANGLES, count, IndexFormatToOpenGLType(index_buffer->GetFormat()), nullptr);
 
         sStats.DrawCalls++;
         sStats.IndexCount += count;
@@ -11,6 +11,7 @@
 #include "renderer/shader.h"
 #include "scene/camera.h"
 #include <glm/glm.hpp>
+#include <span>
 
 namespace RealmFortress
 {
@@ -43,7 +44,7 @@ namespace RealmFortress
         static void DrawInstancedMesh(
             const Ref<Shader>&            shader,
             const Ref<VertexArray>&       vertex_array,
-            const std::vector<glm::mat4>& transforms
+            std::span<const glm::mat4>    transforms
         );
 
         static void DrawIndexed(const Ref<VertexArray>& vertex_array,
@@ -68,6 +69,7 @@ namespace RealmFortress
             u32 VertexCount = 0;
             u32 IndexCount = 0;
             u32 TriangleCount = 0;
+            u32 InstanceCount = 0;
 
             void Reset()
             {
@@ -75,6 +77,7 @@ namespace RealmFortress
                 VertexCount = 0;
                 IndexCount = 0;
                 TriangleCount = 0;
+                InstanceCount = 0;
             }
         };
 
@@ -6,10 +6,9 @@
 
 #include "shader.h"
 #include "core/logger.h"
+#include "core/file_system.h"
 #include <glad/gl.h>
 #include <glm/gtc/type_ptr.hpp>
-#include <fstream>
-#include <sstream>
 
 namespace RealmFortress
 {
@@ -35,15 +34,8 @@ namespace RealmFortress
 
     Shader::Shader(const std::string& filepath)
     {
-        std::string source;
-        std::ifstream file(filepath);
-        if (file)
-        {
-            std::stringstream ss;
-            ss << file.rdbuf();
-            source = ss.str();
-        }
-        else
+        std::string source = FileSystem::ReadText(filepath);
+        if (source.empty())
         {
             RF_CORE_ERROR("Failed to read shader file: {}", filepath);
             return;
@@ -91,42 +83,42 @@ namespace RealmFortress
         glUseProgram(0);
     }
 
-    void Shader::SetInt(const std::string& name, int value) const
+    void Shader::SetInt(std::string_view name, int value) const
     {
         glUniform1i(GetUniformLocation(name), value);
     }
 
-    void Shader::SetIntArray(const std::string& name, int* values, unsigned int count) const
+    void Shader::SetIntArray(std::string_view name, int* values, unsigned int count) const
     {
         glUniform1iv(GetUniformLocation(name), count, values);
     }
 
-    void Shader::SetFloat(const std::string& name, float value) const
+    void Shader::SetFloat(std::string_view name, float value) const
     {
         glUniform1f(GetUniformLocation(name), value);
     }
 
-    void Shader::SetFloat2(const std::string& name, const glm::vec2& value) const
+    void Shader::SetFloat2(std::string_view name, const glm::vec2& value) const
     {
         glUniform2f(GetUniformLocation(name), value.x, value.y);
     }
 
-    void Shader::SetFloat3(const std::string& name, const glm::vec3& value) const
+    void Shader::SetFloat3(std::string_view name, const glm::vec3& value) const
     {
         glUniform3f(GetUniformLocation(name), value.x, value.y, value.z);
     }
 
-    void Shader::SetFloat4(const std::string& name, const glm::vec4& value) const
+    void Shader::SetFloat4(std::string_view name, const glm::vec4& value) const
     {
         glUniform4f(GetUniformLocation(name), value.x, value.y, value.z, value.w);
     }
 
-    void Shader::SetMat3(const std::string& name, const glm::mat3& value) const
+    void Shader::SetMat3(std::string_view name, const glm::mat3& value) const
     {
         glUniformMatrix3fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value));
     }
 
-    void Shader::SetMat4(const std::string& name, const glm::mat4& value) const
+    void Shader::SetMat4(std::string_view name, const glm::mat4& value) const
     {
         glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(value));
     }
@@ -201,13 +193,16 @@ namespace RealmFortress
         mRendererID = program;
     }
 
-    i32 Shader::GetUniformLocation(const std::string& name) const
+    i32 Shader::GetUniformLocation(std::string_view name) const
     {
-        if (mUniformLocationCache.contains(name))
-            return mUniformLocationCache[name];
+        auto it = mUniformLocationCache.find(name);
+        if (it != mUniformLocationCache.end())
+            return it->second;
 
-        int location = glGetUniformLocation(mRendererID, name.c_str());
-        mUniformLocationCache[name] = location;
+        // GL wants a terminated string; only the first lookup of each name pays for the copy
+        std::string key(name);
+        int location = glGetUniformLocation(mRendererID, key.c_str());
+        mUniformLocationCache.emplace(std::move(key), location);
         return location;
     }
 
@@ -9,6 +9,7 @@
 #include "core/base.h"
 #include <glm/glm.hpp>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 namespace RealmFortress
@@ -29,14 +30,14 @@ namespace RealmFortress
         void Bind() const;
         void Unbind() const;
 
-        void SetInt(const std::string& name, i32 value) const;
-        void SetIntArray(const std::string& name, i32* values, u32 count) const;
-        void SetFloat(const std::string& name, f32 value) const;
-        void SetFloat2(const std::string& name, const glm::vec2& value) const;
-        void SetFloat3(const std::string& name, const glm::vec3& value) const;
-        void SetFloat4(const std::string& name, const glm::vec4& value) const;
-        void SetMat3(const std::string& name, const glm::mat3& value) const;
-        void SetMat4(const std::string& name, const glm::mat4& value) const;
+        void SetInt(std::string_view name, i32 value) const;
+        void SetIntArray(std::string_view name, i32* values, u32 count) const;
+        void SetFloat(std::string_view name, f32 value) const;
+        void SetFloat2(std::string_view name, const glm::vec2& value) const;
+        void SetFloat3(std::string_view name, const glm::vec3& value) const;
+        void SetFloat4(std::string_view name, const glm::vec4& value) const;
+        void SetMat3(std::string_view name, const glm::mat3& value) const;
+        void SetMat4(std::string_view name, const glm::mat4& value) const;
 
         const std::string& GetName() const { return mName; }
 
@@ -45,12 +46,19 @@ namespace RealmFortress
 
     private:
         void Compile(const std::unordered_map<u32, std::string>& shaderSources);
-        i32 GetUniformLocation(const std::string& name) const;
+        i32 GetUniformLocation(std::string_view name) const;
 
     private:
         u32 mRendererID;
         std::string mName;
-        mutable std::unordered_map<std::string, i32> mUniformLocationCache;
+        // looked up by string_view, so setting a uniform from a literal builds no std::string
+        struct UniformNameHash
+        {
+            using is_transparent = void;
+            usize operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+        };
+
+        mutable std::unordered_map<std::string, i32, UniformNameHash, std::equal_to<>> mUniformLocationCache;
     };
 
     class ShaderLibrary
@@ -6,12 +6,88 @@
 
 #include "texture.h"
 #include "core/logger.h"
+#include "core/file_system.h"
+#include "renderer/texture_format.h"
 #include <glad/gl.h>
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
+// S3TC is an extension in the core profile loader, but every desktop driver exposes it
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#   define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#   define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
 namespace RealmFortress
 {
+    static GLenum VkFormatToOpenGLFormat(u32 vk_format)
+    {
+        switch (vk_format)
+        {
+            case VK_FORMAT_BC1_RGB_UNORM_BLOCK: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            case VK_FORMAT_BC3_UNORM_BLOCK:     return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case VK_FORMAT_BC7_UNORM_BLOCK:     return GL_COMPRESSED_RGBA_BPTC_UNORM;
+            default: break;
+        }
+        return 0;
+    }
+
+    static u32 CalculateMipCount(u32 width, u32 height)
+    {
+        return static_cast<u32>(std::floor(std::log2(std::max(width, height)))) + 1;
+    }
+
+    static bool ParseKTX2(FileData&& file, TextureData& out)
+    {
+        if (file.Size() < sizeof(KTX2Header))
+            return false;
+
+        const auto* header = reinterpret_cast<const KTX2Header*>(file.Data());
+        if (std::memcmp(header->Identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0)
+            return false;
+
+        GLenum format = VkFormatToOpenGLFormat(header->VkFormat);
+        if (!format || header->SupercompressionScheme != 0 || header->LevelCount == 0)
+        {
+            RF_CORE_WARN("Unsupported KTX2 texture: {} (vkFormat {})", out.Path, header->VkFormat);
+            return false;
+        }
+
+        // more levels than the full chain down to 1x1 would shift the dimensions out of range
+        if (header->PixelWidth == 0 || header->PixelHeight == 0 || header->LevelCount > CalculateMipCount(header->PixelWidth, header->PixelHeight))
+            return false;
+
+        usize index_end = sizeof(KTX2Header) + sizeof(KTX2LevelIndex) * header->LevelCount;
+        if (file.Size() < index_end)
+            return false;
+
+        std::vector<TextureMip> mips;
+        const auto* levels = reinterpret_cast<const KTX2LevelIndex*>(file.Data() + sizeof(KTX2Header));
+        for (u32 level = 0; level < header->LevelCount; level++)
+        {
+            // compared this way round so a huge offset can't wrap the sum past the check
+            if (levels[level].ByteOffset > file.Size() || levels[level].ByteLength > file.Size() - levels[level].ByteOffset)
+                return false;
+
+            TextureMip mip;
+            mip.Width = std::max(1u, header->PixelWidth >> level);
+            mip.Height = std::max(1u, header->PixelHeight >> level);
+            mip.Data = file.Data() + levels[level].ByteOffset;
+            mip.Size = levels[level].ByteLength;
+            mips.push_back(mip);
+        }
+
+        out.Mips = std::move(mips);
+        out.Width = header->PixelWidth;
+        out.Height = header->PixelHeight;
+        out.Channels = header->VkFormat == VK_FORMAT_BC1_RGB_UNORM_BLOCK ? 3 : 4;
+        out.CompressedFormat = format;
+        out.Source = std::move(file);
+        return true;
+    }
+
     Texture2D::Texture2D(u32 width, u32 height)
         : mWidth(width), mHeight(height)
     {
@@ -20,6 +96,8 @@ namespace RealmFortress
 
         glCreateTextures(GL_TEXTURE_2D, 1, &mRendererID);
         glTextureStorage2D(mRendererID, 1, mInternalFormat, mWidth, mHeight);
+        mMemoryUsage = static_cast<usize>(mWidth) * mHeight * 4;
+        MemoryTracker::OnGpuAllocate(MemoryTag::Textures, mMemoryUsage);
 
         glTextureParameteri(mRendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTextureParameteri(mRendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -29,56 +107,87 @@ namespace RealmFortress
     }
 
     Texture2D::Texture2D(const std::string& path)
-        : mPath(path)
+        : Texture2D(Decode(path))
     {
-        i32 width, height, channels;
-        stbi_set_flip_vertically_on_load(0);
-        stbi_uc* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+    }
 
-        if (data)
+    Texture2D::Texture2D(const TextureData& data)
+        : mPath(data.Path), mWidth(data.Width), mHeight(data.Height)
+    {
+        if (!data.IsValid())
         {
-            mWidth = width;
-            mHeight = height;
+            RF_CORE_ERROR("Failed to load texture: {}", data.Path);
+            return;
+        }
 
-            GLenum internalFormat = 0, dataFormat = 0;
-            if (channels == 4)
-            {
-                internalFormat = GL_RGBA8;
-                dataFormat = GL_RGBA;
-            }
-            else if (channels == 3)
+        if (data.IsCompressed())
+        {
+            mInternalFormat = data.CompressedFormat;
+            mDataFormat = data.Channels == 4 ? GL_RGBA : GL_RGB;
+
+            glCreateTextures(GL_TEXTURE_2D, 1, &mRendererID);
+            glTextureStorage2D(mRendererID, static_cast<GLsizei>(data.Mips.size()), mInternalFormat, mWidth, mHeight);
+
+            for (usize level = 0; level < data.Mips.size(); level++)
             {
-                internalFormat = GL_RGB8;
-                dataFormat = GL_RGB;
+                const TextureMip& mip = data.Mips[level];
+                glCompressedTextureSubImage2D(mRendererID, static_cast<GLint>(level), 0, 0, mip.Width, mip.Height,
+                    mInternalFormat, static_cast<GLsizei>(mip.Size), mip.Data);
+                mMemoryUsage += mip.Size;
             }
+            MemoryTracker::OnGpuAllocate(MemoryTag::Textures, mMemoryUsage);
+
+            SetupSampler(static_cast<u32>(data.Mips.size()));
+            return;
+        }
 
-            mInternalFormat = internalFormat;
-            mDataFormat = dataFormat;
+        GLenum internalFormat = 0, dataFormat = 0;
+        if (data.Channels == 4)
+        {
+            internalFormat = GL_RGBA8;
+            dataFormat = GL_RGBA;
+        }
+        else if (data.Channels == 3)
+        {
+            internalFormat = GL_RGB8;
+            dataFormat = GL_RGB;
+        }
 
-            RF_CORE_ASSERT(internalFormat & dataFormat, "Format not supported!");
+        mInternalFormat = internalFormat;
+        mDataFormat = dataFormat;
 
-            glCreateTextures(GL_TEXTURE_2D, 1, &mRendererID);
-            glTextureStorage2D(mRendererID, 1, internalFormat, mWidth, mHeight);
+        RF_CORE_ASSERT(internalFormat & dataFormat, "Format not supported!");
 
-            glTextureParameteri(mRendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTextureParameteri(mRendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        // unbaked images still get a full mip chain, built by the driver
+        u32 mip_count = CalculateMipCount(mWidth, mHeight);
 
-            glTextureParameteri(mRendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-            glTextureParameteri(mRendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glCreateTextures(GL_TEXTURE_2D, 1, &mRendererID);
+        glTextureStorage2D(mRendererID, mip_count, internalFormat, mWidth, mHeight);
 
-            glTextureSubImage2D(mRendererID, 0, 0, 0, mWidth, mHeight, dataFormat, GL_UNSIGNED_BYTE, data);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTextureSubImage2D(mRendererID, 0, 0, 0, mWidth, mHeight, dataFormat, GL_UNSIGNED_BYTE, data.Pixels.data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glGenerateTextureMipmap(mRendererID);
 
-            stbi_image_free(data);
-        }
-        else
-        {
-            RF_CORE_ERROR("Failed to load texture: {}", path);
-            stbi_image_free(data);
-        }
+        // a full mip chain adds roughly a third on top of the base level
+        mMemoryUsage = static_cast<usize>(mWidth) * mHeight * data.Channels * 4 / 3;
+        MemoryTracker::OnGpuAllocate(MemoryTag::Textures, mMemoryUsage);
+
+        SetupSampler(mip_count);
+    }
+
+    void Texture2D::SetupSampler(u32 mip_count)
+    {
+        glTextureParameteri(mRendererID, GL_TEXTURE_MIN_FILTER, mip_count > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTextureParameteri(mRendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        glTextureParameteri(mRendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTextureParameteri(mRendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
     }
 
     Texture2D::~Texture2D()
     {
+        MemoryTracker::OnGpuFree(MemoryTag::Textures, mMemoryUsage);
         glDeleteTextures(1, &mRendererID);
     }
 
@@ -103,4 +212,45 @@ namespace RealmFortress
     {
         return CreateRef<Texture2D>(path);
     }
+
+    Ref<Texture2D> Texture2D::Create(const TextureData& data)
+    {
+        return CreateRef<Texture2D>(data);
+    }
+
+    TextureData Texture2D::Decode(const std::string& path)
+    {
+        RF_MEMORY_TAG(MemoryTag::Textures);
+
+        TextureData result;
+        result.Path = path;
+
+        // prefer the baked block-compressed version sitting next to the source image
+        std::string baked_path = std::filesystem::path(path).replace_extension(".ktx2").generic_string();
+        if (FileSystem::Exists(baked_path))
+        {
+            if (ParseKTX2(FileSystem::Read(baked_path), result))
+                return result;
+
+            RF_CORE_WARN("Ignoring invalid baked texture: {}", baked_path);
+        }
+
+        FileData file = FileSystem::Read(path);
+        if (!file)
+            return result;
+
+        // the vertical flip flag is global in stb and left at its default (off), so decoding can run on any thread
+        i32 width, height, channels;
+        stbi_uc* pixels = stbi_load_from_memory(file.Data(), static_cast<i32>(file.Size()), &width, &height, &channels, 0);
+        if (!pixels)
+            return result;
+
+        result.Width = width;
+        result.Height = height;
+        result.Channels = channels;
+        result.Pixels.assign(pixels, pixels + static_cast<usize>(width) * height * channels);
+
+        stbi_image_free(pixels);
+        return result;
+    }
 } // namespace RealmFortress
@@ -7,11 +7,44 @@
 #pragma once
 
 #include "core/base.h"
+#include "core/file_system.h"
+#include "core/memory_tracker.h"
 #include <string>
+#include <vector>
 #include <glad/gl.h>
 
 namespace RealmFortress
 {
+    struct TextureMip
+    {
+        u32 Width = 0;
+        u32 Height = 0;
+        const u8* Data = nullptr;
+        usize Size = 0;
+    };
+
+    /**
+     * @brief Texture contents ready for upload, produced off the render thread.
+     *
+     * Either decoded pixels from an image file, or the block-compressed mip chain of a baked
+     * .ktx2, which points straight into Source and is uploaded without decoding.
+     */
+    struct TextureData
+    {
+        std::string Path;
+        u32 Width = 0;
+        u32 Height = 0;
+        u32 Channels = 0;
+        std::vector<u8> Pixels;
+
+        u32 CompressedFormat = 0;
+        std::vector<TextureMip> Mips;
+        FileData Source;
+
+        bool IsValid() const { return !Pixels.empty() || !Mips.empty(); }
+        bool IsCompressed() const { return CompressedFormat != 0; }
+    };
+
     class Texture
     {
     public:
@@ -33,11 +66,13 @@ namespace RealmFortress
     public:
         Texture2D(u32 width, u32 height);
         Texture2D(const std::string& path);
+        Texture2D(const TextureData& data);
         ~Texture2D() override;
 
         u32 GetWidth() const override { return mWidth; }
         u32 GetHeight() const override { return mHeight; }
         u32 GetRendererID() const override { return mRendererID; }
+        usize GetMemoryUsage() const { return mMemoryUsage; }
 
         void SetData(void* data, u32 size) override;
 
@@ -50,11 +85,19 @@ namespace RealmFortress
 
         static Ref<Texture2D> Create(u32 width, u32 height);
         static Ref<Texture2D> Create(const std::string& path);
+        static Ref<Texture2D> Create(const TextureData& data);
+
+        // CPU-only, safe to call from worker threads
+        static TextureData Decode(const std::string& path);
+
+    private:
+        void SetupSampler(u32 mip_count);
 
     private:
         std::string mPath;
         u32 mWidth, mHeight;
-        u32 mRendererID;
+        u32 mRendererID = 0;
         GLenum mInternalFormat, mDataFormat;
+        usize mMemoryUsage = 0;
     };
 } // namespace RealmFortress
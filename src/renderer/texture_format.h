@@ -0,0 +1,60 @@
+/**
+ * @file texture_format.h
+ * @brief Baked texture container shared by the runtime and the texture baker.
+ * @date 12/22/2025
+ */
+
+#pragma once
+
+#include "core/base.h"
+
+namespace RealmFortress
+{
+    /**
+     * Baked textures use the KTX2 header and level index without a data format descriptor or
+     * supercompression. Levels are listed largest first in the index and stored smallest first
+     * in the file, each on a 16-byte boundary.
+     */
+    constexpr u8 KTX2_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+    constexpr u32 KTX2_LEVEL_ALIGNMENT = 16;
+
+    constexpr u32 VK_FORMAT_BC1_RGB_UNORM_BLOCK = 131;
+    constexpr u32 VK_FORMAT_BC3_UNORM_BLOCK = 137;
+    constexpr u32 VK_FORMAT_BC7_UNORM_BLOCK = 145;
+
+    struct KTX2Header
+    {
+        u8 Identifier[12];
+        u32 VkFormat = 0;
+        u32 TypeSize = 1;
+        u32 PixelWidth = 0;
+        u32 PixelHeight = 0;
+        u32 PixelDepth = 0;
+        u32 LayerCount = 0;
+        u32 FaceCount = 1;
+        u32 LevelCount = 0;
+        u32 SupercompressionScheme = 0;
+
+        u32 DfdByteOffset = 0;
+        u32 DfdByteLength = 0;
+        u32 KvdByteOffset = 0;
+        u32 KvdByteLength = 0;
+        u64 SgdByteOffset = 0;
+        u64 SgdByteLength = 0;
+    };
+
+    struct KTX2LevelIndex
+    {
+        u64 ByteOffset = 0;
+        u64 ByteLength = 0;
+        u64 UncompressedByteLength = 0;
+    };
+
+    static_assert(sizeof(KTX2Header) == 80);
+    static_assert(sizeof(KTX2LevelIndex) == 24);
+
+    inline u32 BlockCompressedBytesPerBlock(u32 vk_format)
+    {
+        return vk_format == VK_FORMAT_BC1_RGB_UNORM_BLOCK ? 8 : 16;
+    }
+} // namespace RealmFortress
@@ -25,6 +25,9 @@ namespace RealmFortress
             case ShaderDataType::Int3:
             case ShaderDataType::Int4:   return GL_INT;
             case ShaderDataType::Bool:   return GL_BOOL;
+            case ShaderDataType::Short4: return GL_SHORT;
+            case ShaderDataType::Half2:  return GL_HALF_FLOAT;
+            case ShaderDataType::Int2_10_10_10: return GL_INT_2_10_10_10_REV;
             default: break;
         }
         RF_CORE_ASSERT(false, "Unknown ShaderDataType!");
@@ -0,0 +1,180 @@
+/**
+ * @file asset_packer.cpp
+ * @brief Packs a directory tree into a single indexed asset archive.
+ * @date 12/20/2025
+ *
+ * Usage: realm-fortress-packer <input-dir> <output-file> [--lz4] [--align N]
+ *
+ * Entry paths are stored relative to the parent of <input-dir>, so packing "assets"
+ * produces entries like "assets/shaders/basic.glsl" that match the paths the game asks for.
+ */
+
+#include "core/archive_format.h"
+#include <lz4hc.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace RealmFortress;
+
+namespace
+{
+    struct PackedFile
+    {
+        std::string Path;
+        std::vector<u8> Data;
+        ArchiveEntry Entry;
+    };
+
+    bool ReadFile(const std::filesystem::path& path, std::vector<u8>& out)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+            return false;
+
+        out.resize(static_cast<usize>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(out.size()));
+        return true;
+    }
+
+    u64 AlignUp(u64 value, u64 alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    void Compress(PackedFile& file)
+    {
+        if (file.Data.empty())
+            return;
+
+        std::vector<u8> compressed(LZ4_compressBound(static_cast<i32>(file.Data.size())));
+        i32 size = LZ4_compress_HC(reinterpret_cast<const char*>(file.Data.data()), reinterpret_cast<char*>(compressed.data()),
+            static_cast<i32>(file.Data.size()), static_cast<i32>(compressed.size()), LZ4HC_CLEVEL_MAX);
+
+        // only keep the compressed form when it is worth the decode cost at load time
+        if (size > 0 && static_cast<usize>(size) < file.Data.size() - file.Data.size() / 8)
+        {
+            compressed.resize(size);
+            file.Data = std::move(compressed);
+            file.Entry.Flags |= ArchiveEntryFlags_LZ4;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::fprintf(stderr, "usage: %s <input-dir> <output-file> [--lz4] [--align N]\n", argv[0]);
+        return 1;
+    }
+
+    std::filesystem::path input = std::filesystem::absolute(argv[1]).lexically_normal();
+    if (!input.has_filename())
+        input = input.parent_path();
+    std::filesystem::path output = argv[2];
+
+    bool compress = false;
+    u32 alignment = ARCHIVE_DEFAULT_ALIGNMENT;
+    for (i32 i = 3; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--lz4") == 0)
+            compress = true;
+        else if (std::strcmp(argv[i], "--align") == 0 && i + 1 < argc)
+            alignment = static_cast<u32>(std::stoul(argv[++i]));
+    }
+
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+    {
+        std::fprintf(stderr, "alignment must be a power of two\n");
+        return 1;
+    }
+
+    if (!std::filesystem::is_directory(input))
+    {
+        std::fprintf(stderr, "input is not a directory: %s\n", input.string().c_str());
+        return 1;
+    }
+
+    std::vector<PackedFile> files;
+    for (const auto& item : std::filesystem::recursive_directory_iterator(input))
+    {
+        if (!item.is_regular_file())
+            continue;
+
+        PackedFile file;
+        file.Path = std::filesystem::relative(item.path(), input.parent_path()).generic_string();
+        if (!ReadFile(item.path(), file.Data))
+        {
+            std::fprintf(stderr, "failed to read %s\n", item.path().string().c_str());
+            return 1;
+        }
+
+        file.Entry.Size = file.Data.size();
+        if (compress)
+            Compress(file);
+        file.Entry.StoredSize = file.Data.size();
+
+        files.push_back(std::move(file));
+    }
+
+    // the runtime binary-searches the table of contents by path
+    std::sort(files.begin(), files.end(), [](const PackedFile& a, const PackedFile& b) {
+        return a.Path < b.Path;
+    });
+
+    ArchiveHeader header;
+    header.EntryCount = static_cast<u32>(files.size());
+    header.Alignment = alignment;
+    header.StringTableOffset = sizeof(ArchiveHeader) + sizeof(ArchiveEntry) * files.size();
+
+    std::string strings;
+    for (auto& file : files)
+    {
+        file.Entry.PathOffset = static_cast<u32>(strings.size());
+        file.Entry.PathLength = static_cast<u32>(file.Path.size());
+        strings += file.Path;
+    }
+    header.StringTableSize = strings.size();
+
+    u64 offset = AlignUp(header.StringTableOffset + header.StringTableSize, alignment);
+    for (auto& file : files)
+    {
+        file.Entry.Offset = offset;
+        offset = AlignUp(offset + file.Entry.StoredSize, alignment);
+    }
+
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        std::fprintf(stderr, "failed to open %s\n", output.string().c_str());
+        return 1;
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const auto& file : files)
+        out.write(reinterpret_cast<const char*>(&file.Entry), sizeof(ArchiveEntry));
+    out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+
+    u64 raw_size = 0;
+    u64 stored_size = 0;
+    for (const auto& file : files)
+    {
+        u64 position = static_cast<u64>(out.tellp());
+        std::vector<char> padding(file.Entry.Offset - position, 0);
+        out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+        out.write(reinterpret_cast<const char*>(file.Data.data()), static_cast<std::streamsize>(file.Data.size()));
+
+        raw_size += file.Entry.Size;
+        stored_size += file.Entry.StoredSize;
+    }
+
+    std::printf("packed %zu files into %s (%.1f MB -> %.1f MB)\n", files.size(), output.string().c_str(),
+        raw_size / (1024.0 * 1024.0), stored_size / (1024.0 * 1024.0));
+    return 0;
+}
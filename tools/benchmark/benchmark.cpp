@@ -0,0 +1,308 @@
+/**
+ * @file benchmark.cpp
+ * @brief Runs the engine micro-benchmarks and optionally writes the results as JSON.
+ * @date 12/22/2025
+ *
+ * Usage: realm-fortress-bench [--filter <text>] [--min-time <seconds>] [--repetitions N]
+ *                             [--json <file>] [--list]
+ *
+ * The JSON follows Google Benchmark's --benchmark_format=json layout (times in ns), so two
+ * runs can be compared with its tools/compare.py. Build with optimizations; numbers from a
+ * Debug build say little about the shipped game.
+ */
+
+#include "core/pch.h"
+#include "benchmark.h"
+#include "core/frame_allocator.h"
+#include "core/json.h"
+#include "core/logger.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+using namespace RealmFortress;
+
+namespace
+{
+    struct Options
+    {
+        std::string Filter;
+        std::string JsonPath;
+        f64 MinTime{ 0.5 };
+        u32 Repetitions{ 1 };
+        bool List{ false };
+    };
+
+    struct Result
+    {
+        std::string Name;
+        std::string RunName;
+        std::string Aggregate;
+        u32 RepetitionIndex{ 0 };
+        u64 Iterations{ 0 };
+        f64 RealTime{ 0.0 }; // ns per iteration
+        f64 CpuTime{ 0.0 };
+        f64 ItemsPerSecond{ 0.0 };
+        std::string Error;  // set when the benchmark skipped itself
+    };
+
+    // grows the batch until it runs for at least min_time, like Google Benchmark
+    Result Run(const Benchmark::Definition& definition, f64 min_time)
+    {
+        constexpr u64 MaxIterations = 1'000'000'000;
+
+        u64 iterations = 1;
+        while (true)
+        {
+            // frame-allocated results from the previous batch are dead by now
+            FrameAllocator::Reset();
+
+            Benchmark::State state(iterations, definition.Argument);
+            definition.Run(state);
+
+            if (state.IsSkipped())
+            {
+                Result result;
+                result.Name = definition.Name;
+                result.RunName = definition.Name;
+                result.Error = state.GetError();
+                return result;
+            }
+
+            f64 seconds = state.GetRealSeconds();
+            if (seconds >= min_time || iterations >= MaxIterations)
+            {
+                Result result;
+                result.Name = definition.Name;
+                result.RunName = definition.Name;
+                result.Iterations = iterations;
+                result.RealTime = seconds * 1e9 / static_cast<f64>(iterations);
+                result.CpuTime = state.GetCpuSeconds() * 1e9 / static_cast<f64>(iterations);
+                if (state.GetItemsProcessed() > 0 && seconds > 0.0)
+                    result.ItemsPerSecond = static_cast<f64>(state.GetItemsProcessed()) / seconds;
+                return result;
+            }
+
+            // aim 40% past the target so the next batch is usually the last, growing at most 10x
+            f64 multiplier = seconds > 0.0 ? min_time * 1.4 / seconds : 10.0;
+            multiplier = std::clamp(multiplier, 2.0, 10.0);
+            iterations = std::min(MaxIterations, static_cast<u64>(static_cast<f64>(iterations) * multiplier));
+        }
+    }
+
+    std::vector<Result> Aggregate(const std::vector<Result>& runs)
+    {
+        auto make = [&](const char* name, auto&& pick)
+        {
+            std::vector<f64> real;
+            std::vector<f64> cpu;
+            std::vector<f64> items;
+            for (const Result& run : runs)
+            {
+                real.push_back(run.RealTime);
+                cpu.push_back(run.CpuTime);
+                items.push_back(run.ItemsPerSecond);
+            }
+
+            Result result;
+            result.Name = runs.front().Name + "_" + name;
+            result.RunName = runs.front().Name;
+            result.Aggregate = name;
+            result.Iterations = runs.size();
+            result.RealTime = pick(real);
+            result.CpuTime = pick(cpu);
+            result.ItemsPerSecond = pick(items);
+            return result;
+        };
+
+        auto mean = [](std::vector<f64>& values)
+        {
+            f64 sum = 0.0;
+            for (f64 value : values)
+                sum += value;
+            return sum / static_cast<f64>(values.size());
+        };
+
+        auto median = [](std::vector<f64>& values)
+        {
+            std::ranges::sort(values);
+            usize middle = values.size() / 2;
+            return values.size() % 2 == 0 ? (values[middle - 1] + values[middle]) / 2.0 : values[middle];
+        };
+
+        auto stddev = [&](std::vector<f64>& values)
+        {
+            f64 average = mean(values);
+            f64 sum = 0.0;
+            for (f64 value : values)
+                sum += (value - average) * (value - average);
+            return std::sqrt(sum / static_cast<f64>(values.size() - 1));
+        };
+
+        return { make("mean", mean), make("median", median), make("stddev", stddev) };
+    }
+
+    std::string FormatTime(f64 ns)
+    {
+        char buffer[32];
+        if (ns < 1e3)
+            std::snprintf(buffer, sizeof(buffer), "%.2f ns", ns);
+        else if (ns < 1e6)
+            std::snprintf(buffer, sizeof(buffer), "%.2f us", ns / 1e3);
+        else
+            std::snprintf(buffer, sizeof(buffer), "%.2f ms", ns / 1e6);
+        return buffer;
+    }
+
+    void PrintResult(const Result& result)
+    {
+        if (!result.Error.empty())
+        {
+            std::printf("%-44s ERROR OCCURRED: '%s'\n", result.Name.c_str(), result.Error.c_str());
+            return;
+        }
+
+        std::printf("%-44s %14s %14s %12llu", result.Name.c_str(), FormatTime(result.RealTime).c_str(),
+                    FormatTime(result.CpuTime).c_str(), static_cast<unsigned long long>(result.Iterations));
+        if (result.ItemsPerSecond > 0.0)
+            std::printf("  %.3fM items/s", result.ItemsPerSecond / 1e6);
+        std::printf("\n");
+    }
+
+    bool WriteJson(const std::string& path, const char* executable, const std::vector<Result>& results, u32 repetitions)
+    {
+        std::ofstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+
+        char date[64];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+#ifdef RF_DEBUG
+        const char* build_type = "debug";
+#else
+        const char* build_type = "release";
+#endif
+
+        std::string json = std::format("{{\n  \"context\": {{\n    \"date\": \"{}\",\n    \"executable\": \"{}\",\n"
+                                       "    \"num_cpus\": {},\n    \"library_build_type\": \"{}\"\n  }},\n  \"benchmarks\": [",
+                                       date, EscapeJson(executable), std::thread::hardware_concurrency(), build_type);
+
+        for (usize i = 0; i < results.size(); i++)
+        {
+            const Result& result = results[i];
+            json += i == 0 ? "\n" : ",\n";
+            json += std::format("    {{\n      \"name\": \"{}\",\n      \"run_name\": \"{}\",\n      \"run_type\": \"{}\",\n"
+                                "      \"repetitions\": {},\n      \"repetition_index\": {},\n      \"threads\": 1,\n",
+                                result.Name, result.RunName, result.Aggregate.empty() ? "iteration" : "aggregate",
+                                repetitions, result.RepetitionIndex);
+            if (!result.Aggregate.empty())
+                json += std::format("      \"aggregate_name\": \"{}\",\n", result.Aggregate);
+            if (!result.Error.empty())
+                json += std::format("      \"error_occurred\": true,\n      \"error_message\": \"{}\",\n", EscapeJson(result.Error));
+            json += std::format("      \"iterations\": {},\n      \"real_time\": {:.4f},\n      \"cpu_time\": {:.4f},\n      \"time_unit\": \"ns\"",
+                                result.Iterations, result.RealTime, result.CpuTime);
+            if (result.ItemsPerSecond > 0.0)
+                json += std::format(",\n      \"items_per_second\": {:.4f}", result.ItemsPerSecond);
+            json += "\n    }";
+        }
+
+        json += "\n  ]\n}\n";
+        file.write(json.data(), static_cast<std::streamsize>(json.size()));
+        return true;
+    }
+}
+
+namespace RealmFortress::Benchmark
+{
+    std::vector<Definition>& GetRegistry()
+    {
+        static std::vector<Definition> registry;
+        return registry;
+    }
+} // namespace RealmFortress::Benchmark
+
+int main(int argc, char** argv)
+{
+    Options options;
+    for (i32 i = 1; i < argc; i++)
+    {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--filter") == 0 && has_value)
+            options.Filter = argv[++i];
+        else if (std::strcmp(argv[i], "--json") == 0 && has_value)
+            options.JsonPath = argv[++i];
+        else if (std::strcmp(argv[i], "--min-time") == 0 && has_value)
+            options.MinTime = std::max(std::atof(argv[++i]), 0.001);
+        else if (std::strcmp(argv[i], "--repetitions") == 0 && has_value)
+            options.Repetitions = static_cast<u32>(std::max(std::atoi(argv[++i]), 1));
+        else if (std::strcmp(argv[i], "--list") == 0)
+            options.List = true;
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--filter <text>] [--min-time <seconds>] [--repetitions N] [--json <file>] [--list]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    Logger::Init();
+    FrameAllocator::Init();
+
+    std::vector<Result> results;
+    if (!options.List)
+        std::printf("%-44s %14s %14s %12s\n%s\n", "Benchmark", "Time", "CPU", "Iterations", std::string(86, '-').c_str());
+
+    for (const Benchmark::Definition& definition : Benchmark::GetRegistry())
+    {
+        if (!options.Filter.empty() && definition.Name.find(options.Filter) == std::string::npos)
+            continue;
+
+        if (options.List)
+        {
+            std::printf("%s\n", definition.Name.c_str());
+            continue;
+        }
+
+        std::vector<Result> runs;
+        for (u32 repetition = 0; repetition < options.Repetitions; repetition++)
+        {
+            Result result = Run(definition, options.MinTime);
+            result.RepetitionIndex = repetition;
+            PrintResult(result);
+            runs.push_back(result);
+
+            // a skipped benchmark skips every repetition the same way
+            if (!result.Error.empty())
+                break;
+        }
+
+        results.insert(results.end(), runs.begin(), runs.end());
+        if (runs.size() > 1)
+        {
+            for (const Result& aggregate : Aggregate(runs))
+            {
+                PrintResult(aggregate);
+                results.push_back(aggregate);
+            }
+        }
+    }
+
+    i32 exit_code = 0;
+    if (!options.JsonPath.empty() && !options.List)
+    {
+        if (WriteJson(options.JsonPath, argv[0], results, options.Repetitions))
+        {
+            std::printf("Results written to %s\n", options.JsonPath.c_str());
+        }
+        else
+        {
+            std::fprintf(stderr, "Could not write %s\n", options.JsonPath.c_str());
+            exit_code = 1;
+        }
+    }
+
+    FrameAllocator::Shutdown();
+    Logger::Shutdown();
+    return exit_code;
+}
@@ -0,0 +1,186 @@
+/**
+ * @file benchmark.h
+ * @brief Minimal micro-benchmark harness behind realm-fortress-bench.
+ * @date 12/22/2025
+ *
+ * Mirrors the small part of Google Benchmark the engine benchmarks need, so they can move
+ * over unchanged if it is ever vendored:
+ *
+ *     static void BM_Something(Benchmark::State& state)
+ *     {
+ *         for (auto _ : state)
+ *             Benchmark::DoNotOptimize(Something(state.Range()));
+ *     }
+ *     RF_BENCHMARK(BM_Something, 8, 64);
+ *
+ * Each argument registers a separate run named "BM_Something/8". The loop body is repeated
+ * until it has run for the minimum time, and the per-iteration time of the final batch is
+ * reported.
+ */
+
+#pragma once
+
+#include "core/base.h"
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace RealmFortress::Benchmark
+{
+    class State
+    {
+    public:
+        State(u64 iterations, i64 argument)
+            : mIterations(iterations), mArgument(argument)
+        {
+        }
+
+        // the loop variable exists only to drive the range-for; its destructor keeps
+        // compilers from warning that it is unused
+        struct Value
+        {
+            ~Value() {}
+        };
+
+        class Iterator
+        {
+        public:
+            Iterator(State* state, u64 remaining)
+                : mState(state), mRemaining(remaining)
+            {
+            }
+
+            Value operator*() const { return {}; }
+            Iterator& operator++()
+            {
+                --mRemaining;
+                return *this;
+            }
+
+            bool operator!=(const Iterator&)
+            {
+                if (mRemaining != 0)
+                    return true;
+
+                mState->StopTiming();
+                return false;
+            }
+
+        private:
+            State* mState;
+            u64 mRemaining;
+        };
+
+        Iterator begin()
+        {
+            StartTiming();
+            return { this, mIterations };
+        }
+
+        Iterator end() { return { this, 0 }; }
+
+        i64 Range() const { return mArgument; }
+        u64 Iterations() const { return mIterations; }
+
+        // setup that has to happen inside the loop goes between these
+        void PauseTiming() { StopTiming(); }
+        void ResumeTiming() { StartTiming(); }
+
+        // reported as items_per_second
+        void SetItemsProcessed(u64 items) { mItemsProcessed = items; }
+        u64 GetItemsProcessed() const { return mItemsProcessed; }
+
+        // call before the loop and return without running it; the run is reported as an error
+        void SkipWithError(std::string message) { mError = std::move(message); }
+        bool IsSkipped() const { return !mError.empty(); }
+        const std::string& GetError() const { return mError; }
+
+        f64 GetRealSeconds() const { return mRealSeconds; }
+        f64 GetCpuSeconds() const { return mCpuSeconds; }
+
+    private:
+        void StartTiming()
+        {
+            mCpuStart = std::clock();
+            mRealStart = std::chrono::steady_clock::now();
+        }
+
+        void StopTiming()
+        {
+            auto real_end = std::chrono::steady_clock::now();
+            std::clock_t cpu_end = std::clock();
+
+            mRealSeconds += std::chrono::duration<f64>(real_end - mRealStart).count();
+            mCpuSeconds += static_cast<f64>(cpu_end - mCpuStart) / CLOCKS_PER_SEC;
+        }
+
+    private:
+        u64 mIterations;
+        i64 mArgument;
+        u64 mItemsProcessed{ 0 };
+        std::string mError;
+
+        std::chrono::steady_clock::time_point mRealStart;
+        std::clock_t mCpuStart{ 0 };
+        f64 mRealSeconds{ 0.0 };
+        f64 mCpuSeconds{ 0.0 };
+    };
+
+    using Function = void (*)(State&);
+
+    struct Definition
+    {
+        std::string Name;
+        Function Run;
+        i64 Argument;
+    };
+
+    std::vector<Definition>& GetRegistry();
+
+    // one run per argument, or a single run with Range() == 0 when there are none
+    inline int Register(const char* name, Function function, std::initializer_list<i64> arguments = {})
+    {
+        if (arguments.size() == 0)
+        {
+            GetRegistry().push_back({ name, function, 0 });
+            return 0;
+        }
+
+        for (i64 argument : arguments)
+        {
+            GetRegistry().push_back({ std::string(name) + "/" + std::to_string(argument), function, argument });
+        }
+        return 0;
+    }
+
+    // keeps the optimizer from dropping a result nobody reads
+    template<typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+#if defined(_MSC_VER)
+        static const volatile void* sSink;
+        sSink = &value;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#else
+        asm volatile("" : : "r,m"(value) : "memory");
+#endif
+    }
+
+    // forces pending writes to memory, for loops whose only effect is a store
+    inline void ClobberMemory()
+    {
+#if defined(_MSC_VER)
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#else
+        asm volatile("" : : : "memory");
+#endif
+    }
+} // namespace RealmFortress::Benchmark
+
+#define RF_BENCHMARK_CONCAT_INNER(a, b) a##b
+#define RF_BENCHMARK_CONCAT(a, b) RF_BENCHMARK_CONCAT_INNER(a, b)
+#define RF_BENCHMARK(function, ...) \
+    static const int RF_BENCHMARK_CONCAT(rf_benchmark_, __LINE__) = ::RealmFortress::Benchmark::Register(#function, function, { __VA_ARGS__ })
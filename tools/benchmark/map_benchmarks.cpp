@@ -0,0 +1,192 @@
+/**
+ * @file map_benchmarks.cpp
+ * @brief Terrain generation, map queries, hex coordinates and draw batch building.
+ * @date 12/22/2025
+ */
+
+#include "core/pch.h"
+#include "benchmark.h"
+#include "core/frame_allocator.h"
+#include "game/map/map.h"
+#include "game/map/perlin_noise.h"
+#include <random>
+
+using namespace RealmFortress;
+
+namespace
+{
+    constexpr u32 Seed = 1337;
+    constexpr usize SampleCount = 4096;
+
+    // the map as the game sees it at startup: every chunk in render distance of the origin
+    Map& GetLoadedMap()
+    {
+        static Map map;
+        static bool loaded = []
+        {
+            map.Regenerate(Seed);
+            do
+            {
+                map.OnUpdate(glm::vec3(0.0f));
+            }
+            while (map.GetPendingChunkCount() > 0);
+            return true;
+        }();
+
+        (void)loaded;
+        return map;
+    }
+
+    // well inside the loaded chunks, so lookups hit
+    std::vector<Coordinate> RandomCoordinates(i32 extent)
+    {
+        std::mt19937 generator(Seed);
+        std::uniform_int_distribution<i32> distribution(-extent, extent);
+
+        std::vector<Coordinate> coords(SampleCount);
+        for (Coordinate& coord : coords)
+        {
+            coord = Coordinate(distribution(generator), distribution(generator));
+        }
+        return coords;
+    }
+
+    void BM_PerlinOctaveNoise(Benchmark::State& state)
+    {
+        PerlinNoise noise(Seed);
+        i32 octaves = static_cast<i32>(state.Range());
+
+        f32 x = 0.0f;
+        for (auto _ : state)
+        {
+            Benchmark::DoNotOptimize(noise.OctaveNoise(x, x * 0.5f, octaves));
+            x += 0.013f;
+        }
+        state.SetItemsProcessed(state.Iterations());
+    }
+    RF_BENCHMARK(BM_PerlinOctaveNoise, 1, 4, 8);
+
+    void BM_ChunkGenerate(Benchmark::State& state)
+    {
+        i32 index = 0;
+        for (auto _ : state)
+        {
+            Chunk chunk({ index % 16, index / 16 % 16 });
+            chunk.Generate(Seed);
+            Benchmark::DoNotOptimize(chunk.GetTiles().size());
+            index++;
+        }
+        state.SetItemsProcessed(state.Iterations() * CHUNK_SIZE * CHUNK_SIZE);
+    }
+    RF_BENCHMARK(BM_ChunkGenerate);
+
+    void BM_MapGetTile(Benchmark::State& state)
+    {
+        const Map& map = GetLoadedMap();
+        std::vector<Coordinate> coords = RandomCoordinates(64);
+
+        usize i = 0;
+        for (auto _ : state)
+        {
+            Benchmark::DoNotOptimize(map.GetTile(coords[i++ % SampleCount]));
+        }
+        state.SetItemsProcessed(state.Iterations());
+    }
+    RF_BENCHMARK(BM_MapGetTile);
+
+    void BM_MapGetNeighbors(Benchmark::State& state)
+    {
+        const Map& map = GetLoadedMap();
+        std::vector<Coordinate> coords = RandomCoordinates(64);
+
+        usize i = 0;
+        for (auto _ : state)
+        {
+            // the game resets the arena once a frame; this does it about as often
+            if (i % SampleCount == 0)
+                FrameAllocator::Reset();
+
+            auto neighbors = map.GetNeighbors(coords[i++ % SampleCount]);
+            Benchmark::DoNotOptimize(neighbors.data());
+        }
+        state.SetItemsProcessed(state.Iterations());
+    }
+    RF_BENCHMARK(BM_MapGetNeighbors);
+
+    void BM_MapGetTilesInRadius(Benchmark::State& state)
+    {
+        const Map& map = GetLoadedMap();
+        std::vector<Coordinate> coords = RandomCoordinates(48);
+        i32 radius = static_cast<i32>(state.Range());
+
+        usize i = 0;
+        u64 tiles = 0;
+        for (auto _ : state)
+        {
+            if (i % 256 == 0)
+                FrameAllocator::Reset();
+
+            auto result = map.GetTilesInRadius(coords[i++ % SampleCount], radius);
+            tiles += result.size();
+            Benchmark::DoNotOptimize(result.data());
+        }
+        state.SetItemsProcessed(tiles);
+    }
+    RF_BENCHMARK(BM_MapGetTilesInRadius, 2, 5, 10);
+
+    void BM_CoordinateFromWorldPosition(Benchmark::State& state)
+    {
+        std::mt19937 generator(Seed);
+        std::uniform_real_distribution<f32> distribution(-200.0f, 200.0f);
+
+        std::vector<glm::vec3> positions(SampleCount);
+        for (glm::vec3& position : positions)
+        {
+            position = glm::vec3(distribution(generator), 0.0f, distribution(generator));
+        }
+
+        usize i = 0;
+        for (auto _ : state)
+        {
+            Benchmark::DoNotOptimize(Coordinate::FromWorldPosition(positions[i++ % SampleCount]));
+        }
+        state.SetItemsProcessed(state.Iterations());
+    }
+    RF_BENCHMARK(BM_CoordinateFromWorldPosition);
+
+    void BM_CoordinateDistanceTo(Benchmark::State& state)
+    {
+        std::vector<Coordinate> coords = RandomCoordinates(256);
+
+        usize i = 0;
+        for (auto _ : state)
+        {
+            Benchmark::DoNotOptimize(coords[i % SampleCount].DistanceTo(coords[(i + 1) % SampleCount]));
+            i++;
+        }
+        state.SetItemsProcessed(state.Iterations());
+    }
+    RF_BENCHMARK(BM_CoordinateDistanceTo);
+
+    // Map::Draw without its GL half: gathering and grouping the instance transforms
+    void BM_MapBuildDrawBatches(Benchmark::State& state)
+    {
+        const Map& map = GetLoadedMap();
+
+        u64 instances = 0;
+        for (auto _ : state)
+        {
+            {
+                Map::DrawBatches batches(FrameAllocator::GetResource());
+                map.BuildDrawBatches(batches);
+
+                for (const auto& transforms : batches | std::views::values)
+                    instances += transforms.size();
+                Benchmark::DoNotOptimize(batches.size());
+            }
+            FrameAllocator::Reset();
+        }
+        state.SetItemsProcessed(instances);
+    }
+    RF_BENCHMARK(BM_MapBuildDrawBatches);
+}
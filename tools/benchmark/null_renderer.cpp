@@ -0,0 +1,37 @@
+/**
+ * @file null_renderer.cpp
+ * @brief Stands in for the renderer symbols the game logic library calls, so the benchmarks
+ *        and the headless simulation run without a window or GL context.
+ * @date 12/22/2025
+ *
+ * Model paths resolve to stable handles the way a warm cache would answer, but nothing is
+ * read, decoded or uploaded, and Get() never returns a model, so nothing is ever drawn.
+ */
+
+#include "core/pch.h"
+#include "renderer/model_cache.h"
+#include "renderer/shader.h"
+#include <mutex>
+
+namespace RealmFortress
+{
+    ModelHandle ModelCache::Load(const std::string& path, VertexFormat format)
+    {
+        static std::mutex mutex;
+        static std::unordered_map<std::string, ModelHandle> handles;
+
+        std::lock_guard lock(mutex);
+        auto [it, inserted] = handles.try_emplace(path, static_cast<ModelHandle>(handles.size() + 1));
+        return it->second;
+    }
+
+    Model* ModelCache::Get(ModelHandle handle) { return nullptr; }
+    void ModelCache::Acquire(ModelHandle handle) {}
+    void ModelCache::Release(ModelHandle handle) {}
+
+    void Model::DrawInstanced(const Ref<Shader>& shader, std::span<const glm::mat4> transforms) {}
+
+    void Shader::Bind() const {}
+    void Shader::SetFloat(std::string_view name, f32 value) const {}
+    void Shader::SetFloat3(std::string_view name, const glm::vec3& value) const {}
+} // namespace RealmFortress
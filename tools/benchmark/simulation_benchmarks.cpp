@@ -0,0 +1,263 @@
+/**
+ * @file simulation_benchmarks.cpp
+ * @brief Warehouse bookkeeping and building placement and queries.
+ * @date 12/22/2025
+ */
+
+#include "core/pch.h"
+#include "benchmark.h"
+#include "core/frame_allocator.h"
+#include "game/building/building_manager.h"
+#include "game/map/map.h"
+#include "game/resource/warehouse.h"
+#include "game/system/resource_telemetry.h"
+#include "game/system/scheduler.h"
+#include <random>
+
+using namespace RealmFortress;
+
+namespace
+{
+    constexpr u32 Seed = 1337;
+    constexpr usize SampleCount = 4096;
+
+    // a town hall near the origin and a spread of mines around it, on a fully loaded map
+    struct Settlement
+    {
+        Map World;
+        std::vector<Coordinate> Candidates;  // random coordinates, valid or not
+        std::vector<Coordinate> FreeSites;   // where a mine can go right now
+        Warehouse::State FullWarehouse;
+    };
+
+    // runs the scheduler until everything of type placed so far has been built
+    void FinishConstruction(BuildingType type)
+    {
+        Scheduler& scheduler = Scheduler::Get();
+        scheduler.AdvanceTo(scheduler.GetTime() + GetBuildingDefinition(type).ConstructionTime);
+    }
+
+    Settlement& GetSettlement()
+    {
+        static Settlement settlement;
+        static bool built = []
+        {
+            Map& map = settlement.World;
+            map.Regenerate(Seed);
+            do
+            {
+                map.OnUpdate(glm::vec3(0.0f));
+            }
+            while (map.GetPendingChunkCount() > 0);
+
+            BuildingManager& buildings = BuildingManager::Get();
+            Warehouse& warehouse = Warehouse::Get();
+            buildings.Clear();
+
+            std::mt19937 generator(Seed);
+            std::uniform_int_distribution<i32> distribution(-48, 48);
+            settlement.Candidates.resize(SampleCount);
+            for (Coordinate& coord : settlement.Candidates)
+            {
+                coord = Coordinate(distribution(generator), distribution(generator));
+            }
+
+            warehouse.Add(ResourceType::Lumber, 100);
+            warehouse.Add(ResourceType::Stone, 100);
+            settlement.FullWarehouse = warehouse.SaveState();
+
+            // mines need a finished town hall, so it is built out before any of them are placed
+            for (const Coordinate& coord : settlement.Candidates)
+            {
+                warehouse.RestoreState(settlement.FullWarehouse);
+
+                BuildingType type = buildings.GetBuildingCount(BuildingType::Townhall) == 0 ? BuildingType::Townhall : BuildingType::Mine;
+                if (buildings.CheckPlacement(type, coord, map) != PlacementResult::Valid)
+                    continue;
+
+                if (type == BuildingType::Townhall)
+                {
+                    buildings.PlaceBuilding(type, coord, map);
+                    FinishConstruction(type);
+                }
+                else if (buildings.GetAllBuildings().size() < 256)
+                    buildings.PlaceBuilding(type, coord, map);
+                else
+                    settlement.FreeSites.push_back(coord);
+            }
+
+            // only finished buildings are listed by type
+            FinishConstruction(BuildingType::Mine);
+
+            warehouse.RestoreState(settlement.FullWarehouse);
+            return true;
+        }();
+
+        (void)built;
+        return settlement;
+    }
+
+    void BM_WarehouseAddConsume(Benchmark::State& state)
+    {
+        Warehouse& warehouse = Warehouse::Get();
+        Warehouse::State saved = warehouse.SaveState();
+
+        for (auto _ : state)
+        {
+            Benchmark::DoNotOptimize(warehouse.Add(ResourceType::Lumber, 1));
+            Benchmark::DoNotOptimize(warehouse.Consume(ResourceType::Lumber, 1));
+        }
+        state.SetItemsProcessed(state.Iterations() * 2);
+
+        warehouse.RestoreState(saved);
+    }
+    RF_BENCHMARK(BM_WarehouseAddConsume);
+
+    void BM_WarehouseAddConsumeVector(Benchmark::State& state)
+    {
+        Warehouse& warehouse = Warehouse::Get();
+        Warehouse::State saved = warehouse.SaveState();
+        const ResourceVector& cost = GetBuildingDefinition(BuildingType::Mine).ConstructionCost;
+
+        for (auto _ : state)
+        {
+            Benchmark::DoNotOptimize(warehouse.Add(cost));
+            Benchmark::DoNotOptimize(warehouse.Consume(cost));
+        }
+        state.SetItemsProcessed(state.Iterations() * 2);
+
+        warehouse.RestoreState(saved);
+    }
+    RF_BENCHMARK(BM_WarehouseAddConsumeVector);
+
+    // Record sits on every warehouse change, so it has to stay cheap enough to leave on
+    void BM_ResourceTelemetryRecord(Benchmark::State& state)
+    {
+        ResourceTelemetry& telemetry = ResourceTelemetry::Get();
+        ResourceTelemetry::State saved = telemetry.SaveState();
+
+        for (auto _ : state)
+        {
+            telemetry.Record(BuildingType::Mine, ResourceFlow::Produced, ResourceType::Stone, 1);
+        }
+        state.SetItemsProcessed(state.Iterations());
+
+        telemetry.RestoreState(saved);
+    }
+    RF_BENCHMARK(BM_ResourceTelemetryRecord);
+
+    void BM_BuildingCheckPlacement(Benchmark::State& state)
+    {
+        Settlement& settlement = GetSettlement();
+        Warehouse::Get().RestoreState(settlement.FullWarehouse);
+
+        usize i = 0;
+        for (auto _ : state)
+        {
+            Benchmark::DoNotOptimize(BuildingManager::Get().CheckPlacement(BuildingType::Farm, settlement.Candidates[i++ % SampleCount], settlement.World));
+        }
+        state.SetItemsProcessed(state.Iterations());
+    }
+    RF_BENCHMARK(BM_BuildingCheckPlacement);
+
+    // the placement preview's path: one call for the whole hovered area
+    void BM_BuildingCheckPlacementBatch(Benchmark::State& state)
+    {
+        Settlement& settlement = GetSettlement();
+        Warehouse::Get().RestoreState(settlement.FullWarehouse);
+
+        usize batch = static_cast<usize>(state.Range());
+        std::vector<PlacementResult> results(batch);
+
+        usize offset = 0;
+        for (auto _ : state)
+        {
+            std::span<const Coordinate> coords(settlement.Candidates.data() + offset, batch);
+            BuildingManager::Get().CheckPlacement(BuildingType::Farm, coords, settlement.World, results);
+            Benchmark::DoNotOptimize(results.data());
+            offset = (offset + batch) % (SampleCount - batch);
+        }
+        state.SetItemsProcessed(state.Iterations() * batch);
+    }
+    RF_BENCHMARK(BM_BuildingCheckPlacementBatch, 64, 512);
+
+    // includes refilling the warehouse with the construction cost
+    void BM_BuildingPlaceRemove(Benchmark::State& state)
+    {
+        Settlement& settlement = GetSettlement();
+        BuildingManager& buildings = BuildingManager::Get();
+        Warehouse& warehouse = Warehouse::Get();
+        const ResourceVector& cost = GetBuildingDefinition(BuildingType::Mine).ConstructionCost;
+
+        // depends on the seed and on how many candidates the 256 placed mines used up
+        if (settlement.FreeSites.empty())
+        {
+            state.SkipWithError("no free mine site left in the settlement");
+            return;
+        }
+
+        warehouse.RestoreState(settlement.FullWarehouse);
+
+        usize i = 0;
+        for (auto _ : state)
+        {
+            const Coordinate& coord = settlement.FreeSites[i++ % settlement.FreeSites.size()];
+            warehouse.Add(cost);
+            Benchmark::DoNotOptimize(buildings.PlaceBuilding(BuildingType::Mine, coord, settlement.World));
+            buildings.RemoveBuilding(coord, settlement.World);
+        }
+        state.SetItemsProcessed(state.Iterations());
+
+        warehouse.RestoreState(settlement.FullWarehouse);
+    }
+    RF_BENCHMARK(BM_BuildingPlaceRemove);
+
+    void BM_BuildingGetAt(Benchmark::State& state)
+    {
+        Settlement& settlement = GetSettlement();
+
+        usize i = 0;
+        for (auto _ : state)
+        {
+            Benchmark::DoNotOptimize(BuildingManager::Get().GetBuildingAt(settlement.Candidates[i++ % SampleCount]));
+        }
+        state.SetItemsProcessed(state.Iterations());
+    }
+    RF_BENCHMARK(BM_BuildingGetAt);
+
+    void BM_BuildingGetInRadius(Benchmark::State& state)
+    {
+        Settlement& settlement = GetSettlement();
+        i32 radius = static_cast<i32>(state.Range());
+
+        std::vector<Building*> found;
+        usize i = 0;
+        u64 buildings = 0;
+        for (auto _ : state)
+        {
+            found.clear();
+            BuildingManager::Get().GetBuildingsInRadius(settlement.Candidates[i++ % SampleCount], radius, found);
+            buildings += found.size();
+            Benchmark::DoNotOptimize(found.data());
+        }
+        state.SetItemsProcessed(buildings);
+    }
+    RF_BENCHMARK(BM_BuildingGetInRadius, 3, 10);
+
+    void BM_BuildingGetByType(Benchmark::State& state)
+    {
+        GetSettlement();
+
+        usize i = 0;
+        for (auto _ : state)
+        {
+            if (i++ % 256 == 0)
+                FrameAllocator::Reset();
+
+            auto mines = BuildingManager::Get().GetBuildingsByType(BuildingType::Mine);
+            Benchmark::DoNotOptimize(mines.data());
+        }
+        state.SetItemsProcessed(state.Iterations());
+    }
+    RF_BENCHMARK(BM_BuildingGetByType);
+}
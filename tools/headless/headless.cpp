@@ -0,0 +1,463 @@
+/**
+ * @file headless.cpp
+ * @brief Runs the world and economy for a fixed number of ticks without a window or GL context.
+ * @date 12/22/2025
+ *
+ * Usage: realm-fortress-headless --ticks N [--seed S] [--tick-rate HZ] [--build-every N]
+ *                                [--radius R] [--json <file>]
+ *        realm-fortress-headless --parity N [--seed S]
+ *
+ * Generates the map around the origin, founds a town hall near it, and then steps the
+ * simulation as fast as it will go. Every --build-every ticks it tries to put down the next
+ * lumber mill, farm or mine, nearest the town hall first, waiting while it can't afford one or
+ * the town hall is still being built; 0 keeps the town hall alone. The same seed and options
+ * always simulate the same settlement, so runs can be diffed for balance changes or timed
+ * against each other.
+ *
+ * --parity fast-forwards N bare producers with 0, 1, 3 and 7 JobSystem workers, once with
+ * room for everything and once with the warehouse filling up, and fails unless every parallel
+ * run ends with exactly the cycles, stock and progress of the serial one.
+ */
+
+#include "core/pch.h"
+#include "core/frame_allocator.h"
+#include "core/job_system.h"
+#include "core/logger.h"
+#include "core/statistics.h"
+#include "game/building/building_manager.h"
+#include "game/building/production_system.h"
+#include "game/building/townhall.h"
+#include "game/map/map.h"
+#include "game/resource/warehouse.h"
+#include "game/system/economy.h"
+#include "game/system/resource_telemetry.h"
+#include "game/system/scheduler.h"
+#include "game/system/simulation_clock.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+
+using namespace RealmFortress;
+
+namespace
+{
+    struct Options
+    {
+        u64 Ticks{ 0 };
+        u32 Seed{ 1337 };
+        f32 TickRate{ SimulationClock::DefaultTickRate };
+        u32 BuildEvery{ 100 };
+        i32 Radius{ 12 };
+        std::string JsonPath;
+        u32 ParityProducers{ 0 };
+    };
+
+    struct TickTimes
+    {
+        f64 Mean = 0.0;
+        f64 P50 = 0.0;
+        f64 P99 = 0.0;
+        f64 Max = 0.0;
+    };
+
+    constexpr BuildingType BuildOrder[] = { BuildingType::LumberMill, BuildingType::Farm, BuildingType::Mine };
+
+    struct ParityProducer
+    {
+        BuildingType Type;
+        ResourceType Output;
+        i32 Amount;
+    };
+
+    constexpr ParityProducer ParityProducers[] = {
+        { BuildingType::LumberMill, ResourceType::Lumber, 1 },
+        { BuildingType::Farm, ResourceType::Wheat, 2 },
+        { BuildingType::Mine, ResourceType::Stone, 1 }
+    };
+
+    constexpr u32 ParityWorkerCounts[] = { 0, 1, 3, 7 };
+    constexpr u32 ParitySteps = 8;
+    constexpr f64 ParityStepSeconds = 30.0;
+
+    // what a parity run ends with; a parallel sweep has to reproduce the serial one bit for bit
+    struct ParityOutcome
+    {
+        u64 Cycles{ 0 };
+        std::array<i32, static_cast<usize>(ResourceType::Count)> Amounts{};
+        std::vector<f32> Progress;
+    };
+
+    // every coordinate within radius of center, nearest first, ties broken by position so the order is stable
+    std::vector<Coordinate> SitesAround(const Coordinate& center, i32 radius)
+    {
+        std::vector<Coordinate> sites;
+        for (i32 q = -radius; q <= radius; q++)
+        {
+            for (i32 r = std::max(-radius, -q - radius); r <= std::min(radius, -q + radius); r++)
+            {
+                sites.push_back(center + Coordinate(q, r));
+            }
+        }
+
+        std::ranges::sort(sites, [&](const Coordinate& a, const Coordinate& b)
+        {
+            i32 distance_a = center.DistanceTo(a);
+            i32 distance_b = center.DistanceTo(b);
+            if (distance_a != distance_b)
+                return distance_a < distance_b;
+            return a.Q != b.Q ? a.Q < b.Q : a.R < b.R;
+        });
+        return sites;
+    }
+
+    // nearest valid site for type; CannotAfford is global, so it shows up on the first site already
+    PlacementResult PlaceNearest(BuildingType type, std::span<const Coordinate> sites, const Map& map, Coordinate* out_site = nullptr)
+    {
+        BuildingManager& buildings = BuildingManager::Get();
+
+        PlacementResult last = PlacementResult::NoTile;
+        for (const Coordinate& site : sites)
+        {
+            last = buildings.CheckPlacement(type, site, map);
+            if (last == PlacementResult::Valid)
+            {
+                if (!buildings.PlaceBuilding(type, site, map))
+                    return PlacementResult::CannotAfford;
+                if (out_site)
+                    *out_site = site;
+                return PlacementResult::Valid;
+            }
+            if (last == PlacementResult::CannotAfford || last == PlacementResult::AlreadyBuilt || last == PlacementResult::NeedsTownhall)
+                return last;
+        }
+        return last;
+    }
+
+    TickTimes Summarize(std::vector<f32> values)
+    {
+        if (values.empty())
+            return {};
+
+        std::ranges::sort(values);
+
+        f64 sum = 0.0;
+        for (f32 value : values)
+            sum += value;
+
+        return { sum / static_cast<f64>(values.size()), SortedPercentile(values, 0.50), SortedPercentile(values, 0.99), values.back() };
+    }
+
+    // producers with cycle times and efficiencies spread from the seed, fast-forwarded in steps
+    // with some efficiencies changed in between, as dependency updates do between segments
+    ParityOutcome RunParity(u32 producers, u32 seed, bool roomy, const Warehouse::State& start)
+    {
+        Scheduler& scheduler = Scheduler::Get();
+        ProductionSystem& production = ProductionSystem::Get();
+        Warehouse& warehouse = Warehouse::Get();
+
+        production.Clear();
+        scheduler.Clear();
+        ResourceTelemetry::Get().Clear();
+        warehouse.RestoreState(start);
+        // otherwise the warehouse fills up and the ordered replay decides which outputs are kept
+        if (roomy)
+            warehouse.IncreaseCapacity(1'000'000'000);
+
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<f32> cycle_times(4.0f, 20.0f);
+        std::uniform_real_distribution<f32> efficiencies(0.25f, 1.5f);
+
+        production.Suspend();
+        std::vector<ProductionHandle> handles(producers);
+        for (u32 i = 0; i < producers; i++)
+        {
+            const ParityProducer& producer = ParityProducers[i % std::size(ParityProducers)];
+            handles[i] = production.Register(producer.Type, producer.Output, producer.Amount, cycle_times(generator));
+            production.SetEfficiency(handles[i], efficiencies(generator));
+        }
+
+        ParityOutcome outcome;
+        for (u32 step = 1; step <= ParitySteps; step++)
+        {
+            f64 time = step * ParityStepSeconds;
+            outcome.Cycles += production.AdvanceTo(time);
+            scheduler.AdvanceTo(time);
+
+            for (u32 i = step; i < producers; i += 7)
+                production.SetEfficiency(handles[i], efficiencies(generator));
+        }
+
+        for (usize i = 0; i < outcome.Amounts.size(); i++)
+            outcome.Amounts[i] = warehouse.GetAmount(static_cast<ResourceType>(i));
+
+        outcome.Progress.reserve(producers);
+        for (ProductionHandle handle : handles)
+            outcome.Progress.push_back(production.GetProgress(handle));
+
+        production.Clear();
+        return outcome;
+    }
+
+    bool CheckParity(u32 producers, u32 seed)
+    {
+        Warehouse::State start = Warehouse::Get().SaveState();
+        bool matches = true;
+
+        for (bool roomy : { true, false })
+        {
+            ParityOutcome serial;
+            for (u32 workers : ParityWorkerCounts)
+            {
+                // no workers runs every chunk inline on this thread, the serial reference
+                JobSystem::Shutdown();
+                if (workers > 0)
+                    JobSystem::Init(workers);
+
+                auto start_time = std::chrono::steady_clock::now();
+                ParityOutcome outcome = RunParity(producers, seed, roomy, start);
+                f64 milliseconds = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+
+                std::printf("%-6s %u workers: %llu cycles, %d lumber, %d stone, %d wheat in %.1f ms", roomy ? "roomy" : "full", workers,
+                            static_cast<unsigned long long>(outcome.Cycles), outcome.Amounts[static_cast<usize>(ResourceType::Lumber)],
+                            outcome.Amounts[static_cast<usize>(ResourceType::Stone)], outcome.Amounts[static_cast<usize>(ResourceType::Wheat)], milliseconds);
+
+                if (workers == 0)
+                {
+                    std::printf("\n");
+                    serial = std::move(outcome);
+                    continue;
+                }
+
+                usize progress_mismatches = 0;
+                for (usize i = 0; i < outcome.Progress.size(); i++)
+                {
+                    if (outcome.Progress[i] != serial.Progress[i])
+                        progress_mismatches++;
+                }
+
+                bool run_matches = outcome.Cycles == serial.Cycles && outcome.Amounts == serial.Amounts && progress_mismatches == 0;
+                if (run_matches)
+                    std::printf(", matches\n");
+                else
+                    std::printf(", MISMATCH (%zu producers differ in progress)\n", progress_mismatches);
+
+                matches = matches && run_matches;
+            }
+        }
+
+        Warehouse::Get().RestoreState(start);
+        Scheduler::Get().Clear();
+        ResourceTelemetry::Get().Clear();
+
+        JobSystem::Shutdown();
+        JobSystem::Init();
+        return matches;
+    }
+
+    bool WriteJson(const std::string& path, const Options& options, f64 wall_seconds, const TickTimes& tick_times,
+                   const ResourceTelemetry::RateTable& rates, bool starving)
+    {
+        std::ofstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+
+        const Scheduler& scheduler = Scheduler::Get();
+        const Warehouse& warehouse = Warehouse::Get();
+
+        std::string json = std::format("{{\n  \"seed\": {},\n  \"ticks\": {},\n  \"tick_rate\": {:.2f},\n  \"build_every\": {},\n"
+                                       "  \"simulated_seconds\": {:.3f},\n  \"wall_seconds\": {:.6f},\n  \"ticks_per_second\": {:.1f},\n"
+                                       "  \"tick_us\": {{ \"mean\": {:.3f}, \"p50\": {:.3f}, \"p99\": {:.3f}, \"max\": {:.3f} }},\n"
+                                       "  \"timers_fired\": {},\n  \"starving\": {},\n  \"buildings\": {{",
+                                       options.Seed, options.Ticks, options.TickRate, options.BuildEvery,
+                                       scheduler.GetTime(), wall_seconds, static_cast<f64>(options.Ticks) / wall_seconds,
+                                       tick_times.Mean, tick_times.P50, tick_times.P99, tick_times.Max,
+                                       scheduler.GetFiredCount(), starving);
+
+        for (usize i = 0; i < static_cast<usize>(BuildingType::Count); i++)
+        {
+            auto type = static_cast<BuildingType>(i);
+            json += std::format("{}\n    \"{}\": {}", i == 0 ? "" : ",", GetBuildingDefinition(type).Name, BuildingManager::Get().GetBuildingCount(type));
+        }
+
+        json += std::format("\n  }},\n  \"warehouse\": {{\n    \"used\": {},\n    \"capacity\": {}", warehouse.GetUsedSpace(), warehouse.GetCapacity());
+        for (usize i = 0; i < static_cast<usize>(ResourceType::Count); i++)
+        {
+            auto resource = static_cast<ResourceType>(i);
+            json += std::format(",\n    \"{}\": {{ \"amount\": {}, \"produced_per_second\": {:.3f}, \"consumed_per_second\": {:.3f}, \"lost_per_second\": {:.3f} }}",
+                                ResourceTypeToString(resource), warehouse.GetAmount(resource),
+                                ResourceTelemetry::GetTotalRate(rates, ResourceFlow::Produced, resource),
+                                ResourceTelemetry::GetTotalRate(rates, ResourceFlow::Consumed, resource),
+                                ResourceTelemetry::GetTotalRate(rates, ResourceFlow::Lost, resource));
+        }
+        json += "\n  }\n}\n";
+
+        file.write(json.data(), static_cast<std::streamsize>(json.size()));
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    for (i32 i = 1; i < argc; i++)
+    {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--ticks") == 0 && has_value)
+            options.Ticks = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--seed") == 0 && has_value)
+            options.Seed = static_cast<u32>(std::strtoul(argv[++i], nullptr, 10));
+        else if (std::strcmp(argv[i], "--tick-rate") == 0 && has_value)
+            options.TickRate = std::max(static_cast<f32>(std::atof(argv[++i])), 1.0f);
+        else if (std::strcmp(argv[i], "--build-every") == 0 && has_value)
+            options.BuildEvery = static_cast<u32>(std::max(std::atoi(argv[++i]), 0));
+        else if (std::strcmp(argv[i], "--radius") == 0 && has_value)
+            options.Radius = std::max(std::atoi(argv[++i]), 1);
+        else if (std::strcmp(argv[i], "--json") == 0 && has_value)
+            options.JsonPath = argv[++i];
+        else if (std::strcmp(argv[i], "--parity") == 0 && has_value)
+            options.ParityProducers = static_cast<u32>(std::strtoul(argv[++i], nullptr, 10));
+        else
+        {
+            options.Ticks = 0;
+            options.ParityProducers = 0;
+            break;
+        }
+    }
+
+    if (options.Ticks == 0 && options.ParityProducers == 0)
+    {
+        std::fprintf(stderr, "usage: %s --ticks N [--seed S] [--tick-rate HZ] [--build-every N] [--radius R] [--json <file>]\n"
+                             "       %s --parity N [--seed S]\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    Logger::Init();
+    JobSystem::Init();
+    FrameAllocator::Init();
+
+    if (options.ParityProducers > 0)
+    {
+        std::printf("Fast-forwarding %u producers over %.0f s in %u steps, seed %u\n", options.ParityProducers,
+                    ParitySteps * ParityStepSeconds, ParitySteps, options.Seed);
+        bool matches = CheckParity(options.ParityProducers, options.Seed);
+        std::printf("%s\n", matches ? "Parallel sweeps match the serial one" : "Parallel sweeps DIFFER from the serial one");
+
+        JobSystem::Shutdown();
+        FrameAllocator::Shutdown();
+        Logger::Shutdown();
+        return matches ? 0 : 1;
+    }
+
+    // everything in streaming distance of the origin, as the game has it before the first frame is drawn
+    Map map;
+    map.Regenerate(options.Seed);
+    do
+    {
+        FrameAllocator::Reset();
+        map.OnUpdate(glm::vec3(0.0f));
+    }
+    while (map.GetPendingChunkCount() > 0);
+
+    // the same starting stock GameLayer hands out
+    Warehouse& warehouse = Warehouse::Get();
+    warehouse.Add({
+        { ResourceType::Lumber, 70 },
+        { ResourceType::Stone, 70 },
+        { ResourceType::Wheat, 50 }
+    });
+
+    i32 exit_code = 0;
+    Coordinate townhall_site;
+    if (PlaceNearest(BuildingType::Townhall, SitesAround(Coordinate(0, 0), options.Radius), map, &townhall_site) != PlacementResult::Valid)
+    {
+        std::fprintf(stderr, "No site for a town hall within %d tiles of the origin with seed %u\n", options.Radius, options.Seed);
+        exit_code = 1;
+    }
+
+    if (exit_code == 0)
+    {
+        // still under construction, so it isn't listed by type yet
+        const Building* townhall = BuildingManager::Get().GetBuildingAt(townhall_site);
+        std::vector<Coordinate> sites = SitesAround(townhall_site, options.Radius);
+
+        SimulationClock clock(options.TickRate);
+        Timestep tick_delta = clock.GetTickDelta();
+        std::vector<f32> tick_times;
+        tick_times.reserve(options.Ticks);
+
+        std::printf("Simulating %llu ticks at %.0f Hz, seed %u, %zu tiles loaded\n",
+                    static_cast<unsigned long long>(options.Ticks), options.TickRate, options.Seed, map.GetTileCount());
+
+        usize next_build = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (u64 tick = 0; tick < options.Ticks; tick++)
+        {
+            FrameAllocator::Reset();
+
+            if (options.BuildEvery > 0 && tick % options.BuildEvery == 0)
+            {
+                BuildingType type = BuildOrder[next_build % std::size(BuildOrder)];
+                // wait for the resources and the town hall rather than skipping ahead to something cheaper
+                PlacementResult placed = PlaceNearest(type, sites, map);
+                if (placed != PlacementResult::CannotAfford && placed != PlacementResult::NeedsTownhall)
+                    next_build++;
+            }
+
+            auto tick_start = std::chrono::steady_clock::now();
+            Economy::Tick(tick_delta, map);
+            tick_times.push_back(std::chrono::duration<f32, std::micro>(std::chrono::steady_clock::now() - tick_start).count());
+        }
+        f64 wall_seconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - start).count();
+
+        TickTimes summary = Summarize(std::move(tick_times));
+        ResourceTelemetry::RateTable rates;
+        ResourceTelemetry::Get().ComputeRates(60.0, rates);
+        const auto* hall = static_cast<const Townhall*>(townhall);
+        bool starving = hall->IsStarving();
+
+        std::printf("\nSimulated %.1f s in %.3f s (%.0f ticks/s, %.0fx real time)\n", Scheduler::Get().GetTime(), wall_seconds,
+                    static_cast<f64>(options.Ticks) / wall_seconds, Scheduler::Get().GetTime() / wall_seconds);
+        std::printf("Tick cost: mean %.2f us, p50 %.2f us, p99 %.2f us, max %.2f us\n", summary.Mean, summary.P50, summary.P99, summary.Max);
+        std::printf("Timers fired: %zu, town hall %s\n\n", Scheduler::Get().GetFiredCount(), starving ? "starving" : "fed");
+
+        for (usize i = 0; i < static_cast<usize>(BuildingType::Count); i++)
+        {
+            auto type = static_cast<BuildingType>(i);
+            std::printf("%-12s %4d\n", GetBuildingDefinition(type).Name, BuildingManager::Get().GetBuildingCount(type));
+        }
+
+        std::printf("\n%-8s %8s %12s %12s %12s\n", "Resource", "Amount", "Produced/s", "Consumed/s", "Lost/s");
+        for (usize i = 0; i < static_cast<usize>(ResourceType::Count); i++)
+        {
+            auto resource = static_cast<ResourceType>(i);
+            std::printf("%-8s %8d %12.2f %12.2f %12.2f\n", ResourceTypeToString(resource), warehouse.GetAmount(resource),
+                        ResourceTelemetry::GetTotalRate(rates, ResourceFlow::Produced, resource),
+                        ResourceTelemetry::GetTotalRate(rates, ResourceFlow::Consumed, resource),
+                        ResourceTelemetry::GetTotalRate(rates, ResourceFlow::Lost, resource));
+        }
+        std::printf("Warehouse %d / %d\n", warehouse.GetUsedSpace(), warehouse.GetCapacity());
+
+        if (!options.JsonPath.empty())
+        {
+            if (WriteJson(options.JsonPath, options, wall_seconds, summary, rates, starving))
+            {
+                std::printf("Results written to %s\n", options.JsonPath.c_str());
+            }
+            else
+            {
+                std::fprintf(stderr, "Could not write %s\n", options.JsonPath.c_str());
+                exit_code = 1;
+            }
+        }
+    }
+
+    BuildingManager::Get().Clear();
+    Scheduler::Get().Clear();
+    ResourceTelemetry::Get().Clear();
+
+    JobSystem::Shutdown();
+    FrameAllocator::Shutdown();
+    Logger::Shutdown();
+    return exit_code;
+}
@@ -0,0 +1,387 @@
+/**
+ * @file texture_baker.cpp
+ * @brief Bakes images into block-compressed mip chains (.ktx2) for the runtime to upload as-is.
+ * @date 12/22/2025
+ *
+ * Usage: realm-fortress-texture-baker <file-or-dir>... [--force]
+ *
+ * Every .png/.jpg/.tga found is written to a .ktx2 with the same name next to it. Opaque
+ * images are encoded as BC1, images with alpha as BC3. Up-to-date outputs are skipped
+ * unless --force is given.
+ */
+
+#include "renderer/texture_format.h"
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace RealmFortress;
+
+namespace
+{
+    struct Image
+    {
+        u32 Width = 0;
+        u32 Height = 0;
+        std::vector<u8> Pixels; // RGBA8
+    };
+
+    Image Downsample(const Image& source)
+    {
+        Image result;
+        result.Width = std::max(1u, source.Width / 2);
+        result.Height = std::max(1u, source.Height / 2);
+        result.Pixels.resize(static_cast<usize>(result.Width) * result.Height * 4);
+
+        // 2x2 box filter, clamping at the edge for odd sizes
+        for (u32 y = 0; y < result.Height; y++)
+        {
+            for (u32 x = 0; x < result.Width; x++)
+            {
+                u32 x0 = std::min(x * 2, source.Width - 1), x1 = std::min(x * 2 + 1, source.Width - 1);
+                u32 y0 = std::min(y * 2, source.Height - 1), y1 = std::min(y * 2 + 1, source.Height - 1);
+
+                for (u32 c = 0; c < 4; c++)
+                {
+                    u32 sum = source.Pixels[(static_cast<usize>(y0) * source.Width + x0) * 4 + c]
+                            + source.Pixels[(static_cast<usize>(y0) * source.Width + x1) * 4 + c]
+                            + source.Pixels[(static_cast<usize>(y1) * source.Width + x0) * 4 + c]
+                            + source.Pixels[(static_cast<usize>(y1) * source.Width + x1) * 4 + c];
+                    result.Pixels[(static_cast<usize>(y) * result.Width + x) * 4 + c] = static_cast<u8>((sum + 2) / 4);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    u16 PackRGB565(const f32 color[3])
+    {
+        u32 r = static_cast<u32>(std::clamp(color[0], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+        u32 g = static_cast<u32>(std::clamp(color[1], 0.0f, 255.0f) * 63.0f / 255.0f + 0.5f);
+        u32 b = static_cast<u32>(std::clamp(color[2], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+        return static_cast<u16>((r << 11) | (g << 5) | b);
+    }
+
+    void UnpackRGB565(u16 packed, i32 color[3])
+    {
+        i32 r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+        color[0] = (r << 3) | (r >> 2);
+        color[1] = (g << 2) | (g >> 4);
+        color[2] = (b << 3) | (b >> 2);
+    }
+
+    /**
+     * Fits the endpoints along the principal axis of the block's colours, insets them slightly
+     * and picks the closest of the four palette entries for every texel. Always uses the
+     * four-colour mode so the block is also valid as the colour half of BC3.
+     */
+    void EncodeColorBlock(const u8 block[16][4], u8* out)
+    {
+        f32 mean[3] = {};
+        for (u32 i = 0; i < 16; i++)
+            for (u32 c = 0; c < 3; c++)
+                mean[c] += block[i][c] / 16.0f;
+
+        f32 covariance[6] = {};
+        for (u32 i = 0; i < 16; i++)
+        {
+            f32 r = block[i][0] - mean[0], g = block[i][1] - mean[1], b = block[i][2] - mean[2];
+            covariance[0] += r * r; covariance[1] += r * g; covariance[2] += r * b;
+            covariance[3] += g * g; covariance[4] += g * b; covariance[5] += b * b;
+        }
+
+        f32 axis[3] = { 1.0f, 1.0f, 1.0f };
+        for (u32 iteration = 0; iteration < 8; iteration++)
+        {
+            f32 next[3] = {
+                covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+                covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+                covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2]
+            };
+            f32 length = std::max({ std::abs(next[0]), std::abs(next[1]), std::abs(next[2]) });
+            if (length < 1e-6f)
+                break;
+            for (u32 c = 0; c < 3; c++)
+                axis[c] = next[c] / length;
+        }
+
+        f32 min_t = 1e9f, max_t = -1e9f;
+        for (u32 i = 0; i < 16; i++)
+        {
+            f32 t = (block[i][0] - mean[0]) * axis[0] + (block[i][1] - mean[1]) * axis[1] + (block[i][2] - mean[2]) * axis[2];
+            min_t = std::min(min_t, t);
+            max_t = std::max(max_t, t);
+        }
+
+        f32 axis_length_sq = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+        f32 inset = (max_t - min_t) / 16.0f;
+        f32 high[3], low[3];
+        for (u32 c = 0; c < 3; c++)
+        {
+            high[c] = mean[c] + axis[c] * (max_t - inset) / axis_length_sq;
+            low[c] = mean[c] + axis[c] * (min_t + inset) / axis_length_sq;
+        }
+
+        u16 color0 = PackRGB565(high);
+        u16 color1 = PackRGB565(low);
+        if (color0 < color1)
+            std::swap(color0, color1);
+
+        u32 indices = 0;
+        if (color0 != color1)
+        {
+            i32 palette[4][3];
+            UnpackRGB565(color0, palette[0]);
+            UnpackRGB565(color1, palette[1]);
+            for (u32 c = 0; c < 3; c++)
+            {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+            }
+
+            for (u32 i = 0; i < 16; i++)
+            {
+                u32 best = 0;
+                i32 best_distance = INT32_MAX;
+                for (u32 p = 0; p < 4; p++)
+                {
+                    i32 dr = block[i][0] - palette[p][0], dg = block[i][1] - palette[p][1], db = block[i][2] - palette[p][2];
+                    i32 distance = dr * dr + dg * dg + db * db;
+                    if (distance < best_distance)
+                    {
+                        best_distance = distance;
+                        best = p;
+                    }
+                }
+                indices |= best << (i * 2);
+            }
+        }
+
+        std::memcpy(out + 0, &color0, 2);
+        std::memcpy(out + 2, &color1, 2);
+        std::memcpy(out + 4, &indices, 4);
+    }
+
+    void EncodeAlphaBlock(const u8 block[16][4], u8* out)
+    {
+        u8 alpha0 = 0, alpha1 = 255;
+        for (u32 i = 0; i < 16; i++)
+        {
+            alpha0 = std::max(alpha0, block[i][3]);
+            alpha1 = std::min(alpha1, block[i][3]);
+        }
+
+        out[0] = alpha0;
+        out[1] = alpha1;
+
+        u64 indices = 0;
+        if (alpha0 != alpha1)
+        {
+            // eight-value mode: entries 2..7 interpolate from alpha0 towards alpha1
+            i32 palette[8] = { alpha0, alpha1 };
+            for (i32 p = 1; p < 7; p++)
+                palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+
+            for (u32 i = 0; i < 16; i++)
+            {
+                u64 best = 0;
+                i32 best_distance = INT32_MAX;
+                for (u32 p = 0; p < 8; p++)
+                {
+                    i32 distance = std::abs(block[i][3] - palette[p]);
+                    if (distance < best_distance)
+                    {
+                        best_distance = distance;
+                        best = p;
+                    }
+                }
+                indices |= best << (i * 3);
+            }
+        }
+
+        for (u32 i = 0; i < 6; i++)
+            out[2 + i] = static_cast<u8>(indices >> (i * 8));
+    }
+
+    std::vector<u8> EncodeImage(const Image& image, u32 vk_format)
+    {
+        u32 blocks_x = (image.Width + 3) / 4;
+        u32 blocks_y = (image.Height + 3) / 4;
+        u32 block_bytes = BlockCompressedBytesPerBlock(vk_format);
+
+        std::vector<u8> result(static_cast<usize>(blocks_x) * blocks_y * block_bytes);
+        for (u32 by = 0; by < blocks_y; by++)
+        {
+            for (u32 bx = 0; bx < blocks_x; bx++)
+            {
+                // edge blocks repeat the last row/column so padding does not skew the endpoints
+                u8 block[16][4];
+                for (u32 i = 0; i < 16; i++)
+                {
+                    u32 x = std::min(bx * 4 + i % 4, image.Width - 1);
+                    u32 y = std::min(by * 4 + i / 4, image.Height - 1);
+                    std::memcpy(block[i], &image.Pixels[(static_cast<usize>(y) * image.Width + x) * 4], 4);
+                }
+
+                u8* out = &result[(static_cast<usize>(by) * blocks_x + bx) * block_bytes];
+                if (vk_format == VK_FORMAT_BC3_UNORM_BLOCK)
+                {
+                    EncodeAlphaBlock(block, out);
+                    EncodeColorBlock(block, out + 8);
+                }
+                else
+                {
+                    EncodeColorBlock(block, out);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    u64 AlignUp(u64 value, u64 alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    bool Bake(const std::filesystem::path& input, const std::filesystem::path& output)
+    {
+        i32 width, height, channels;
+        stbi_uc* pixels = stbi_load(input.string().c_str(), &width, &height, &channels, 4);
+        if (!pixels)
+        {
+            std::fprintf(stderr, "failed to load %s: %s\n", input.string().c_str(), stbi_failure_reason());
+            return false;
+        }
+
+        Image image;
+        image.Width = static_cast<u32>(width);
+        image.Height = static_cast<u32>(height);
+        image.Pixels.assign(pixels, pixels + static_cast<usize>(width) * height * 4);
+        stbi_image_free(pixels);
+
+        bool has_alpha = false;
+        for (usize i = 3; i < image.Pixels.size(); i += 4)
+        {
+            if (image.Pixels[i] != 255)
+            {
+                has_alpha = true;
+                break;
+            }
+        }
+        u32 vk_format = has_alpha ? VK_FORMAT_BC3_UNORM_BLOCK : VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+
+        std::vector<std::vector<u8>> levels;
+        levels.push_back(EncodeImage(image, vk_format));
+        while (image.Width > 1 || image.Height > 1)
+        {
+            image = Downsample(image);
+            levels.push_back(EncodeImage(image, vk_format));
+        }
+
+        KTX2Header header;
+        std::memcpy(header.Identifier, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER));
+        header.VkFormat = vk_format;
+        header.PixelWidth = static_cast<u32>(width);
+        header.PixelHeight = static_cast<u32>(height);
+        header.LevelCount = static_cast<u32>(levels.size());
+
+        // level data goes smallest first, as in KTX2
+        std::vector<KTX2LevelIndex> index(levels.size());
+        u64 offset = AlignUp(sizeof(KTX2Header) + sizeof(KTX2LevelIndex) * levels.size(), KTX2_LEVEL_ALIGNMENT);
+        for (usize level = levels.size(); level-- > 0;)
+        {
+            index[level].ByteOffset = offset;
+            index[level].ByteLength = levels[level].size();
+            index[level].UncompressedByteLength = levels[level].size();
+            offset = AlignUp(offset + levels[level].size(), KTX2_LEVEL_ALIGNMENT);
+        }
+
+        std::ofstream out(output, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            std::fprintf(stderr, "failed to open %s\n", output.string().c_str());
+            return false;
+        }
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(sizeof(KTX2LevelIndex) * index.size()));
+        for (usize level = levels.size(); level-- > 0;)
+        {
+            std::vector<char> padding(index[level].ByteOffset - static_cast<u64>(out.tellp()), 0);
+            out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+            out.write(reinterpret_cast<const char*>(levels[level].data()), static_cast<std::streamsize>(levels[level].size()));
+        }
+
+        std::printf("baked %s (%dx%d, %zu mips, %s)\n", output.string().c_str(), width, height, levels.size(), has_alpha ? "BC3" : "BC1");
+        return true;
+    }
+
+    bool IsSourceImage(const std::filesystem::path& path)
+    {
+        std::string extension = path.extension().string();
+        std::ranges::transform(extension, extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: %s <file-or-dir>... [--force]\n", argv[0]);
+        return 1;
+    }
+
+    bool force = false;
+    std::vector<std::filesystem::path> inputs;
+    for (i32 i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--force") == 0)
+            force = true;
+        else
+            inputs.emplace_back(argv[i]);
+    }
+
+    std::vector<std::filesystem::path> images;
+    for (const auto& input : inputs)
+    {
+        if (std::filesystem::is_directory(input))
+        {
+            for (const auto& item : std::filesystem::recursive_directory_iterator(input))
+            {
+                if (item.is_regular_file() && IsSourceImage(item.path()))
+                    images.push_back(item.path());
+            }
+        }
+        else if (std::filesystem::is_regular_file(input))
+        {
+            images.push_back(input);
+        }
+    }
+
+    i32 failures = 0;
+    for (const auto& image : images)
+    {
+        std::filesystem::path output = std::filesystem::path(image).replace_extension(".ktx2");
+        if (!force && std::filesystem::exists(output) &&
+            std::filesystem::last_write_time(output) >= std::filesystem::last_write_time(image))
+        {
+            continue;
+        }
+
+        if (!Bake(image, output))
+            failures++;
+    }
+
+    return failures == 0 ? 0 : 1;
+}